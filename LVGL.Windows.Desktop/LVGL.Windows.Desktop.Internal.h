@@ -0,0 +1,235 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows Desktop
+ * FILE:      LVGL.Windows.Desktop.Internal.h
+ * PURPOSE:   Definition for the internal functions of the renderer and the
+ *            display driver, shared with the tests and the benchmarks
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_DESKTOP_INTERNAL
+#define LVGL_WINDOWS_DESKTOP_INTERNAL
+
+#include <Windows.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#if _MSC_VER >= 1200
+// Disable compilation warnings.
+#pragma warning(push)
+// nonstandard extension used : bit field types other than int
+#pragma warning(disable:4214)
+// 'conversion' conversion from 'type1' to 'type2', possible loss of data
+#pragma warning(disable:4244)
+// operator 'operator-name': deprecated between enumerations of different types
+#pragma warning(disable:5054)
+#endif
+
+#include "lvgl/lvgl.h"
+#include <lvgl/src/draw/sw/lv_draw_sw.h>
+
+#if _MSC_VER >= 1200
+// Restore compilation warnings.
+#pragma warning(pop)
+#endif
+
+// The x86 build checks for SSE2 at run time, it is always present on x64.
+#if defined(_M_IX86) || defined(_M_X64) || defined(__x86_64__)
+#define LVGL_WINDOWS_GDI_RENDERER_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define LVGL_WINDOWS_GDI_RENDERER_NEON
+#endif
+
+/**
+ * @brief The cost, in pixels, of a BitBlt call. Two flushed areas are
+ *        presented as their bounding box if it copies at most this count of
+ *        pixels more than the areas themselves. See the FlushAreas case of
+ *        LVGL.Windows.Desktop.Benchmarks.cpp.
+*/
+#ifndef LVGL_DISPLAY_FLUSH_BLIT_COST
+#define LVGL_DISPLAY_FLUSH_BLIT_COST 4096
+#endif
+
+/**
+ * @brief The statistics of the last frame presented to the window.
+*/
+typedef struct _LVGL_DISPLAY_FLUSH_STATISTICS
+{
+    /**
+     * @brief The count of the areas drawn by LVGL for the frame.
+    */
+    SIZE_T AreaCount;
+
+    /**
+     * @brief The count of the merged areas copied to the window.
+    */
+    SIZE_T BlitCount;
+
+    /**
+     * @brief The count of pixels copied to the window.
+    */
+    SIZE_T PresentedPixels;
+
+    /**
+     * @brief The count of pixels of the window.
+    */
+    SIZE_T WindowPixels;
+} LVGL_DISPLAY_FLUSH_STATISTICS, *PLVGL_DISPLAY_FLUSH_STATISTICS;
+
+/**
+ * @brief Collects the areas drawn by LVGL and presents them to the window
+ *        after the last one of the frame.
+*/
+void LvglDisplayDriverFlushCallback(
+    lv_disp_drv_t* disp_drv,
+    const lv_area_t* area,
+    lv_color_t* color_p);
+
+/**
+ * @brief Merges the flushed areas which are cheaper to present as their
+ *        bounding box than with separate BitBlt calls, until no two of them
+ *        are. Returns the count of the merged areas, which are moved to the
+ *        start of the array.
+*/
+std::size_t LvglDisplayDriverMergeFlushAreas(
+    lv_area_t* Areas,
+    std::size_t Count,
+    std::uint32_t BlitCost);
+
+/**
+ * @brief Retrieves the statistics of the last frame presented to the window.
+*/
+void LvglDisplayDriverGetFlushStatistics(
+    _Out_ PLVGL_DISPLAY_FLUSH_STATISTICS Statistics);
+
+/**
+ * @brief Fills a row of the draw buffer. There is no AVX2 kernel, 32-byte
+ *        stores were measured within 20% of the SSE2 kernel on the large
+ *        fills which are bound by the memory bandwidth, and slower on the
+ *        small ones. See LVGL.Windows.Desktop.Benchmarks.cpp.
+*/
+void LvglWindowsGdiRendererFillRow(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color);
+
+void LvglWindowsGdiRendererFillRowScalar(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color);
+
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+void LvglWindowsGdiRendererFillRowSse2(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color);
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+void LvglWindowsGdiRendererFillRowNeon(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color);
+#endif
+
+/**
+ * @brief The parameters of the blend kernels which are the same for all the
+ *        rows of a blend. The kernels give the same pixels as
+ *        lv_draw_sw_blend_basic of LVGL 8.3 for 32-bit colors.
+*/
+typedef struct _LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS
+{
+    /**
+     * @brief The color of the fills, which have no source image.
+    */
+    std::uint32_t Color;
+
+    /**
+     * @brief The opacity of the blend.
+    */
+    lv_opa_t Opacity;
+
+    /**
+     * @brief The mask values from which the opacity is used as is, instead of
+     *        being scaled by the mask value.
+    */
+    lv_opa_t CoverMask;
+
+    /**
+     * @brief The mask values are used as the opacity, the opacity of the blend
+     *        is ignored. LVGL does it for the nearly opaque normal blends.
+    */
+    bool MaskOnly;
+
+    /**
+     * @brief The blend mode, normal, additive, subtractive or multiply.
+    */
+    lv_blend_mode_t BlendMode;
+} LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS, *PLVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS;
+
+/**
+ * @brief Blends a row of the draw buffer with the fastest of the kernels
+ *        below available on the processor.
+*/
+void LvglWindowsGdiRendererBlendRow(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count);
+
+void LvglWindowsGdiRendererBlendRowScalar(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count);
+
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+void LvglWindowsGdiRendererBlendRowSse2(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count);
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+void LvglWindowsGdiRendererBlendRowNeon(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count);
+#endif
+
+/**
+ * @brief The blend callback of the renderer, which replaces the one of the
+ *        LVGL software renderer.
+*/
+void LvglWindowsGdiRendererBlendCallback(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc);
+
+void LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
+    lv_draw_ctx_t* draw_ctx);
+
+/**
+ * @brief Starts the renderer worker threads, if they are not started yet and
+ *        there is more than one logical processor.
+*/
+void LvglWindowsGdiRendererStartWorkers();
+
+/**
+ * @brief Starts a given count of renderer worker threads, if they are not
+ *        started yet. Zero draws everything on the thread which runs LVGL.
+*/
+void LvglWindowsGdiRendererStartWorkerThreads(
+    std::size_t WorkerCount);
+
+/**
+ * @brief Stops and joins the renderer worker threads. Called from the thread
+ *        which runs LVGL once it has stopped drawing.
+*/
+void LvglWindowsGdiRendererStopWorkers();
+
+#endif // !LVGL_WINDOWS_DESKTOP_INTERNAL
@@ -13,11 +13,14 @@
 
 #pragma comment(lib, "Imm32.lib")
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
-#include <map>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -42,6 +45,14 @@
 
 #include <LVGL.Windows.Font.h>
 
+#include "LVGL.Windows.Desktop.Internal.h"
+
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+#include <emmintrin.h>
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+#include <arm_neon.h>
+#endif
+
 /**
  * @brief Creates a B8G8R8A8 frame buffer.
  * @param WindowHandle A handle to the window for the creation of the frame
@@ -340,6 +351,78 @@ static uint16_t volatile g_Utf16HighSurrogate = 0;
 static uint16_t volatile g_Utf16LowSurrogate = 0;
 static lv_group_t* volatile g_DefaultGroup = nullptr;
 
+static std::vector<lv_area_t> g_FlushAreas;
+static SIZE_T g_FlushAreaCount = 0;
+static LVGL_DISPLAY_FLUSH_STATISTICS g_FlushStatistics;
+
+/**
+ * @brief Replaces an area with the bounding box of it and another area, if
+ *        the bounding box is cheaper to present than the two areas.
+*/
+static bool LvglJoinFlushAreas(
+    lv_area_t* Area,
+    const lv_area_t* Other,
+    std::uint32_t BlitCost)
+{
+    std::uint32_t Pixels =
+        ::lv_area_get_size(Area) + ::lv_area_get_size(Other);
+
+    lv_area_t Overlap;
+    if (::_lv_area_intersect(&Overlap, Area, Other))
+    {
+        Pixels -= ::lv_area_get_size(&Overlap);
+    }
+
+    lv_area_t BoundingBox;
+    ::_lv_area_join(&BoundingBox, Area, Other);
+    if (::lv_area_get_size(&BoundingBox) > Pixels + BlitCost)
+    {
+        return false;
+    }
+
+    *Area = BoundingBox;
+    return true;
+}
+
+std::size_t LvglDisplayDriverMergeFlushAreas(
+    lv_area_t* Areas,
+    std::size_t Count,
+    std::uint32_t BlitCost)
+{
+    // The areas before MergedCount can not be merged with each other. Each
+    // area is merged into them one by one, and compared with all of them
+    // again after each merge, because the bounding box may now be cheaper to
+    // merge with the ones it was compared with before. There are at most
+    // Count - 1 merges, so there are O(Count^2) comparisons.
+    std::size_t MergedCount = 0;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        lv_area_t Area = Areas[i];
+        for (std::size_t j = 0; j < MergedCount;)
+        {
+            if (::LvglJoinFlushAreas(&Area, &Areas[j], BlitCost))
+            {
+                Areas[j] = Areas[--MergedCount];
+                j = 0;
+            }
+            else
+            {
+                ++j;
+            }
+        }
+
+        Areas[MergedCount++] = Area;
+    }
+
+    return MergedCount;
+}
+
+void LvglDisplayDriverGetFlushStatistics(
+    _Out_ PLVGL_DISPLAY_FLUSH_STATISTICS Statistics)
+{
+    *Statistics = g_FlushStatistics;
+}
+
 void LvglDisplayDriverFlushCallback(
     lv_disp_drv_t* disp_drv,
     const lv_area_t* area,
@@ -347,121 +430,1092 @@ void LvglDisplayDriverFlushCallback(
 {
     UNREFERENCED_PARAMETER(color_p);
 
+    // LVGL draws the invalidated areas of a frame to the frame buffer one by
+    // one, so collect them and present them together after the last one. In
+    // the direct mode the flushed area is the whole frame buffer, the areas
+    // drawn are the invalidated areas which are not joined into others.
+    if (!disp_drv->direct_mode)
+    {
+        ++g_FlushAreaCount;
+
+        // LVGL draws an invalidated area taller than the draw buffer in
+        // strips, one below the other. Join them here, so only about one
+        // area for each invalidated area is merged below.
+        if (!g_FlushAreas.empty() &&
+            g_FlushAreas.back().x1 == area->x1 &&
+            g_FlushAreas.back().x2 == area->x2 &&
+            g_FlushAreas.back().y2 + 1 == area->y1)
+        {
+            g_FlushAreas.back().y2 = area->y2;
+        }
+        else
+        {
+            g_FlushAreas.push_back(*area);
+        }
+    }
+
     if (::lv_disp_flush_is_last(disp_drv))
     {
-        lv_coord_t Width = ::lv_area_get_width(area);
-        lv_coord_t Height = ::lv_area_get_height(area);
+        if (disp_drv->direct_mode)
+        {
+            // The invalidated areas are not part of the public API of LVGL,
+            // inv_areas, inv_area_joined and inv_p are the fields of LVGL
+            // 8.3, which lv_refr.c reads the same way. Check them again when
+            // moving to another version of LVGL.
+            lv_disp_t* Display = ::_lv_refr_get_disp_refreshing();
+            for (std::uint16_t i = 0; i < Display->inv_p; ++i)
+            {
+                if (!Display->inv_area_joined[i])
+                {
+                    g_FlushAreas.push_back(Display->inv_areas[i]);
+                }
+            }
 
-        ::BitBlt(
-            g_WindowDCHandle,
-            area->x1,
-            area->y1,
-            Width,
-            Height,
-            g_BufferDCHandle,
-            area->x1,
-            area->y1,
-            SRCCOPY);
+            g_FlushAreaCount = g_FlushAreas.size();
+        }
+
+        LVGL_DISPLAY_FLUSH_STATISTICS Statistics = { 0 };
+        Statistics.AreaCount = g_FlushAreaCount;
+        Statistics.WindowPixels =
+            static_cast<SIZE_T>(disp_drv->hor_res) * disp_drv->ver_res;
+
+        g_FlushAreas.resize(::LvglDisplayDriverMergeFlushAreas(
+            g_FlushAreas.data(),
+            g_FlushAreas.size(),
+            LVGL_DISPLAY_FLUSH_BLIT_COST));
+
+        for (const lv_area_t& Area : g_FlushAreas)
+        {
+            ::BitBlt(
+                g_WindowDCHandle,
+                Area.x1,
+                Area.y1,
+                ::lv_area_get_width(&Area),
+                ::lv_area_get_height(&Area),
+                g_BufferDCHandle,
+                Area.x1,
+                Area.y1,
+                SRCCOPY);
+
+            ++Statistics.BlitCount;
+            Statistics.PresentedPixels += ::lv_area_get_size(&Area);
+        }
+
+        // GDI batches the calls, send them to the window together.
+        ::GdiFlush();
+
+        g_FlushAreas.clear();
+        g_FlushAreaCount = 0;
+        g_FlushStatistics = Statistics;
     }
 
     ::lv_disp_flush_ready(disp_drv);
 }
 
-#include <lvgl/src/draw/sw/lv_draw_sw.h>
-
 typedef lv_draw_sw_ctx_t LvglWindowsGdiRendererContext;
 
-std::map<std::uint32_t, HBRUSH> g_SolidBrushCache;
+void LvglWindowsGdiRendererFillRowScalar(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color)
+{
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        Destination[i] = Color;
+    }
+}
+
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
 
-void LvglWindowsGdiRendererBlendCallback(
-    lv_draw_ctx_t* draw_ctx,
-    const lv_draw_sw_blend_dsc_t* dsc)
+void LvglWindowsGdiRendererFillRowSse2(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color)
 {
-    // Let's get the blend area which is the intersection of the area to fill
-    // and the clip area.
-    lv_area_t blend_area;
-    if (!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area))
+    // The rows are only 4-byte aligned, align the stores to 16 bytes first.
+    while (Count && (reinterpret_cast<std::uintptr_t>(Destination) & 15))
     {
-        return;
+        *Destination++ = Color;
+        --Count;
     }
 
-    // Fallback: The GPU doesn't support these settings. Call the Software
-    // Renderer.
-    if (!(
-        dsc->mask_buf == nullptr &&
-        dsc->opa >= LV_OPA_MAX &&
-        dsc->blend_mode == LV_BLEND_MODE_NORMAL))
+    const __m128i Value = ::_mm_set1_epi32(static_cast<int>(Color));
+
+    for (; Count >= 16; Count -= 16, Destination += 16)
     {
-        ::lv_draw_sw_blend_basic(draw_ctx, dsc);
-        return;
+        __m128i* Pointer = reinterpret_cast<__m128i*>(Destination);
+        ::_mm_store_si128(Pointer, Value);
+        ::_mm_store_si128(Pointer + 1, Value);
+        ::_mm_store_si128(Pointer + 2, Value);
+        ::_mm_store_si128(Pointer + 3, Value);
     }
 
-    if (dsc->src_buf)
+    for (; Count >= 4; Count -= 4, Destination += 4)
+    {
+        ::_mm_store_si128(reinterpret_cast<__m128i*>(Destination), Value);
+    }
+
+    ::LvglWindowsGdiRendererFillRowScalar(Destination, Count, Color);
+}
+
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+
+void LvglWindowsGdiRendererFillRowNeon(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color)
+{
+    const uint32x4_t Value = ::vdupq_n_u32(Color);
+
+    for (; Count >= 16; Count -= 16, Destination += 16)
+    {
+        ::vst1q_u32(Destination, Value);
+        ::vst1q_u32(Destination + 4, Value);
+        ::vst1q_u32(Destination + 8, Value);
+        ::vst1q_u32(Destination + 12, Value);
+    }
+
+    for (; Count >= 4; Count -= 4, Destination += 4)
     {
-        lv_coord_t Width = ::lv_area_get_width(&blend_area);
-        lv_coord_t Height = ::lv_area_get_height(&blend_area);
-
-        BITMAPINFO BitmapInfo = { 0 };
-        BitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        BitmapInfo.bmiHeader.biWidth = Width;
-        BitmapInfo.bmiHeader.biHeight = -Height;
-        BitmapInfo.bmiHeader.biPlanes = 1;
-        BitmapInfo.bmiHeader.biBitCount = 32;
-        BitmapInfo.bmiHeader.biCompression = BI_RGB;
-
-        ::StretchDIBits(
-            g_BufferDCHandle,
-            blend_area.x1,
-            blend_area.y1,
-            Width,
-            Height,
-            0,
-            0,
-            Width,
-            Height,
-            dsc->src_buf,
-            &BitmapInfo,
-            DIB_RGB_COLORS,
-            SRCCOPY);
+        ::vst1q_u32(Destination, Value);
+    }
+
+    ::LvglWindowsGdiRendererFillRowScalar(Destination, Count, Color);
+}
+
+#endif
+
+void LvglWindowsGdiRendererFillRow(
+    std::uint32_t* Destination,
+    std::size_t Count,
+    std::uint32_t Color)
+{
+#if defined(_M_IX86)
+    // The x86 build does not assume SSE2.
+    static const bool IsSse2Available = ::IsProcessorFeaturePresent(
+        PF_XMMI64_INSTRUCTIONS_AVAILABLE) != FALSE;
+    if (IsSse2Available)
+    {
+        ::LvglWindowsGdiRendererFillRowSse2(Destination, Count, Color);
     }
     else
     {
-        // Fill only non masked, fully opaque, normal blended and not too small
-        // areas.
+        ::LvglWindowsGdiRendererFillRowScalar(Destination, Count, Color);
+    }
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+    ::LvglWindowsGdiRendererFillRowSse2(Destination, Count, Color);
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+    ::LvglWindowsGdiRendererFillRowNeon(Destination, Count, Color);
+#else
+    ::LvglWindowsGdiRendererFillRowScalar(Destination, Count, Color);
+#endif
+}
+
+static lv_color_t LvglWindowsGdiRendererBlendColor(
+    lv_blend_mode_t BlendMode,
+    lv_color_t Foreground,
+    lv_color_t Background)
+{
+    // The alpha channel of the foreground is kept like LVGL does.
+    switch (BlendMode)
+    {
+    case LV_BLEND_MODE_ADDITIVE:
+        Foreground.ch.red = static_cast<std::uint8_t>(
+            LV_MIN(Background.ch.red + Foreground.ch.red, 255));
+        Foreground.ch.green = static_cast<std::uint8_t>(
+            LV_MIN(Background.ch.green + Foreground.ch.green, 255));
+        Foreground.ch.blue = static_cast<std::uint8_t>(
+            LV_MIN(Background.ch.blue + Foreground.ch.blue, 255));
+        break;
+    case LV_BLEND_MODE_SUBTRACTIVE:
+        Foreground.ch.red = static_cast<std::uint8_t>(
+            LV_MAX(Background.ch.red - Foreground.ch.red, 0));
+        Foreground.ch.green = static_cast<std::uint8_t>(
+            LV_MAX(Background.ch.green - Foreground.ch.green, 0));
+        Foreground.ch.blue = static_cast<std::uint8_t>(
+            LV_MAX(Background.ch.blue - Foreground.ch.blue, 0));
+        break;
+    case LV_BLEND_MODE_MULTIPLY:
+        Foreground.ch.red = static_cast<std::uint8_t>(
+            (Foreground.ch.red * Background.ch.red) >> 8);
+        Foreground.ch.green = static_cast<std::uint8_t>(
+            (Foreground.ch.green * Background.ch.green) >> 8);
+        Foreground.ch.blue = static_cast<std::uint8_t>(
+            (Foreground.ch.blue * Background.ch.blue) >> 8);
+        break;
+    default:
+        break;
+    }
+
+    return Foreground;
+}
 
-        HBRUSH Brush = nullptr;
+void LvglWindowsGdiRendererBlendRowScalar(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count)
+{
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        lv_opa_t Opacity = Parameters->Opacity;
+        if (Mask)
         {
-            std::uint32_t Index = ::lv_color_to32(dsc->color);
-            auto Iterator = g_SolidBrushCache.find(Index);
-            if (Iterator != g_SolidBrushCache.end())
+            if (!Mask[i])
             {
-                Brush = Iterator->second;
+                continue;
+            }
+
+            if (Parameters->MaskOnly)
+            {
+                Opacity = Mask[i];
+            }
+            else if (Mask[i] < Parameters->CoverMask)
+            {
+                Opacity = static_cast<lv_opa_t>((Mask[i] * Opacity) >> 8);
+            }
+        }
+
+        lv_color_t Foreground;
+        Foreground.full = Source ? Source[i] : Parameters->Color;
+        lv_color_t Background;
+        Background.full = Destination[i];
+
+        if (Parameters->BlendMode != LV_BLEND_MODE_NORMAL)
+        {
+            if (Opacity <= LV_OPA_MIN)
+            {
+                continue;
+            }
+
+            Foreground = ::LvglWindowsGdiRendererBlendColor(
+                Parameters->BlendMode,
+                Foreground,
+                Background);
+        }
+
+        Destination[i] = Opacity == LV_OPA_COVER
+            ? Foreground.full
+            : ::lv_color_mix(Foreground, Background, Opacity).full;
+    }
+}
+
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+
+void LvglWindowsGdiRendererBlendRowSse2(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count)
+{
+    const __m128i Zero = ::_mm_setzero_si128();
+    const __m128i AlphaMask = ::_mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i Opaque = ::_mm_set1_epi8(static_cast<char>(LV_OPA_COVER));
+    const __m128i Transparent = ::_mm_set1_epi8(LV_OPA_MIN);
+    const __m128i Color = ::_mm_set1_epi32(static_cast<int>(Parameters->Color));
+    const __m128i Opacity = ::_mm_set1_epi8(
+        static_cast<char>(Parameters->Opacity));
+    const __m128i Opacity16 = ::_mm_set1_epi16(Parameters->Opacity);
+    const __m128i CoverMask = ::_mm_set1_epi8(
+        static_cast<char>(Parameters->CoverMask));
+    const __m128i Maximum16 = ::_mm_set1_epi16(255);
+    const __m128i Divisor16 = ::_mm_set1_epi16(static_cast<short>(0x8081));
+
+    for (; Count >= 4; Count -= 4)
+    {
+        // All the vectors hold 4 pixels, the opacity of a pixel is repeated
+        // in its 4 channels, so the byte comparisons select whole pixels.
+
+        __m128i Keep = Zero;
+        __m128i Weight = Opacity;
+        if (Mask)
+        {
+            std::uint32_t MaskValue;
+            std::memcpy(&MaskValue, Mask, sizeof(MaskValue));
+            Mask += 4;
+            if (!MaskValue)
+            {
+                Destination += 4;
+                if (Source)
+                {
+                    Source += 4;
+                }
+                continue;
+            }
+
+            __m128i Value = ::_mm_cvtsi32_si128(static_cast<int>(MaskValue));
+            Value = ::_mm_unpacklo_epi8(Value, Value);
+            Value = ::_mm_unpacklo_epi16(Value, Value);
+
+            Keep = ::_mm_cmpeq_epi8(Value, Zero);
+            if (Parameters->MaskOnly)
+            {
+                Weight = Value;
             }
             else
             {
-                Brush = ::CreateSolidBrush(RGB(
-                    LV_COLOR_GET_R(dsc->color),
-                    LV_COLOR_GET_G(dsc->color),
-                    LV_COLOR_GET_B(dsc->color)));
-                if (Brush)
+                __m128i Scaled = ::_mm_packus_epi16(
+                    ::_mm_srli_epi16(::_mm_mullo_epi16(
+                        ::_mm_unpacklo_epi8(Value, Zero), Opacity16), 8),
+                    ::_mm_srli_epi16(::_mm_mullo_epi16(
+                        ::_mm_unpackhi_epi8(Value, Zero), Opacity16), 8));
+                __m128i Cover = ::_mm_cmpeq_epi8(
+                    ::_mm_max_epu8(Value, CoverMask),
+                    Value);
+                Weight = ::_mm_or_si128(
+                    ::_mm_and_si128(Cover, Opacity),
+                    ::_mm_andnot_si128(Cover, Scaled));
+            }
+        }
+
+        __m128i Background = ::_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(Destination));
+        __m128i Foreground = Color;
+        if (Source)
+        {
+            Foreground = ::_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(Source));
+            Source += 4;
+        }
+
+        if (Parameters->BlendMode != LV_BLEND_MODE_NORMAL)
+        {
+            Keep = ::_mm_or_si128(Keep, ::_mm_cmpeq_epi8(
+                ::_mm_min_epu8(Weight, Transparent),
+                Weight));
+
+            __m128i Blended;
+            if (Parameters->BlendMode == LV_BLEND_MODE_ADDITIVE)
+            {
+                Blended = ::_mm_adds_epu8(Background, Foreground);
+            }
+            else if (Parameters->BlendMode == LV_BLEND_MODE_SUBTRACTIVE)
+            {
+                Blended = ::_mm_subs_epu8(Background, Foreground);
+            }
+            else
+            {
+                Blended = ::_mm_packus_epi16(
+                    ::_mm_srli_epi16(::_mm_mullo_epi16(
+                        ::_mm_unpacklo_epi8(Foreground, Zero),
+                        ::_mm_unpacklo_epi8(Background, Zero)), 8),
+                    ::_mm_srli_epi16(::_mm_mullo_epi16(
+                        ::_mm_unpackhi_epi8(Foreground, Zero),
+                        ::_mm_unpackhi_epi8(Background, Zero)), 8));
+            }
+
+            Foreground = ::_mm_or_si128(
+                ::_mm_and_si128(AlphaMask, Foreground),
+                ::_mm_andnot_si128(AlphaMask, Blended));
+        }
+
+        // LV_UDIV255(Foreground * Weight + Background * (255 - Weight)), the
+        // sums fit in 16 bits and the division is the high half of the
+        // product with 0x8081 shifted by 7.
+        __m128i WeightLow = ::_mm_unpacklo_epi8(Weight, Zero);
+        __m128i WeightHigh = ::_mm_unpackhi_epi8(Weight, Zero);
+        __m128i MixedLow = ::_mm_add_epi16(
+            ::_mm_mullo_epi16(
+                ::_mm_unpacklo_epi8(Foreground, Zero),
+                WeightLow),
+            ::_mm_mullo_epi16(
+                ::_mm_unpacklo_epi8(Background, Zero),
+                ::_mm_sub_epi16(Maximum16, WeightLow)));
+        __m128i MixedHigh = ::_mm_add_epi16(
+            ::_mm_mullo_epi16(
+                ::_mm_unpackhi_epi8(Foreground, Zero),
+                WeightHigh),
+            ::_mm_mullo_epi16(
+                ::_mm_unpackhi_epi8(Background, Zero),
+                ::_mm_sub_epi16(Maximum16, WeightHigh)));
+        MixedLow = ::_mm_srli_epi16(::_mm_mulhi_epu16(MixedLow, Divisor16), 7);
+        MixedHigh = ::_mm_srli_epi16(
+            ::_mm_mulhi_epu16(MixedHigh, Divisor16),
+            7);
+        __m128i Mixed = ::_mm_or_si128(
+            ::_mm_packus_epi16(MixedLow, MixedHigh),
+            AlphaMask);
+
+        __m128i Copy = ::_mm_cmpeq_epi8(Weight, Opaque);
+        __m128i Result = ::_mm_or_si128(
+            ::_mm_and_si128(Copy, Foreground),
+            ::_mm_andnot_si128(Copy, Mixed));
+        Result = ::_mm_or_si128(
+            ::_mm_and_si128(Keep, Background),
+            ::_mm_andnot_si128(Keep, Result));
+
+        ::_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Result);
+        Destination += 4;
+    }
+
+    ::LvglWindowsGdiRendererBlendRowScalar(
+        Parameters,
+        Destination,
+        Source,
+        Mask,
+        Count);
+}
+
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+
+void LvglWindowsGdiRendererBlendRowNeon(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count)
+{
+    static const std::uint8_t RepeatIndices[16] =
+    {
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3
+    };
+
+    const uint8x16_t Repeat = ::vld1q_u8(RepeatIndices);
+    const uint8x16_t AlphaMask = ::vreinterpretq_u8_u32(
+        ::vdupq_n_u32(0xFF000000));
+    const uint8x16_t Color = ::vreinterpretq_u8_u32(
+        ::vdupq_n_u32(Parameters->Color));
+    const uint8x16_t Opacity = ::vdupq_n_u8(Parameters->Opacity);
+    const uint8x8_t Opacity8 = ::vdup_n_u8(Parameters->Opacity);
+    const uint8x16_t CoverMask = ::vdupq_n_u8(Parameters->CoverMask);
+
+    for (; Count >= 4; Count -= 4)
+    {
+        // All the vectors hold 4 pixels, the opacity of a pixel is repeated
+        // in its 4 channels, so the byte comparisons select whole pixels.
+
+        uint8x16_t Keep = ::vdupq_n_u8(0);
+        uint8x16_t Weight = Opacity;
+        if (Mask)
+        {
+            std::uint32_t MaskValue;
+            std::memcpy(&MaskValue, Mask, sizeof(MaskValue));
+            Mask += 4;
+            if (!MaskValue)
+            {
+                Destination += 4;
+                if (Source)
                 {
-                    g_SolidBrushCache.emplace(std::make_pair(Index, Brush));
+                    Source += 4;
                 }
+                continue;
+            }
+
+            uint8x16_t Value = ::vqtbl1q_u8(
+                ::vreinterpretq_u8_u32(::vdupq_n_u32(MaskValue)),
+                Repeat);
+
+            Keep = ::vceqq_u8(Value, ::vdupq_n_u8(0));
+            if (Parameters->MaskOnly)
+            {
+                Weight = Value;
+            }
+            else
+            {
+                uint8x16_t Scaled = ::vcombine_u8(
+                    ::vshrn_n_u16(
+                        ::vmull_u8(::vget_low_u8(Value), Opacity8), 8),
+                    ::vshrn_n_u16(
+                        ::vmull_u8(::vget_high_u8(Value), Opacity8), 8));
+                Weight = ::vbslq_u8(
+                    ::vcgeq_u8(Value, CoverMask),
+                    Opacity,
+                    Scaled);
+            }
+        }
+
+        uint8x16_t Background = ::vreinterpretq_u8_u32(
+            ::vld1q_u32(Destination));
+        uint8x16_t Foreground = Color;
+        if (Source)
+        {
+            Foreground = ::vreinterpretq_u8_u32(::vld1q_u32(Source));
+            Source += 4;
+        }
+
+        if (Parameters->BlendMode != LV_BLEND_MODE_NORMAL)
+        {
+            Keep = ::vorrq_u8(
+                Keep,
+                ::vcleq_u8(Weight, ::vdupq_n_u8(LV_OPA_MIN)));
+
+            uint8x16_t Blended;
+            if (Parameters->BlendMode == LV_BLEND_MODE_ADDITIVE)
+            {
+                Blended = ::vqaddq_u8(Background, Foreground);
+            }
+            else if (Parameters->BlendMode == LV_BLEND_MODE_SUBTRACTIVE)
+            {
+                Blended = ::vqsubq_u8(Background, Foreground);
+            }
+            else
+            {
+                Blended = ::vcombine_u8(
+                    ::vshrn_n_u16(::vmull_u8(
+                        ::vget_low_u8(Foreground),
+                        ::vget_low_u8(Background)), 8),
+                    ::vshrn_n_u16(::vmull_u8(
+                        ::vget_high_u8(Foreground),
+                        ::vget_high_u8(Background)), 8));
             }
+
+            Foreground = ::vbslq_u8(AlphaMask, Foreground, Blended);
+        }
+
+        // LV_UDIV255(Foreground * Weight + Background * (255 - Weight)), for
+        // the sums of the products of 8-bit values it equals
+        // (Sum + 1 + (Sum >> 8)) >> 8.
+        uint8x16_t Inverse = ::vmvnq_u8(Weight);
+        uint16x8_t MixedLow = ::vmlal_u8(
+            ::vmull_u8(::vget_low_u8(Foreground), ::vget_low_u8(Weight)),
+            ::vget_low_u8(Background),
+            ::vget_low_u8(Inverse));
+        uint16x8_t MixedHigh = ::vmlal_u8(
+            ::vmull_u8(::vget_high_u8(Foreground), ::vget_high_u8(Weight)),
+            ::vget_high_u8(Background),
+            ::vget_high_u8(Inverse));
+        MixedLow = ::vaddq_u16(
+            ::vaddq_u16(MixedLow, ::vshrq_n_u16(MixedLow, 8)),
+            ::vdupq_n_u16(1));
+        MixedHigh = ::vaddq_u16(
+            ::vaddq_u16(MixedHigh, ::vshrq_n_u16(MixedHigh, 8)),
+            ::vdupq_n_u16(1));
+        uint8x16_t Mixed = ::vorrq_u8(
+            ::vcombine_u8(
+                ::vshrn_n_u16(MixedLow, 8),
+                ::vshrn_n_u16(MixedHigh, 8)),
+            AlphaMask);
+
+        uint8x16_t Result = ::vbslq_u8(
+            ::vceqq_u8(Weight, ::vdupq_n_u8(LV_OPA_COVER)),
+            Foreground,
+            Mixed);
+        Result = ::vbslq_u8(Keep, Background, Result);
+
+        ::vst1q_u32(Destination, ::vreinterpretq_u32_u8(Result));
+        Destination += 4;
+    }
+
+    ::LvglWindowsGdiRendererBlendRowScalar(
+        Parameters,
+        Destination,
+        Source,
+        Mask,
+        Count);
+}
+
+#endif
+
+void LvglWindowsGdiRendererBlendRow(
+    const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+    std::uint32_t* Destination,
+    const std::uint32_t* Source,
+    const lv_opa_t* Mask,
+    std::size_t Count)
+{
+#if defined(_M_IX86)
+    // The x86 build does not assume SSE2.
+    static const bool IsSse2Available = ::IsProcessorFeaturePresent(
+        PF_XMMI64_INSTRUCTIONS_AVAILABLE) != FALSE;
+    if (IsSse2Available)
+    {
+        ::LvglWindowsGdiRendererBlendRowSse2(
+            Parameters, Destination, Source, Mask, Count);
+    }
+    else
+    {
+        ::LvglWindowsGdiRendererBlendRowScalar(
+            Parameters, Destination, Source, Mask, Count);
+    }
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+    ::LvglWindowsGdiRendererBlendRowSse2(
+        Parameters, Destination, Source, Mask, Count);
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+    ::LvglWindowsGdiRendererBlendRowNeon(
+        Parameters, Destination, Source, Mask, Count);
+#else
+    ::LvglWindowsGdiRendererBlendRowScalar(
+        Parameters, Destination, Source, Mask, Count);
+#endif
+}
+
+/**
+ * @brief The count of pixels from which a fill or a blend is split into bands
+ *        drawn concurrently by the renderer worker threads.
+*/
+#ifndef LVGL_WINDOWS_GDI_RENDERER_PARALLEL_THRESHOLD
+#define LVGL_WINDOWS_GDI_RENDERER_PARALLEL_THRESHOLD 16384
+#endif
+
+/**
+ * @brief The height, in rows, of the bands drawn by the renderer worker
+ *        threads.
+*/
+#ifndef LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT
+#define LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT 16
+#endif
+
+/**
+ * @brief The count of the renderer worker threads. Zero means one less than
+ *        the count of the logical processors, up to
+ *        LVGL_WINDOWS_GDI_RENDERER_MAXIMUM_WORKER_COUNT.
+*/
+#ifndef LVGL_WINDOWS_GDI_RENDERER_WORKER_COUNT
+#define LVGL_WINDOWS_GDI_RENDERER_WORKER_COUNT 0
+#endif
+
+/**
+ * @brief The most renderer worker threads started for the logical
+ *        processors. The fills and the copies are bound by the memory
+ *        bandwidth, which a few cores already use up, and an 800x480 area
+ *        only has 30 bands of 16 rows to share. See the Scaling case of
+ *        LVGL.Windows.Desktop.Benchmarks.cpp.
+*/
+#ifndef LVGL_WINDOWS_GDI_RENDERER_MAXIMUM_WORKER_COUNT
+#define LVGL_WINDOWS_GDI_RENDERER_MAXIMUM_WORKER_COUNT 7
+#endif
+
+typedef enum _LVGL_WINDOWS_GDI_RENDERER_JOB_TYPE
+{
+    LvglWindowsGdiRendererJobFill,
+    LvglWindowsGdiRendererJobCopy,
+    LvglWindowsGdiRendererJobBlend,
+} LVGL_WINDOWS_GDI_RENDERER_JOB_TYPE, *PLVGL_WINDOWS_GDI_RENDERER_JOB_TYPE;
+
+/**
+ * @brief The rows of the draw buffer to fill, to copy an image to or to blend
+ *        with the blend kernels.
+*/
+typedef struct _LVGL_WINDOWS_GDI_RENDERER_JOB
+{
+    LVGL_WINDOWS_GDI_RENDERER_JOB_TYPE Type;
+    LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS Parameters;
+    std::uint32_t* Destination;
+    std::size_t Stride;
+    const std::uint32_t* Source;
+    std::size_t SourceStride;
+    const lv_opa_t* Mask;
+    std::size_t MaskStride;
+    std::size_t Width;
+    std::size_t Height;
+} LVGL_WINDOWS_GDI_RENDERER_JOB, *PLVGL_WINDOWS_GDI_RENDERER_JOB;
+
+/**
+ * @brief The renderer worker threads. The thread which runs LVGL submits one
+ *        job at a time, split into bands which the workers and the thread
+ *        itself take in turn until none is left, and waits for it before the
+ *        draw returns.
+*/
+typedef struct _LVGL_WINDOWS_GDI_RENDERER_POOL
+{
+    std::mutex Mutex;
+    std::condition_variable WorkCondition;
+    std::condition_variable DoneCondition;
+    std::vector<std::thread> Workers;
+
+    /**
+     * @brief Set under the mutex to stop the workers.
+    */
+    bool Quit;
+
+    /**
+     * @brief Incremented under the mutex for each new job.
+    */
+    std::uint64_t Generation;
+
+    /**
+     * @brief The count of workers which take bands of the current job. The
+     *        job is not replaced until it is zero.
+    */
+    std::size_t ActiveWorkers;
+
+    LVGL_WINDOWS_GDI_RENDERER_JOB Job;
+    std::size_t BandCount;
+    std::atomic<std::size_t> NextBand;
+} LVGL_WINDOWS_GDI_RENDERER_POOL, *PLVGL_WINDOWS_GDI_RENDERER_POOL;
+
+static PLVGL_WINDOWS_GDI_RENDERER_POOL g_RendererPool = nullptr;
+
+static void LvglWindowsGdiRendererRunRows(
+    const LVGL_WINDOWS_GDI_RENDERER_JOB* Job,
+    std::size_t FirstRow,
+    std::size_t LastRow)
+{
+    std::uint32_t* Destination = Job->Destination + FirstRow * Job->Stride;
+    const std::uint32_t* Source = Job->Source
+        ? Job->Source + FirstRow * Job->SourceStride
+        : nullptr;
+    const lv_opa_t* Mask = Job->Mask
+        ? Job->Mask + FirstRow * Job->MaskStride
+        : nullptr;
+
+    for (std::size_t y = FirstRow; y < LastRow; ++y)
+    {
+        if (Job->Type == LvglWindowsGdiRendererJobFill)
+        {
+            ::LvglWindowsGdiRendererFillRow(
+                Destination,
+                Job->Width,
+                Job->Parameters.Color);
+        }
+        else if (Job->Type == LvglWindowsGdiRendererJobCopy)
+        {
+            std::memcpy(
+                Destination,
+                Source,
+                Job->Width * sizeof(std::uint32_t));
+        }
+        else
+        {
+            ::LvglWindowsGdiRendererBlendRow(
+                &Job->Parameters,
+                Destination,
+                Source,
+                Mask,
+                Job->Width);
         }
 
-        if (Brush)
+        Destination += Job->Stride;
+        if (Source)
+        {
+            Source += Job->SourceStride;
+        }
+        if (Mask)
         {
-            RECT RenderArea;
-            RenderArea.left = blend_area.x1;
-            RenderArea.top = blend_area.y1;
-            RenderArea.right = blend_area.x2 + 1;
-            RenderArea.bottom = blend_area.y2 + 1;
-            ::FillRect(g_BufferDCHandle, &RenderArea, Brush);
+            Mask += Job->MaskStride;
         }
     }
 }
 
+static void LvglWindowsGdiRendererRunBands(
+    PLVGL_WINDOWS_GDI_RENDERER_POOL Pool)
+{
+    for (;;)
+    {
+        std::size_t Band = Pool->NextBand.fetch_add(1);
+        if (Band >= Pool->BandCount)
+        {
+            break;
+        }
+
+        std::size_t FirstRow = Band * LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT;
+        ::LvglWindowsGdiRendererRunRows(
+            &Pool->Job,
+            FirstRow,
+            std::min<std::size_t>(
+                FirstRow + LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT,
+                Pool->Job.Height));
+    }
+}
+
+static void LvglWindowsGdiRendererWorker(
+    PLVGL_WINDOWS_GDI_RENDERER_POOL Pool)
+{
+    std::uint64_t Generation = 0;
+
+    std::unique_lock<std::mutex> Lock(Pool->Mutex);
+    for (;;)
+    {
+        Pool->WorkCondition.wait(Lock, [&]()
+        {
+            return Pool->Quit || Pool->Generation != Generation;
+        });
+        if (Pool->Quit)
+        {
+            break;
+        }
+        Generation = Pool->Generation;
+        ++Pool->ActiveWorkers;
+        Lock.unlock();
+
+        ::LvglWindowsGdiRendererRunBands(Pool);
+
+        Lock.lock();
+        if (!--Pool->ActiveWorkers)
+        {
+            Pool->DoneCondition.notify_one();
+        }
+    }
+}
+
+void LvglWindowsGdiRendererStartWorkers()
+{
+    std::size_t WorkerCount = LVGL_WINDOWS_GDI_RENDERER_WORKER_COUNT;
+    if (!WorkerCount)
+    {
+        unsigned int ProcessorCount = std::thread::hardware_concurrency();
+        WorkerCount = ProcessorCount > 1 ? ProcessorCount - 1 : 0;
+        WorkerCount = std::min<std::size_t>(
+            WorkerCount,
+            LVGL_WINDOWS_GDI_RENDERER_MAXIMUM_WORKER_COUNT);
+    }
+
+    ::LvglWindowsGdiRendererStartWorkerThreads(WorkerCount);
+}
+
+void LvglWindowsGdiRendererStartWorkerThreads(
+    std::size_t WorkerCount)
+{
+    if (g_RendererPool || !WorkerCount)
+    {
+        return;
+    }
+
+    g_RendererPool = new LVGL_WINDOWS_GDI_RENDERER_POOL();
+    g_RendererPool->Quit = false;
+    g_RendererPool->Generation = 0;
+    g_RendererPool->ActiveWorkers = 0;
+    g_RendererPool->BandCount = 0;
+    for (std::size_t i = 0; i < WorkerCount; ++i)
+    {
+        g_RendererPool->Workers.emplace_back(
+            ::LvglWindowsGdiRendererWorker,
+            g_RendererPool);
+    }
+}
+
+void LvglWindowsGdiRendererStopWorkers()
+{
+    PLVGL_WINDOWS_GDI_RENDERER_POOL Pool = g_RendererPool;
+    if (!Pool)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(Pool->Mutex);
+        Pool->Quit = true;
+    }
+    Pool->WorkCondition.notify_all();
+
+    for (std::thread& Worker : Pool->Workers)
+    {
+        Worker.join();
+    }
+
+    g_RendererPool = nullptr;
+    delete Pool;
+}
+
+/**
+ * @brief Draws a job, in bands on the renderer worker threads if it is large
+ *        enough. All the bands are drawn when it returns, so the LVGL code
+ *        which reads or writes the draw buffer directly never overlaps them.
+*/
+static void LvglWindowsGdiRendererSubmit(
+    const LVGL_WINDOWS_GDI_RENDERER_JOB* Job)
+{
+    PLVGL_WINDOWS_GDI_RENDERER_POOL Pool = g_RendererPool;
+    if (!Pool ||
+        Job->Width * Job->Height < LVGL_WINDOWS_GDI_RENDERER_PARALLEL_THRESHOLD ||
+        Job->Height < 2 * LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT)
+    {
+        ::LvglWindowsGdiRendererRunRows(Job, 0, Job->Height);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> Lock(Pool->Mutex);
+
+        // The workers which woke up late may still look at the last job.
+        Pool->DoneCondition.wait(Lock, [&]()
+        {
+            return !Pool->ActiveWorkers;
+        });
+
+        Pool->Job = *Job;
+        Pool->BandCount = (Job->Height + LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT
+            - 1) / LVGL_WINDOWS_GDI_RENDERER_BAND_HEIGHT;
+        Pool->NextBand = 0;
+        ++Pool->Generation;
+    }
+    Pool->WorkCondition.notify_all();
+
+    ::LvglWindowsGdiRendererRunBands(Pool);
+
+    std::unique_lock<std::mutex> Lock(Pool->Mutex);
+    Pool->DoneCondition.wait(Lock, [&]()
+    {
+        return !Pool->ActiveWorkers;
+    });
+}
+
+static void LvglWindowsGdiRendererInitializeJob(
+    PLVGL_WINDOWS_GDI_RENDERER_JOB Job,
+    LVGL_WINDOWS_GDI_RENDERER_JOB_TYPE Type,
+    lv_draw_ctx_t* draw_ctx,
+    const lv_area_t* Area)
+{
+    Job->Type = Type;
+    Job->Stride = ::lv_area_get_width(draw_ctx->buf_area);
+    Job->Destination = reinterpret_cast<std::uint32_t*>(draw_ctx->buf);
+    Job->Destination += static_cast<std::size_t>(
+        Area->y1 - draw_ctx->buf_area->y1)
+        * Job->Stride + (Area->x1 - draw_ctx->buf_area->x1);
+    Job->Source = nullptr;
+    Job->SourceStride = 0;
+    Job->Mask = nullptr;
+    Job->MaskStride = 0;
+    Job->Width = ::lv_area_get_width(Area);
+    Job->Height = ::lv_area_get_height(Area);
+}
+
+/**
+ * @brief Fills an area of the draw buffer, which is the frame buffer or a
+ *        layer, with an opaque color in place.
+*/
+static void LvglWindowsGdiRendererFill(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_area_t* Area,
+    lv_color_t Color)
+{
+    LVGL_WINDOWS_GDI_RENDERER_JOB Job;
+    ::LvglWindowsGdiRendererInitializeJob(
+        &Job,
+        LvglWindowsGdiRendererJobFill,
+        draw_ctx,
+        Area);
+    Job.Parameters.Color = Color.full;
+
+    ::LvglWindowsGdiRendererSubmit(&Job);
+}
+
+/**
+ * @brief Copies an area of an opaque image to the draw buffer in place. The
+ *        rows of the image are as wide as the area to blend, not as the
+ *        clipped area.
+*/
+static void LvglWindowsGdiRendererCopy(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc,
+    const lv_area_t* Area)
+{
+    LVGL_WINDOWS_GDI_RENDERER_JOB Job;
+    ::LvglWindowsGdiRendererInitializeJob(
+        &Job,
+        LvglWindowsGdiRendererJobCopy,
+        draw_ctx,
+        Area);
+    Job.SourceStride = ::lv_area_get_width(dsc->blend_area);
+    Job.Source = reinterpret_cast<const std::uint32_t*>(dsc->src_buf);
+    Job.Source += static_cast<std::size_t>(Area->y1 - dsc->blend_area->y1)
+        * Job.SourceStride + (Area->x1 - dsc->blend_area->x1);
+
+    ::LvglWindowsGdiRendererSubmit(&Job);
+}
+
+/**
+ * @brief Blends a color or an image with an opacity, a mask or a blend mode
+ *        other than normal to an area of the draw buffer in place.
+*/
+static void LvglWindowsGdiRendererBlend(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc,
+    const lv_area_t* Area,
+    const lv_opa_t* Mask)
+{
+    LVGL_WINDOWS_GDI_RENDERER_JOB Job;
+    ::LvglWindowsGdiRendererInitializeJob(
+        &Job,
+        LvglWindowsGdiRendererJobBlend,
+        draw_ctx,
+        Area);
+
+    LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS& Parameters = Job.Parameters;
+    Parameters.Color = dsc->color.full;
+    Parameters.Opacity = dsc->opa;
+    Parameters.BlendMode = dsc->blend_mode;
+    if (dsc->blend_mode != LV_BLEND_MODE_NORMAL)
+    {
+        Parameters.CoverMask = LV_OPA_MAX;
+        Parameters.MaskOnly = false;
+    }
+    else if (dsc->src_buf)
+    {
+        Parameters.CoverMask = LV_OPA_MAX;
+        Parameters.MaskOnly = dsc->opa > LV_OPA_MAX;
+    }
+    else
+    {
+        Parameters.CoverMask = LV_OPA_COVER;
+        Parameters.MaskOnly = dsc->opa >= LV_OPA_MAX;
+    }
+
+    if (dsc->src_buf)
+    {
+        Job.SourceStride = ::lv_area_get_width(dsc->blend_area);
+        Job.Source = reinterpret_cast<const std::uint32_t*>(dsc->src_buf);
+        Job.Source += static_cast<std::size_t>(Area->y1 - dsc->blend_area->y1)
+            * Job.SourceStride + (Area->x1 - dsc->blend_area->x1);
+    }
+
+    if (Mask)
+    {
+        Job.MaskStride = ::lv_area_get_width(dsc->mask_area);
+        Job.Mask = Mask + static_cast<std::size_t>(
+            Area->y1 - dsc->mask_area->y1)
+            * Job.MaskStride + (Area->x1 - dsc->mask_area->x1);
+    }
+
+    ::LvglWindowsGdiRendererSubmit(&Job);
+}
+
+void LvglWindowsGdiRendererBlendCallback(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc)
+{
+    // Let's get the blend area which is the intersection of the area to fill
+    // and the clip area.
+    lv_area_t blend_area;
+    if (!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area))
+    {
+        return;
+    }
+
+    // The mask is ignored if it covers the whole area, like LVGL does.
+    const lv_opa_t* Mask = dsc->mask_buf;
+    if (Mask && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP)
+    {
+        return;
+    }
+    else if (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER)
+    {
+        Mask = nullptr;
+    }
+
+    // Fallback: The renderer doesn't support these settings. Call the
+    // Software Renderer.
+    lv_disp_drv_t* DisplayDriver = ::_lv_refr_get_disp_refreshing()->driver;
+    if (DisplayDriver->set_px_cb ||
+        DisplayDriver->screen_transp ||
+        (Mask && !DisplayDriver->antialiasing) ||
+        !(dsc->blend_mode == LV_BLEND_MODE_NORMAL ||
+            dsc->blend_mode == LV_BLEND_MODE_ADDITIVE ||
+            dsc->blend_mode == LV_BLEND_MODE_SUBTRACTIVE ||
+            dsc->blend_mode == LV_BLEND_MODE_MULTIPLY))
+    {
+        ::lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    if (Mask ||
+        dsc->opa < LV_OPA_MAX ||
+        dsc->blend_mode != LV_BLEND_MODE_NORMAL)
+    {
+        ::LvglWindowsGdiRendererBlend(draw_ctx, dsc, &blend_area, Mask);
+    }
+    else if (dsc->src_buf)
+    {
+        ::LvglWindowsGdiRendererCopy(draw_ctx, dsc, &blend_area);
+    }
+    else
+    {
+        ::LvglWindowsGdiRendererFill(draw_ctx, &blend_area, dsc->color);
+    }
+}
+
 void LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
     lv_draw_ctx_t* draw_ctx)
 {
@@ -482,6 +1536,8 @@ void LvglWindowsGdiRendererInitialize(
         LvglWindowsGdiRendererBlendCallback;
     RendererContext->base_draw.wait_for_finish =
         LvglWindowsGdiRendererBaseDrawWaitForFinishCallback;
+
+    ::LvglWindowsGdiRendererStartWorkers();
 }
 
 void LvglCreateDisplayDriver(
@@ -835,6 +1891,7 @@ LRESULT CALLBACK WndProc(
     case WM_DPICHANGED:
     {
         g_WindowDPI = HIWORD(wParam);
+        ::LvglWindowsGdiFontNotifyDpiChanged(g_WindowDPI);
 
         // Resize the window
         auto lprcNewScale = reinterpret_cast<RECT*>(lParam);
@@ -919,6 +1976,7 @@ bool LvglWindowsInitialize(
 
     ::LvglEnableChildWindowDpiMessage(g_WindowHandle);
     g_WindowDPI = ::LvglGetDpiForWindow(g_WindowHandle);
+    ::LvglWindowsGdiFontNotifyDpiChanged(g_WindowDPI);
 
     static lv_disp_drv_t disp_drv;
     ::lv_disp_drv_init(&disp_drv);
@@ -984,6 +2042,8 @@ void LvglTaskSchedulerLoop()
         ::lv_timer_handler();
         ::Sleep(1);
     }
+
+    ::LvglWindowsGdiRendererStopWorkers();
 }
 
 int LvglWindowsLoop()
@@ -993,18 +2053,14 @@ int LvglWindowsLoop()
     {
         ::TranslateMessage(&Message);
         ::DispatchMessageW(&Message);
-
-        if (Message.message == WM_QUIT)
-        {
-            g_WindowQuitSignal = true;
-        }
     }
 
+    // GetMessageW returns zero for WM_QUIT, so the loop above never sees it.
+    g_WindowQuitSignal = true;
+
     return static_cast<int>(Message.wParam);
 }
 
-#include <thread>
-
 int WINAPI wWinMain(
     _In_ HINSTANCE hInstance,
     _In_opt_ HINSTANCE hPrevInstance,
@@ -1028,7 +2084,11 @@ int WINAPI wWinMain(
     //::lv_demo_keypad_encoder();
     ::lv_demo_benchmark();
 
-    std::thread(::LvglTaskSchedulerLoop).detach();
+    std::thread TaskSchedulerThread(::LvglTaskSchedulerLoop);
 
-    return ::LvglWindowsLoop();
+    int Result = ::LvglWindowsLoop();
+
+    TaskSchedulerThread.join();
+
+    return Result;
 }
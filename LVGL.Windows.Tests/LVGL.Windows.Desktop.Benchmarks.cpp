@@ -0,0 +1,444 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Desktop.Benchmarks.cpp
+ * PURPOSE:   Implementation for the benchmarks of the renderer of the LVGL
+ *            ported to Windows Desktop
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Windows.Desktop.Internal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    typedef void (*LVGL_WINDOWS_DESKTOP_BENCHMARKS_FILL_ROW)(
+        std::uint32_t* Destination,
+        std::size_t Count,
+        std::uint32_t Color);
+
+    /**
+     * @brief Returns the nanoseconds of a fill of an area, the rows start at
+     *        4-byte aligned addresses like the rows of the LVGL buffers.
+    */
+    double LvglWindowsDesktopBenchmarksFillRows(
+        LVGL_WINDOWS_DESKTOP_BENCHMARKS_FILL_ROW FillRow,
+        std::size_t Width,
+        std::size_t Height,
+        std::size_t Stride,
+        std::size_t RepeatCount)
+    {
+        std::vector<std::uint32_t> Buffer(Stride * Height + 1);
+
+        auto Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            for (std::size_t y = 0; y < Height; ++y)
+            {
+                FillRow(
+                    &Buffer[1 + y * Stride],
+                    Width,
+                    static_cast<std::uint32_t>(0xFF000000 + Repeat));
+            }
+        }
+        std::chrono::duration<double, std::nano> Duration =
+            std::chrono::steady_clock::now() - Start;
+
+        return Duration.count() / RepeatCount;
+    }
+
+    /**
+     * @brief Returns the nanoseconds of an opaque fill through the blend
+     *        callback, with the worker threads of the renderer.
+    */
+    double LvglWindowsDesktopBenchmarksFill(
+        lv_coord_t Width,
+        lv_coord_t Height,
+        std::size_t RepeatCount)
+    {
+        std::vector<std::uint32_t> Buffer(
+            static_cast<std::size_t>(Width) * Height);
+        lv_area_t Area =
+        {
+            0,
+            0,
+            static_cast<lv_coord_t>(Width - 1),
+            static_cast<lv_coord_t>(Height - 1)
+        };
+
+        lv_draw_sw_ctx_t Context = {};
+        Context.base_draw.buf = Buffer.data();
+        Context.base_draw.buf_area = &Area;
+        Context.base_draw.clip_area = &Area;
+
+        lv_draw_sw_blend_dsc_t Description = {};
+        Description.blend_area = &Area;
+        Description.opa = LV_OPA_COVER;
+
+        auto Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            Description.color.full =
+                static_cast<std::uint32_t>(0xFF000000 + Repeat);
+            ::LvglWindowsGdiRendererBlendCallback(
+                &Context.base_draw,
+                &Description);
+            ::LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
+                &Context.base_draw);
+        }
+        std::chrono::duration<double, std::nano> Duration =
+            std::chrono::steady_clock::now() - Start;
+
+        return Duration.count() / RepeatCount;
+    }
+
+    typedef enum _LVGL_WINDOWS_DESKTOP_BENCHMARKS_DRAW_TYPE
+    {
+        LvglWindowsDesktopBenchmarksDrawFill,
+        LvglWindowsDesktopBenchmarksDrawCopy,
+        LvglWindowsDesktopBenchmarksDrawBlend,
+    } LVGL_WINDOWS_DESKTOP_BENCHMARKS_DRAW_TYPE;
+
+    /**
+     * @brief Returns the nanoseconds of an opaque fill, an opaque image copy
+     *        or a translucent image blend with a mask of a whole 800x480
+     *        buffer through the blend callback.
+    */
+    double LvglWindowsDesktopBenchmarksDraw(
+        LVGL_WINDOWS_DESKTOP_BENCHMARKS_DRAW_TYPE Type,
+        std::size_t RepeatCount)
+    {
+        const std::size_t Pixels = 800 * 480;
+        std::vector<std::uint32_t> Buffer(Pixels);
+        std::vector<lv_color_t> Source(Pixels);
+        std::vector<lv_opa_t> Mask(Pixels);
+        for (std::size_t i = 0; i < Pixels; ++i)
+        {
+            Source[i].full = 0xFF000000 | static_cast<std::uint32_t>(i);
+            Mask[i] = static_cast<lv_opa_t>(i);
+        }
+        lv_area_t Area = { 0, 0, 799, 479 };
+
+        lv_draw_sw_ctx_t Context = {};
+        Context.base_draw.buf = Buffer.data();
+        Context.base_draw.buf_area = &Area;
+        Context.base_draw.clip_area = &Area;
+
+        lv_draw_sw_blend_dsc_t Description = {};
+        Description.blend_area = &Area;
+        Description.opa = LV_OPA_COVER;
+        if (Type != LvglWindowsDesktopBenchmarksDrawFill)
+        {
+            Description.src_buf = Source.data();
+        }
+        if (Type == LvglWindowsDesktopBenchmarksDrawBlend)
+        {
+            Description.opa = 180;
+            Description.mask_buf = Mask.data();
+            Description.mask_area = &Area;
+            Description.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
+
+        auto Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            Description.color.full =
+                static_cast<std::uint32_t>(0xFF000000 + Repeat);
+            ::LvglWindowsGdiRendererBlendCallback(
+                &Context.base_draw,
+                &Description);
+            ::LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
+                &Context.base_draw);
+        }
+        std::chrono::duration<double, std::nano> Duration =
+            std::chrono::steady_clock::now() - Start;
+
+        return Duration.count() / RepeatCount;
+    }
+
+    /**
+     * @brief Returns the frames of random invalidated areas of up to 100x50
+     *        pixels in an 800x480 window.
+    */
+    std::vector<std::vector<lv_area_t>> LvglWindowsDesktopBenchmarksFrames(
+        std::size_t FrameCount,
+        std::size_t AreaCount)
+    {
+        std::vector<std::vector<lv_area_t>> Frames(FrameCount);
+        for (std::vector<lv_area_t>& Frame : Frames)
+        {
+            for (std::size_t i = 0; i < AreaCount; ++i)
+            {
+                lv_area_t Area;
+                Area.x1 = static_cast<lv_coord_t>(
+                    ::LvglWindowsTestsRandom() % 700);
+                Area.y1 = static_cast<lv_coord_t>(
+                    ::LvglWindowsTestsRandom() % 430);
+                Area.x2 = static_cast<lv_coord_t>(
+                    Area.x1 + ::LvglWindowsTestsRandom() % 100);
+                Area.y2 = static_cast<lv_coord_t>(
+                    Area.y1 + ::LvglWindowsTestsRandom() % 50);
+                Frame.push_back(Area);
+            }
+        }
+
+        return Frames;
+    }
+}
+
+/**
+ * @brief The fills of opaque areas with the scalar kernel, the dispatched
+ *        kernel and the blend callback.
+*/
+static void LvglWindowsDesktopBenchmarksFillAreas()
+{
+    g_LvglWindowsTestsDisplayDriver.antialiasing = 1;
+    ::LvglWindowsGdiRendererStartWorkers();
+
+    static const struct
+    {
+        const char* Name;
+        std::size_t Width;
+        std::size_t Height;
+        std::size_t Stride;
+        std::size_t RepeatCount;
+    } Areas[] =
+    {
+        { "120x40 in a 1920 wide buffer", 120, 40, 1920, 20000 },
+        { "800x16 band", 800, 16, 800, 20000 },
+        { "800x480", 800, 480, 800, 500 },
+        { "1920x1080", 1920, 1080, 1920, 100 },
+    };
+
+    std::printf("Fill of an opaque area, nanoseconds per area\n");
+    std::printf(
+        "%-30s %12s %12s %12s\n",
+        "Area",
+        "Scalar",
+        "FillRow",
+        "Callback");
+    for (const auto& Area : Areas)
+    {
+        std::size_t RepeatCount =
+            ::LvglWindowsTestsRepeatCount(Area.RepeatCount);
+        double Scalar = ::LvglWindowsDesktopBenchmarksFillRows(
+            ::LvglWindowsGdiRendererFillRowScalar,
+            Area.Width,
+            Area.Height,
+            Area.Stride,
+            RepeatCount);
+        double FillRow = ::LvglWindowsDesktopBenchmarksFillRows(
+            ::LvglWindowsGdiRendererFillRow,
+            Area.Width,
+            Area.Height,
+            Area.Stride,
+            RepeatCount);
+        double Callback = ::LvglWindowsDesktopBenchmarksFill(
+            static_cast<lv_coord_t>(Area.Width),
+            static_cast<lv_coord_t>(Area.Height),
+            RepeatCount);
+        std::printf(
+            "%-30s %12.0f %12.0f %12.0f\n",
+            Area.Name,
+            Scalar,
+            FillRow,
+            Callback);
+    }
+
+    ::LvglWindowsGdiRendererStopWorkers();
+}
+
+/**
+ * @brief The merge of the flushed areas of a frame for several counts of
+ *        areas, and the areas presented for several costs of a BitBlt call.
+ *        The copy of the presented pixels between two 32-bit buffers is
+ *        measured, the cost of the BitBlt call itself is not, because it
+ *        needs GDI and a window.
+*/
+static void LvglWindowsDesktopBenchmarksFlushAreas()
+{
+    std::size_t FrameCount = ::LvglWindowsTestsRepeatCount(1000);
+
+    std::printf("Merge of the flushed areas, default cost\n");
+    std::printf(
+        "%-8s %12s %12s\n",
+        "Areas",
+        "ns / frame",
+        "Blits");
+    static const std::size_t AreaCounts[] = { 8, 32, 128, 512 };
+    for (std::size_t AreaCount : AreaCounts)
+    {
+        std::vector<std::vector<lv_area_t>> Frames =
+            ::LvglWindowsDesktopBenchmarksFrames(FrameCount, AreaCount);
+
+        std::size_t BlitCount = 0;
+        auto Start = std::chrono::steady_clock::now();
+        for (std::vector<lv_area_t>& Frame : Frames)
+        {
+            BlitCount += ::LvglDisplayDriverMergeFlushAreas(
+                Frame.data(),
+                Frame.size(),
+                LVGL_DISPLAY_FLUSH_BLIT_COST);
+        }
+        std::chrono::duration<double, std::nano> Duration =
+            std::chrono::steady_clock::now() - Start;
+
+        std::printf(
+            "%-8zu %12.0f %12.2f\n",
+            AreaCount,
+            Duration.count() / FrameCount,
+            static_cast<double>(BlitCount) / FrameCount);
+    }
+
+    std::vector<std::uint32_t> Source(800 * 480, 0xFF336699);
+    std::vector<std::uint32_t> Destination(800 * 480);
+    const std::vector<std::vector<lv_area_t>> SweepFrames =
+        ::LvglWindowsDesktopBenchmarksFrames(FrameCount, 32);
+
+    std::printf("\nThe same frames of 32 areas for each cost\n");
+    std::printf(
+        "%-8s %12s %12s %12s\n",
+        "Cost",
+        "Blits",
+        "Pixels",
+        "Copy ns");
+    static const std::uint32_t BlitCosts[] =
+    {
+        0,
+        1024,
+        LVGL_DISPLAY_FLUSH_BLIT_COST,
+        16384,
+        65536
+    };
+    for (std::uint32_t BlitCost : BlitCosts)
+    {
+        std::vector<std::vector<lv_area_t>> Frames = SweepFrames;
+
+        std::size_t BlitCount = 0;
+        std::size_t Pixels = 0;
+        std::chrono::duration<double, std::nano> Duration(0);
+        for (std::vector<lv_area_t>& Frame : Frames)
+        {
+            Frame.resize(::LvglDisplayDriverMergeFlushAreas(
+                Frame.data(),
+                Frame.size(),
+                BlitCost));
+
+            auto Start = std::chrono::steady_clock::now();
+            for (const lv_area_t& Area : Frame)
+            {
+                std::size_t Width = ::lv_area_get_width(&Area);
+                for (lv_coord_t y = Area.y1; y <= Area.y2; ++y)
+                {
+                    std::size_t Offset =
+                        static_cast<std::size_t>(y) * 800 + Area.x1;
+                    std::memcpy(
+                        &Destination[Offset],
+                        &Source[Offset],
+                        Width * sizeof(std::uint32_t));
+                }
+                Pixels += ::lv_area_get_size(&Area);
+            }
+            Duration += std::chrono::steady_clock::now() - Start;
+            BlitCount += Frame.size();
+        }
+
+        std::printf(
+            "%-8u %12.2f %12.0f %12.0f\n",
+            static_cast<unsigned>(BlitCost),
+            static_cast<double>(BlitCount) / FrameCount,
+            static_cast<double>(Pixels) / FrameCount,
+            Duration.count() / FrameCount);
+    }
+}
+
+/**
+ * @brief The draws of a whole 800x480 buffer with 0 to N renderer worker
+ *        threads besides the thread which runs LVGL. There are at least 3
+ *        workers, so the overhead of the pool shows on a machine with fewer
+ *        logical processors, where the extra threads only take turns.
+*/
+static void LvglWindowsDesktopBenchmarksScaling()
+{
+    g_LvglWindowsTestsDisplayDriver.antialiasing = 1;
+
+    unsigned int ProcessorCount = std::thread::hardware_concurrency();
+    std::size_t MaximumWorkerCount =
+        std::max<std::size_t>(ProcessorCount, 4) - 1;
+    std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(200);
+
+    static const struct
+    {
+        const char* Name;
+        LVGL_WINDOWS_DESKTOP_BENCHMARKS_DRAW_TYPE Type;
+    } Draws[] =
+    {
+        { "Fill", LvglWindowsDesktopBenchmarksDrawFill },
+        { "Copy", LvglWindowsDesktopBenchmarksDrawCopy },
+        { "Blend", LvglWindowsDesktopBenchmarksDrawBlend },
+    };
+
+    std::printf(
+        "800x480 draws on %u logical processors, microseconds per draw "
+        "and speedup\n",
+        ProcessorCount);
+    std::printf("%-8s", "Workers");
+    for (const auto& Draw : Draws)
+    {
+        std::printf(" %10s %7s", Draw.Name, "Speedup");
+    }
+    std::printf("\n");
+
+    double Baselines[sizeof(Draws) / sizeof(*Draws)] = { 0 };
+    for (std::size_t WorkerCount = 0;
+        WorkerCount <= MaximumWorkerCount;
+        ++WorkerCount)
+    {
+        ::LvglWindowsGdiRendererStartWorkerThreads(WorkerCount);
+
+        std::printf("%-8zu", WorkerCount);
+        for (std::size_t i = 0; i < sizeof(Draws) / sizeof(*Draws); ++i)
+        {
+            double Duration = ::LvglWindowsDesktopBenchmarksDraw(
+                Draws[i].Type,
+                RepeatCount);
+            if (!WorkerCount)
+            {
+                Baselines[i] = Duration;
+            }
+            std::printf(
+                " %10.0f %6.2fx",
+                Duration / 1000,
+                Baselines[i] / Duration);
+        }
+        std::printf("\n");
+
+        ::LvglWindowsGdiRendererStopWorkers();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static const LVGL_WINDOWS_TESTS_CASE Cases[] =
+    {
+        { "FillAreas", ::LvglWindowsDesktopBenchmarksFillAreas },
+        { "FlushAreas", ::LvglWindowsDesktopBenchmarksFlushAreas },
+        { "Scaling", ::LvglWindowsDesktopBenchmarksScaling },
+    };
+
+    return ::LvglWindowsTestsRunBenchmarks(
+        Cases,
+        sizeof(Cases) / sizeof(*Cases),
+        argc,
+        argv);
+}
@@ -0,0 +1,1084 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Desktop.Tests.cpp
+ * PURPOSE:   Implementation for the tests of the renderer and the display
+ *            driver of the LVGL ported to Windows Desktop
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Windows.Desktop.Internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    const lv_coord_t LvglWindowsDesktopTestsBufferX = 10;
+    const lv_coord_t LvglWindowsDesktopTestsBufferY = 20;
+    const lv_coord_t LvglWindowsDesktopTestsBufferWidth = 97;
+    const lv_coord_t LvglWindowsDesktopTestsBufferHeight = 53;
+
+    typedef void (*LVGL_WINDOWS_DESKTOP_TESTS_FILL_ROW)(
+        std::uint32_t* Destination,
+        std::size_t Count,
+        std::uint32_t Color);
+
+    typedef void (*LVGL_WINDOWS_DESKTOP_TESTS_BLEND_ROW)(
+        const LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS* Parameters,
+        std::uint32_t* Destination,
+        const std::uint32_t* Source,
+        const lv_opa_t* Mask,
+        std::size_t Count);
+
+    // The dispatched kernel and each kernel built for the architecture.
+
+    const LVGL_WINDOWS_DESKTOP_TESTS_FILL_ROW
+        LvglWindowsDesktopTestsFillRows[] =
+    {
+        ::LvglWindowsGdiRendererFillRow,
+        ::LvglWindowsGdiRendererFillRowScalar,
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+        ::LvglWindowsGdiRendererFillRowSse2,
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+        ::LvglWindowsGdiRendererFillRowNeon,
+#endif
+    };
+
+    const LVGL_WINDOWS_DESKTOP_TESTS_BLEND_ROW
+        LvglWindowsDesktopTestsBlendRows[] =
+    {
+        ::LvglWindowsGdiRendererBlendRow,
+#if defined(LVGL_WINDOWS_GDI_RENDERER_SSE2)
+        ::LvglWindowsGdiRendererBlendRowSse2,
+#elif defined(LVGL_WINDOWS_GDI_RENDERER_NEON)
+        ::LvglWindowsGdiRendererBlendRowNeon,
+#endif
+    };
+
+    typedef lv_color_t (*LVGL_WINDOWS_DESKTOP_TESTS_BLEND_FUNCTION)(
+        lv_color_t Foreground,
+        lv_color_t Background,
+        lv_opa_t Opacity);
+
+    // The reference blend functions below are transcribed from the blend
+    // functions of lv_draw_sw_blend.c in LVGL 8.3 for the 32-bit colors.
+
+    lv_color_t LvglWindowsDesktopTestsBlendAdditive(
+        lv_color_t Foreground,
+        lv_color_t Background,
+        lv_opa_t Opacity)
+    {
+        if (Opacity <= LV_OPA_MIN)
+        {
+            return Background;
+        }
+
+        std::uint32_t Value = Background.ch.red + Foreground.ch.red;
+        Foreground.ch.red = static_cast<std::uint8_t>(LV_MIN(Value, 255));
+        Value = Background.ch.green + Foreground.ch.green;
+        Foreground.ch.green = static_cast<std::uint8_t>(LV_MIN(Value, 255));
+        Value = Background.ch.blue + Foreground.ch.blue;
+        Foreground.ch.blue = static_cast<std::uint8_t>(LV_MIN(Value, 255));
+
+        if (Opacity == LV_OPA_COVER)
+        {
+            return Foreground;
+        }
+
+        return ::lv_color_mix(Foreground, Background, Opacity);
+    }
+
+    lv_color_t LvglWindowsDesktopTestsBlendSubtractive(
+        lv_color_t Foreground,
+        lv_color_t Background,
+        lv_opa_t Opacity)
+    {
+        if (Opacity <= LV_OPA_MIN)
+        {
+            return Background;
+        }
+
+        std::int32_t Value = Background.ch.red - Foreground.ch.red;
+        Foreground.ch.red = static_cast<std::uint8_t>(LV_MAX(Value, 0));
+        Value = Background.ch.green - Foreground.ch.green;
+        Foreground.ch.green = static_cast<std::uint8_t>(LV_MAX(Value, 0));
+        Value = Background.ch.blue - Foreground.ch.blue;
+        Foreground.ch.blue = static_cast<std::uint8_t>(LV_MAX(Value, 0));
+
+        if (Opacity == LV_OPA_COVER)
+        {
+            return Foreground;
+        }
+
+        return ::lv_color_mix(Foreground, Background, Opacity);
+    }
+
+    lv_color_t LvglWindowsDesktopTestsBlendMultiply(
+        lv_color_t Foreground,
+        lv_color_t Background,
+        lv_opa_t Opacity)
+    {
+        if (Opacity <= LV_OPA_MIN)
+        {
+            return Background;
+        }
+
+        Foreground.ch.red = static_cast<std::uint8_t>(
+            (Foreground.ch.red * Background.ch.red) >> 8);
+        Foreground.ch.green = static_cast<std::uint8_t>(
+            (Foreground.ch.green * Background.ch.green) >> 8);
+        Foreground.ch.blue = static_cast<std::uint8_t>(
+            (Foreground.ch.blue * Background.ch.blue) >> 8);
+
+        if (Opacity == LV_OPA_COVER)
+        {
+            return Foreground;
+        }
+
+        return ::lv_color_mix(Foreground, Background, Opacity);
+    }
+
+    LVGL_WINDOWS_DESKTOP_TESTS_BLEND_FUNCTION LvglWindowsDesktopTestsGetBlend(
+        lv_blend_mode_t BlendMode)
+    {
+        switch (BlendMode)
+        {
+        case LV_BLEND_MODE_ADDITIVE:
+            return ::LvglWindowsDesktopTestsBlendAdditive;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            return ::LvglWindowsDesktopTestsBlendSubtractive;
+        default:
+            return ::LvglWindowsDesktopTestsBlendMultiply;
+        }
+    }
+
+    /**
+     * @brief A transcription of lv_draw_sw_blend_basic of LVGL 8.3 for the
+     *        32-bit colors, the reference of the renderer.
+    */
+    void LvglWindowsDesktopTestsBlendBasic(
+        lv_draw_ctx_t* DrawContext,
+        const lv_draw_sw_blend_dsc_t* Description)
+    {
+        const lv_opa_t* Mask = Description->mask_buf;
+        if (Mask && Description->mask_res == LV_DRAW_MASK_RES_TRANSP)
+        {
+            return;
+        }
+        else if (Description->mask_res == LV_DRAW_MASK_RES_FULL_COVER)
+        {
+            Mask = nullptr;
+        }
+
+        lv_area_t BlendArea;
+        if (!::_lv_area_intersect(
+            &BlendArea,
+            Description->blend_area,
+            DrawContext->clip_area))
+        {
+            return;
+        }
+
+        lv_coord_t DestinationStride =
+            ::lv_area_get_width(DrawContext->buf_area);
+        lv_color_t* Destination =
+            reinterpret_cast<lv_color_t*>(DrawContext->buf);
+        Destination += DestinationStride
+            * (BlendArea.y1 - DrawContext->buf_area->y1)
+            + (BlendArea.x1 - DrawContext->buf_area->x1);
+
+        const lv_color_t* Source = Description->src_buf;
+        lv_coord_t SourceStride = 0;
+        if (Source)
+        {
+            SourceStride = ::lv_area_get_width(Description->blend_area);
+            Source += SourceStride
+                * (BlendArea.y1 - Description->blend_area->y1)
+                + (BlendArea.x1 - Description->blend_area->x1);
+        }
+
+        lv_coord_t MaskStride = 0;
+        if (Mask)
+        {
+            MaskStride = ::lv_area_get_width(Description->mask_area);
+            Mask += MaskStride
+                * (BlendArea.y1 - Description->mask_area->y1)
+                + (BlendArea.x1 - Description->mask_area->x1);
+        }
+
+        lv_coord_t Width = ::lv_area_get_width(&BlendArea);
+        lv_coord_t Height = ::lv_area_get_height(&BlendArea);
+        lv_color_t Color = Description->color;
+        lv_opa_t Opacity = Description->opa;
+
+        if (Description->blend_mode != LV_BLEND_MODE_NORMAL)
+        {
+            LVGL_WINDOWS_DESKTOP_TESTS_BLEND_FUNCTION Blend =
+                ::LvglWindowsDesktopTestsGetBlend(Description->blend_mode);
+            for (lv_coord_t y = 0; y < Height; ++y)
+            {
+                for (lv_coord_t x = 0; x < Width; ++x)
+                {
+                    if (Mask && !Mask[x])
+                    {
+                        continue;
+                    }
+                    lv_opa_t PixelOpacity = Opacity;
+                    if (Mask && Mask[x] < LV_OPA_MAX)
+                    {
+                        PixelOpacity = static_cast<lv_opa_t>(
+                            (Opacity * Mask[x]) >> 8);
+                    }
+                    Destination[x] = Blend(
+                        Source ? Source[x] : Color,
+                        Destination[x],
+                        PixelOpacity);
+                }
+                Destination += DestinationStride;
+                Source += Source ? SourceStride : 0;
+                Mask += Mask ? MaskStride : 0;
+            }
+        }
+        else if (!Source && !Mask)
+        {
+            if (Opacity >= LV_OPA_MAX)
+            {
+                for (lv_coord_t y = 0; y < Height; ++y)
+                {
+                    std::fill(Destination, Destination + Width, Color);
+                    Destination += DestinationStride;
+                }
+                return;
+            }
+
+            // The last mixed color is reused while the background repeats.
+            lv_color_t LastDestination;
+            LastDestination.full = 0xFF000000;
+            lv_color_t LastResult = ::lv_color_mix(
+                Color,
+                LastDestination,
+                Opacity);
+            for (lv_coord_t y = 0; y < Height; ++y)
+            {
+                for (lv_coord_t x = 0; x < Width; ++x)
+                {
+                    if (LastDestination.full != Destination[x].full)
+                    {
+                        LastDestination = Destination[x];
+                        LastResult = ::lv_color_mix(
+                            Color,
+                            LastDestination,
+                            Opacity);
+                    }
+                    Destination[x] = LastResult;
+                }
+                Destination += DestinationStride;
+            }
+        }
+        else if (!Source)
+        {
+            for (lv_coord_t y = 0; y < Height; ++y)
+            {
+                for (lv_coord_t x = 0; x < Width; ++x)
+                {
+                    if (!Mask[x])
+                    {
+                        continue;
+                    }
+                    if (Opacity >= LV_OPA_MAX)
+                    {
+                        Destination[x] = Mask[x] == LV_OPA_COVER
+                            ? Color
+                            : ::lv_color_mix(Color, Destination[x], Mask[x]);
+                        continue;
+                    }
+                    lv_opa_t PixelOpacity = Mask[x] == LV_OPA_COVER
+                        ? Opacity
+                        : static_cast<lv_opa_t>((Mask[x] * Opacity) >> 8);
+                    Destination[x] = PixelOpacity == LV_OPA_COVER
+                        ? Color
+                        : ::lv_color_mix(Color, Destination[x], PixelOpacity);
+                }
+                Destination += DestinationStride;
+                Mask += MaskStride;
+            }
+        }
+        else if (!Mask)
+        {
+            for (lv_coord_t y = 0; y < Height; ++y)
+            {
+                for (lv_coord_t x = 0; x < Width; ++x)
+                {
+                    Destination[x] = Opacity >= LV_OPA_MAX
+                        ? Source[x]
+                        : ::lv_color_mix(Source[x], Destination[x], Opacity);
+                }
+                Destination += DestinationStride;
+                Source += SourceStride;
+            }
+        }
+        else
+        {
+            for (lv_coord_t y = 0; y < Height; ++y)
+            {
+                for (lv_coord_t x = 0; x < Width; ++x)
+                {
+                    if (!Mask[x])
+                    {
+                        continue;
+                    }
+                    if (Opacity > LV_OPA_MAX)
+                    {
+                        Destination[x] = Mask[x] == LV_OPA_COVER
+                            ? Source[x]
+                            : ::lv_color_mix(
+                                Source[x],
+                                Destination[x],
+                                Mask[x]);
+                        continue;
+                    }
+                    lv_opa_t PixelOpacity = Mask[x] >= LV_OPA_MAX
+                        ? Opacity
+                        : static_cast<lv_opa_t>((Opacity * Mask[x]) >> 8);
+                    Destination[x] = ::lv_color_mix(
+                        Source[x],
+                        Destination[x],
+                        PixelOpacity);
+                }
+                Destination += DestinationStride;
+                Source += SourceStride;
+                Mask += MaskStride;
+            }
+        }
+    }
+
+    std::uint32_t LvglWindowsDesktopTestsRandom(
+        std::uint32_t Range)
+    {
+        return ::LvglWindowsTestsRandom() % Range;
+    }
+
+    /**
+     * @brief The opacities around the thresholds of LVGL are picked more often
+     *        than the other ones.
+    */
+    lv_opa_t LvglWindowsDesktopTestsRandomOpacity()
+    {
+        static const lv_opa_t SpecialOpacities[] =
+        {
+            0, 1, 2, 3, 127, 128, 252, 253, 254, 255
+        };
+        if (::LvglWindowsDesktopTestsRandom(3))
+        {
+            return SpecialOpacities[::LvglWindowsDesktopTestsRandom(
+                sizeof(SpecialOpacities) / sizeof(*SpecialOpacities))];
+        }
+        return static_cast<lv_opa_t>(::LvglWindowsDesktopTestsRandom(256));
+    }
+
+    /**
+     * @brief Returns a random clip area within the buffer area.
+    */
+    lv_area_t LvglWindowsDesktopTestsRandomClipArea(
+        const lv_area_t& BufferArea)
+    {
+        lv_area_t ClipArea;
+        ClipArea.x1 = static_cast<lv_coord_t>(
+            LvglWindowsDesktopTestsBufferX + ::LvglWindowsDesktopTestsRandom(
+                LvglWindowsDesktopTestsBufferWidth));
+        ClipArea.y1 = static_cast<lv_coord_t>(
+            LvglWindowsDesktopTestsBufferY + ::LvglWindowsDesktopTestsRandom(
+                LvglWindowsDesktopTestsBufferHeight));
+        ClipArea.x2 = static_cast<lv_coord_t>(
+            ClipArea.x1 + ::LvglWindowsDesktopTestsRandom(
+                LvglWindowsDesktopTestsBufferWidth));
+        ClipArea.y2 = static_cast<lv_coord_t>(
+            ClipArea.y1 + ::LvglWindowsDesktopTestsRandom(
+                LvglWindowsDesktopTestsBufferHeight));
+        ::_lv_area_intersect(&ClipArea, &ClipArea, &BufferArea);
+        return ClipArea;
+    }
+
+    /**
+     * @brief Returns a random area which may overhang the buffer area.
+    */
+    lv_area_t LvglWindowsDesktopTestsRandomBlendArea()
+    {
+        lv_area_t Area;
+        Area.x1 = static_cast<lv_coord_t>(::LvglWindowsDesktopTestsRandom(120));
+        Area.y1 = static_cast<lv_coord_t>(::LvglWindowsDesktopTestsRandom(90));
+        Area.x2 = static_cast<lv_coord_t>(
+            Area.x1 + ::LvglWindowsDesktopTestsRandom(60));
+        Area.y2 = static_cast<lv_coord_t>(
+            Area.y1 + ::LvglWindowsDesktopTestsRandom(40));
+        return Area;
+    }
+
+    void LvglWindowsDesktopTestsResetDisplayDriver()
+    {
+        std::memset(
+            &g_LvglWindowsTestsDisplayDriver,
+            0,
+            sizeof(g_LvglWindowsTestsDisplayDriver));
+        g_LvglWindowsTestsDisplayDriver.hor_res = 800;
+        g_LvglWindowsTestsDisplayDriver.ver_res = 480;
+        g_LvglWindowsTestsDisplayDriver.antialiasing = 1;
+    }
+}
+
+/**
+ * @brief The row fill kernels fill exactly the given pixels at every
+ *        alignment.
+*/
+static void LvglWindowsDesktopTestsFillRow()
+{
+    std::vector<std::uint32_t> Buffer(128 + 8);
+    for (LVGL_WINDOWS_DESKTOP_TESTS_FILL_ROW FillRow
+        : LvglWindowsDesktopTestsFillRows)
+    {
+        for (std::size_t Offset = 0; Offset < 8; ++Offset)
+        {
+            for (std::size_t Count = 0; Count <= 128; ++Count)
+            {
+                std::fill(Buffer.begin(), Buffer.end(), 0xA5A5A5A5);
+                std::uint32_t Color = ::LvglWindowsTestsRandom();
+
+                FillRow(&Buffer[Offset], Count, Color);
+
+                for (std::size_t i = 0; i < Buffer.size(); ++i)
+                {
+                    bool IsFilled = i >= Offset && i < Offset + Count;
+                    LVGL_WINDOWS_TESTS_CHECK(
+                        Buffer[i] == (IsFilled ? Color : 0xA5A5A5A5));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief The vector row blend kernels give the same pixels as the scalar
+ *        kernel for every blend mode, opacity, mask and row length.
+*/
+static void LvglWindowsDesktopTestsBlendRow()
+{
+    static const lv_blend_mode_t BlendModes[] =
+    {
+        LV_BLEND_MODE_NORMAL,
+        LV_BLEND_MODE_ADDITIVE,
+        LV_BLEND_MODE_SUBTRACTIVE,
+        LV_BLEND_MODE_MULTIPLY,
+    };
+
+    std::vector<std::uint32_t> Destination(64);
+    std::vector<std::uint32_t> Expected(64);
+    std::vector<std::uint32_t> Source(64);
+    std::vector<lv_opa_t> Mask(64);
+
+    for (std::size_t Iteration = 0; Iteration < 4096; ++Iteration)
+    {
+        LVGL_WINDOWS_GDI_RENDERER_BLEND_PARAMETERS Parameters;
+        Parameters.Color = ::LvglWindowsTestsRandom();
+        Parameters.Opacity = ::LvglWindowsDesktopTestsRandomOpacity();
+        Parameters.CoverMask = ::LvglWindowsDesktopTestsRandom(2)
+            ? LV_OPA_MAX
+            : LV_OPA_COVER;
+        Parameters.MaskOnly = ::LvglWindowsDesktopTestsRandom(2) != 0;
+        Parameters.BlendMode = BlendModes[
+            ::LvglWindowsDesktopTestsRandom(4)];
+
+        std::size_t Count = ::LvglWindowsDesktopTestsRandom(64);
+        bool HasSource = ::LvglWindowsDesktopTestsRandom(2) != 0;
+        bool HasMask = ::LvglWindowsDesktopTestsRandom(2) != 0;
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+            Expected[i] = ::LvglWindowsTestsRandom();
+            Source[i] = ::LvglWindowsTestsRandom();
+            Mask[i] = ::LvglWindowsDesktopTestsRandomOpacity();
+        }
+
+        const std::uint32_t* SourceRow = HasSource ? &Source[0] : nullptr;
+        const lv_opa_t* MaskRow = HasMask ? &Mask[0] : nullptr;
+        std::vector<std::uint32_t> Background(
+            Expected.begin(),
+            Expected.begin() + Count);
+        ::LvglWindowsGdiRendererBlendRowScalar(
+            &Parameters,
+            &Expected[0],
+            SourceRow,
+            MaskRow,
+            Count);
+
+        for (LVGL_WINDOWS_DESKTOP_TESTS_BLEND_ROW BlendRow
+            : LvglWindowsDesktopTestsBlendRows)
+        {
+            std::copy(
+                Background.begin(),
+                Background.end(),
+                Destination.begin());
+            BlendRow(&Parameters, &Destination[0], SourceRow, MaskRow, Count);
+            LVGL_WINDOWS_TESTS_CHECK(std::equal(
+                Destination.begin(),
+                Destination.begin() + Count,
+                Expected.begin()));
+        }
+    }
+}
+
+/**
+ * @brief The opaque fills cover exactly the blend area clipped to the clip
+ *        area.
+*/
+static void LvglWindowsDesktopTestsFill()
+{
+    ::LvglWindowsDesktopTestsResetDisplayDriver();
+    ::LvglWindowsGdiRendererStartWorkers();
+
+    const std::size_t PixelCount = static_cast<std::size_t>(
+        LvglWindowsDesktopTestsBufferWidth)
+        * LvglWindowsDesktopTestsBufferHeight;
+    std::vector<std::uint32_t> Buffer(PixelCount);
+    std::vector<std::uint32_t> Expected(PixelCount);
+
+    lv_area_t BufferArea =
+    {
+        LvglWindowsDesktopTestsBufferX,
+        LvglWindowsDesktopTestsBufferY,
+        LvglWindowsDesktopTestsBufferX + LvglWindowsDesktopTestsBufferWidth - 1,
+        LvglWindowsDesktopTestsBufferY + LvglWindowsDesktopTestsBufferHeight - 1
+    };
+
+    lv_draw_sw_ctx_t Context = {};
+    Context.base_draw.buf = Buffer.data();
+    Context.base_draw.buf_area = &BufferArea;
+
+    for (std::size_t Iteration = 0; Iteration < 20000; ++Iteration)
+    {
+        lv_area_t ClipArea =
+            ::LvglWindowsDesktopTestsRandomClipArea(BufferArea);
+        lv_area_t Area = ::LvglWindowsDesktopTestsRandomBlendArea();
+        Context.base_draw.clip_area = &ClipArea;
+
+        lv_draw_sw_blend_dsc_t Description = {};
+        Description.blend_area = &Area;
+        Description.color.full = ::LvglWindowsTestsRandom();
+        Description.opa = LV_OPA_COVER;
+
+        ::LvglWindowsGdiRendererBlendCallback(
+            &Context.base_draw,
+            &Description);
+        ::LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
+            &Context.base_draw);
+
+        lv_area_t Filled;
+        if (::_lv_area_intersect(&Filled, &Area, &ClipArea))
+        {
+            for (lv_coord_t y = Filled.y1; y <= Filled.y2; ++y)
+            {
+                for (lv_coord_t x = Filled.x1; x <= Filled.x2; ++x)
+                {
+                    Expected[(y - LvglWindowsDesktopTestsBufferY)
+                        * LvglWindowsDesktopTestsBufferWidth
+                        + (x - LvglWindowsDesktopTestsBufferX)] =
+                        Description.color.full;
+                }
+            }
+        }
+    }
+
+    LVGL_WINDOWS_TESTS_CHECK(Buffer == Expected);
+
+    ::LvglWindowsGdiRendererStopWorkers();
+}
+
+/**
+ * @brief The fills, copies and blends give the same pixels as the LVGL
+ *        software renderer, for all the blend modes, opacities and masks,
+ *        split into bands for the worker threads.
+*/
+static void LvglWindowsDesktopTestsBlend()
+{
+    ::LvglWindowsDesktopTestsResetDisplayDriver();
+    ::LvglWindowsGdiRendererStartWorkers();
+
+    const std::size_t PixelCount = static_cast<std::size_t>(
+        LvglWindowsDesktopTestsBufferWidth)
+        * LvglWindowsDesktopTestsBufferHeight;
+    std::vector<std::uint32_t> Buffer(PixelCount);
+    std::vector<std::uint32_t> Expected(PixelCount);
+    for (std::size_t i = 0; i < PixelCount; ++i)
+    {
+        Buffer[i] = Expected[i] = ::LvglWindowsTestsRandom();
+    }
+
+    lv_area_t BufferArea =
+    {
+        LvglWindowsDesktopTestsBufferX,
+        LvglWindowsDesktopTestsBufferY,
+        LvglWindowsDesktopTestsBufferX + LvglWindowsDesktopTestsBufferWidth - 1,
+        LvglWindowsDesktopTestsBufferY + LvglWindowsDesktopTestsBufferHeight - 1
+    };
+
+    lv_draw_sw_ctx_t Context = {};
+    Context.base_draw.buf_area = &BufferArea;
+
+    // The source images have the size of the blend areas, the masks may be
+    // larger.
+    std::vector<lv_color_t> Source(61 * 41);
+    std::vector<lv_opa_t> Mask(71 * 51);
+
+    std::size_t MismatchCount = 0;
+
+    for (std::size_t Iteration = 0; Iteration < 30000; ++Iteration)
+    {
+        lv_area_t ClipArea =
+            ::LvglWindowsDesktopTestsRandomClipArea(BufferArea);
+        lv_area_t Area = ::LvglWindowsDesktopTestsRandomBlendArea();
+        Context.base_draw.clip_area = &ClipArea;
+
+        lv_area_t MaskArea;
+        MaskArea.x1 = static_cast<lv_coord_t>(
+            Area.x1 - ::LvglWindowsDesktopTestsRandom(5));
+        MaskArea.y1 = static_cast<lv_coord_t>(
+            Area.y1 - ::LvglWindowsDesktopTestsRandom(5));
+        MaskArea.x2 = static_cast<lv_coord_t>(
+            Area.x2 + ::LvglWindowsDesktopTestsRandom(5));
+        MaskArea.y2 = static_cast<lv_coord_t>(
+            Area.y2 + ::LvglWindowsDesktopTestsRandom(5));
+
+        lv_draw_sw_blend_dsc_t Description = {};
+        Description.blend_area = &Area;
+        Description.color.full = ::LvglWindowsTestsRandom();
+        Description.opa = std::max<lv_opa_t>(
+            ::LvglWindowsDesktopTestsRandomOpacity(),
+            LV_OPA_MIN + 1);
+        Description.blend_mode = static_cast<lv_blend_mode_t>(
+            ::LvglWindowsDesktopTestsRandom(4));
+
+        if (::LvglWindowsDesktopTestsRandom(2))
+        {
+            for (lv_color_t& Color : Source)
+            {
+                Color.full = ::LvglWindowsTestsRandom();
+            }
+            Description.src_buf = Source.data();
+        }
+
+        if (::LvglWindowsDesktopTestsRandom(4))
+        {
+            bool IsTransparent = !::LvglWindowsDesktopTestsRandom(5);
+            for (lv_opa_t& Opacity : Mask)
+            {
+                Opacity = IsTransparent
+                    ? 0
+                    : ::LvglWindowsDesktopTestsRandomOpacity();
+            }
+            Description.mask_buf = Mask.data();
+            Description.mask_area = &MaskArea;
+            if (!::LvglWindowsDesktopTestsRandom(8))
+            {
+                Description.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+            }
+            else if (!::LvglWindowsDesktopTestsRandom(16))
+            {
+                Description.mask_res = LV_DRAW_MASK_RES_TRANSP;
+            }
+            else
+            {
+                Description.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            }
+        }
+
+        Context.base_draw.buf = Buffer.data();
+        ::LvglWindowsGdiRendererBlendCallback(
+            &Context.base_draw,
+            &Description);
+        ::LvglWindowsGdiRendererBaseDrawWaitForFinishCallback(
+            &Context.base_draw);
+
+        Context.base_draw.buf = Expected.data();
+        ::LvglWindowsDesktopTestsBlendBasic(&Context.base_draw, &Description);
+
+        for (std::size_t i = 0; i < PixelCount; ++i)
+        {
+            if (Buffer[i] != Expected[i])
+            {
+                if (MismatchCount++ < 4)
+                {
+                    std::fprintf(
+                        stderr,
+                        "iteration %zu pixel %zu mode %d opa %d source %d "
+                        "mask %d: %08x instead of %08x\n",
+                        Iteration,
+                        i,
+                        Description.blend_mode,
+                        Description.opa,
+                        Description.src_buf != nullptr,
+                        Description.mask_buf != nullptr,
+                        Buffer[i],
+                        Expected[i]);
+                }
+                Buffer[i] = Expected[i];
+            }
+        }
+    }
+
+    LVGL_WINDOWS_TESTS_CHECK(MismatchCount == 0);
+
+    ::LvglWindowsGdiRendererStopWorkers();
+}
+
+/**
+ * @brief The settings the renderer does not support fall back to the LVGL
+ *        software renderer.
+*/
+static void LvglWindowsDesktopTestsFallback()
+{
+    std::vector<std::uint32_t> Buffer(16 * 16);
+    lv_area_t BufferArea = { 0, 0, 15, 15 };
+    std::vector<lv_opa_t> Mask(16 * 16, 128);
+
+    lv_draw_sw_ctx_t Context = {};
+    Context.base_draw.buf = Buffer.data();
+    Context.base_draw.buf_area = &BufferArea;
+    Context.base_draw.clip_area = &BufferArea;
+
+    lv_draw_sw_blend_dsc_t Description = {};
+    Description.blend_area = &BufferArea;
+    Description.color.full = 0xFF123456;
+    Description.opa = LV_OPA_COVER;
+
+    for (int Setting = 0; Setting < 5; ++Setting)
+    {
+        ::LvglWindowsDesktopTestsResetDisplayDriver();
+        Description.mask_buf = nullptr;
+        Description.mask_area = nullptr;
+        Description.mask_res = LV_DRAW_MASK_RES_UNKNOWN;
+        Description.blend_mode = LV_BLEND_MODE_NORMAL;
+
+        switch (Setting)
+        {
+        case 0:
+            g_LvglWindowsTestsDisplayDriver.set_px_cb =
+                [](lv_disp_drv_t*, uint8_t*, lv_coord_t, lv_coord_t,
+                    lv_coord_t, lv_color_t, lv_opa_t) {};
+            break;
+        case 1:
+            g_LvglWindowsTestsDisplayDriver.screen_transp = 1;
+            break;
+        case 2:
+            g_LvglWindowsTestsDisplayDriver.antialiasing = 0;
+            Description.mask_buf = Mask.data();
+            Description.mask_area = &BufferArea;
+            Description.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            break;
+        case 3:
+            Description.blend_mode = static_cast<lv_blend_mode_t>(
+                LV_BLEND_MODE_MULTIPLY + 1);
+            break;
+        default:
+            break;
+        }
+
+        std::size_t BlendBasicCount = g_LvglWindowsTestsBlendBasicCount;
+        std::fill(Buffer.begin(), Buffer.end(), 0);
+
+        ::LvglWindowsGdiRendererBlendCallback(
+            &Context.base_draw,
+            &Description);
+
+        bool IsFallback = Setting != 4;
+        LVGL_WINDOWS_TESTS_CHECK(
+            g_LvglWindowsTestsBlendBasicCount - BlendBasicCount
+            == (IsFallback ? 1U : 0U));
+        LVGL_WINDOWS_TESTS_CHECK(
+            (Buffer[0] == Description.color.full) == !IsFallback);
+    }
+}
+
+/**
+ * @brief The flushed areas of a frame are merged when a bounding box is
+ *        cheaper to present, and every flushed pixel is presented.
+*/
+static void LvglWindowsDesktopTestsFlush()
+{
+    ::LvglWindowsDesktopTestsResetDisplayDriver();
+
+    for (std::size_t Iteration = 0; Iteration < 5000; ++Iteration)
+    {
+        std::size_t AreaCount = 1 + ::LvglWindowsDesktopTestsRandom(12);
+        std::vector<lv_area_t> Areas;
+        for (std::size_t i = 0; i < AreaCount; ++i)
+        {
+            lv_area_t Area;
+            Area.x1 = static_cast<lv_coord_t>(
+                ::LvglWindowsDesktopTestsRandom(800));
+            Area.y1 = static_cast<lv_coord_t>(
+                ::LvglWindowsDesktopTestsRandom(480));
+            Area.x2 = static_cast<lv_coord_t>(std::min<std::uint32_t>(
+                799,
+                Area.x1 + ::LvglWindowsDesktopTestsRandom(200)));
+            Area.y2 = static_cast<lv_coord_t>(std::min<std::uint32_t>(
+                479,
+                Area.y1 + ::LvglWindowsDesktopTestsRandom(100)));
+            Areas.push_back(Area);
+        }
+
+        g_LvglWindowsTestsBitBlts.clear();
+        std::size_t FlushReadyCount = g_LvglWindowsTestsFlushReadyCount;
+        for (std::size_t i = 0; i < AreaCount; ++i)
+        {
+            g_LvglWindowsTestsIsLastFlush = i == AreaCount - 1;
+            ::LvglDisplayDriverFlushCallback(
+                &g_LvglWindowsTestsDisplayDriver,
+                &Areas[i],
+                nullptr);
+        }
+        LVGL_WINDOWS_TESTS_CHECK(
+            g_LvglWindowsTestsFlushReadyCount - FlushReadyCount
+            == AreaCount);
+
+        LVGL_DISPLAY_FLUSH_STATISTICS Statistics;
+        ::LvglDisplayDriverGetFlushStatistics(&Statistics);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.AreaCount == AreaCount);
+        LVGL_WINDOWS_TESTS_CHECK(
+            Statistics.BlitCount == g_LvglWindowsTestsBitBlts.size());
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.BlitCount <= AreaCount);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.WindowPixels == 800 * 480);
+
+        for (const lv_area_t& Area : Areas)
+        {
+            bool IsPresented = false;
+            for (const RECT& Blit : g_LvglWindowsTestsBitBlts)
+            {
+                if (Area.x1 >= Blit.left &&
+                    Area.y1 >= Blit.top &&
+                    Area.x2 < Blit.right &&
+                    Area.y2 < Blit.bottom)
+                {
+                    IsPresented = true;
+                    break;
+                }
+            }
+            LVGL_WINDOWS_TESTS_CHECK(IsPresented);
+        }
+
+        // No two of the presented areas are cheaper to present together.
+        for (std::size_t i = 0; i < g_LvglWindowsTestsBitBlts.size(); ++i)
+        {
+            for (std::size_t j = i + 1;
+                j < g_LvglWindowsTestsBitBlts.size();
+                ++j)
+            {
+                lv_area_t Pair[2];
+                const RECT* Blits[2] =
+                {
+                    &g_LvglWindowsTestsBitBlts[i],
+                    &g_LvglWindowsTestsBitBlts[j]
+                };
+                for (std::size_t k = 0; k < 2; ++k)
+                {
+                    Pair[k].x1 = static_cast<lv_coord_t>(Blits[k]->left);
+                    Pair[k].y1 = static_cast<lv_coord_t>(Blits[k]->top);
+                    Pair[k].x2 = static_cast<lv_coord_t>(
+                        Blits[k]->right - 1);
+                    Pair[k].y2 = static_cast<lv_coord_t>(
+                        Blits[k]->bottom - 1);
+                }
+                LVGL_WINDOWS_TESTS_CHECK(
+                    ::LvglDisplayDriverMergeFlushAreas(
+                        Pair,
+                        2,
+                        LVGL_DISPLAY_FLUSH_BLIT_COST) == 2);
+            }
+        }
+    }
+
+    // Adjacent strips are presented together.
+    lv_area_t FirstArea = { 0, 0, 99, 9 };
+    lv_area_t SecondArea = { 0, 10, 99, 19 };
+    g_LvglWindowsTestsBitBlts.clear();
+    g_LvglWindowsTestsIsLastFlush = false;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &FirstArea,
+        nullptr);
+    g_LvglWindowsTestsIsLastFlush = true;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &SecondArea,
+        nullptr);
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsBitBlts.size() == 1);
+
+    // Distant small areas are not.
+    FirstArea = { 0, 0, 9, 9 };
+    SecondArea = { 700, 400, 709, 409 };
+    g_LvglWindowsTestsBitBlts.clear();
+    g_LvglWindowsTestsIsLastFlush = false;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &FirstArea,
+        nullptr);
+    g_LvglWindowsTestsIsLastFlush = true;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &SecondArea,
+        nullptr);
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsBitBlts.size() == 2);
+}
+
+/**
+ * @brief An invalidated area taller than the draw buffer is flushed in
+ *        strips, which are presented as one area.
+*/
+static void LvglWindowsDesktopTestsFlushStrips()
+{
+    ::LvglWindowsDesktopTestsResetDisplayDriver();
+
+    g_LvglWindowsTestsBitBlts.clear();
+    for (lv_coord_t y = 0; y < 480; y += 10)
+    {
+        lv_area_t Strip = { 100, y, 699, static_cast<lv_coord_t>(y + 9) };
+        g_LvglWindowsTestsIsLastFlush = false;
+        ::LvglDisplayDriverFlushCallback(
+            &g_LvglWindowsTestsDisplayDriver,
+            &Strip,
+            nullptr);
+    }
+    lv_area_t Label = { 0, 0, 9, 9 };
+    g_LvglWindowsTestsIsLastFlush = true;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &Label,
+        nullptr);
+
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsBitBlts.size() == 2);
+    LVGL_DISPLAY_FLUSH_STATISTICS Statistics;
+    ::LvglDisplayDriverGetFlushStatistics(&Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.AreaCount == 49);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.BlitCount == 2);
+    LVGL_WINDOWS_TESTS_CHECK(
+        Statistics.PresentedPixels == 600 * 480 + 10 * 10);
+}
+
+/**
+ * @brief In the direct mode LVGL flushes the whole frame buffer for every
+ *        invalidated area, the invalidated areas which are not joined into
+ *        others are presented instead.
+*/
+static void LvglWindowsDesktopTestsDirectFlush()
+{
+    ::LvglWindowsDesktopTestsResetDisplayDriver();
+    g_LvglWindowsTestsDisplayDriver.direct_mode = 1;
+
+    lv_area_t ScreenArea = { 0, 0, 799, 479 };
+
+    for (std::size_t Iteration = 0; Iteration < 2000; ++Iteration)
+    {
+        std::size_t AreaCount = 1 + ::LvglWindowsDesktopTestsRandom(
+            LV_INV_BUF_SIZE);
+        std::size_t DrawnCount = 0;
+        g_LvglWindowsTestsDisplay.inv_p = static_cast<std::uint16_t>(
+            AreaCount);
+        for (std::size_t i = 0; i < AreaCount; ++i)
+        {
+            lv_area_t& Area = g_LvglWindowsTestsDisplay.inv_areas[i];
+            Area.x1 = static_cast<lv_coord_t>(
+                ::LvglWindowsDesktopTestsRandom(800));
+            Area.y1 = static_cast<lv_coord_t>(
+                ::LvglWindowsDesktopTestsRandom(480));
+            Area.x2 = static_cast<lv_coord_t>(std::min<std::uint32_t>(
+                799,
+                Area.x1 + ::LvglWindowsDesktopTestsRandom(100)));
+            Area.y2 = static_cast<lv_coord_t>(std::min<std::uint32_t>(
+                479,
+                Area.y1 + ::LvglWindowsDesktopTestsRandom(50)));
+
+            bool IsJoined = i && !::LvglWindowsDesktopTestsRandom(3);
+            g_LvglWindowsTestsDisplay.inv_area_joined[i] = IsJoined;
+            DrawnCount += IsJoined ? 0 : 1;
+        }
+
+        g_LvglWindowsTestsBitBlts.clear();
+        for (std::size_t i = 0; i < DrawnCount; ++i)
+        {
+            g_LvglWindowsTestsIsLastFlush = i == DrawnCount - 1;
+            ::LvglDisplayDriverFlushCallback(
+                &g_LvglWindowsTestsDisplayDriver,
+                &ScreenArea,
+                nullptr);
+        }
+
+        LVGL_DISPLAY_FLUSH_STATISTICS Statistics;
+        ::LvglDisplayDriverGetFlushStatistics(&Statistics);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.AreaCount == DrawnCount);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.BlitCount <= DrawnCount);
+
+        for (std::size_t i = 0; i < AreaCount; ++i)
+        {
+            if (g_LvglWindowsTestsDisplay.inv_area_joined[i])
+            {
+                continue;
+            }
+
+            const lv_area_t& Area = g_LvglWindowsTestsDisplay.inv_areas[i];
+            bool IsPresented = false;
+            for (const RECT& Blit : g_LvglWindowsTestsBitBlts)
+            {
+                if (Area.x1 >= Blit.left &&
+                    Area.y1 >= Blit.top &&
+                    Area.x2 < Blit.right &&
+                    Area.y2 < Blit.bottom)
+                {
+                    IsPresented = true;
+                    break;
+                }
+            }
+            LVGL_WINDOWS_TESTS_CHECK(IsPresented);
+        }
+    }
+
+    // A single small area is presented alone, not the whole frame buffer.
+    g_LvglWindowsTestsDisplay.inv_p = 1;
+    g_LvglWindowsTestsDisplay.inv_areas[0] = { 10, 20, 49, 39 };
+    g_LvglWindowsTestsDisplay.inv_area_joined[0] = 0;
+    g_LvglWindowsTestsBitBlts.clear();
+    g_LvglWindowsTestsIsLastFlush = true;
+    ::LvglDisplayDriverFlushCallback(
+        &g_LvglWindowsTestsDisplayDriver,
+        &ScreenArea,
+        nullptr);
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsBitBlts.size() == 1);
+    LVGL_DISPLAY_FLUSH_STATISTICS Statistics;
+    ::LvglDisplayDriverGetFlushStatistics(&Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.PresentedPixels == 40 * 20);
+
+    g_LvglWindowsTestsDisplay.inv_p = 0;
+}
+
+int main(int argc, char** argv)
+{
+    static const LVGL_WINDOWS_TESTS_CASE Cases[] =
+    {
+        { "FillRow", ::LvglWindowsDesktopTestsFillRow },
+        { "BlendRow", ::LvglWindowsDesktopTestsBlendRow },
+        { "Fill", ::LvglWindowsDesktopTestsFill },
+        { "Blend", ::LvglWindowsDesktopTestsBlend },
+        { "Fallback", ::LvglWindowsDesktopTestsFallback },
+        { "Flush", ::LvglWindowsDesktopTestsFlush },
+        { "FlushStrips", ::LvglWindowsDesktopTestsFlushStrips },
+        { "DirectFlush", ::LvglWindowsDesktopTestsDirectFlush },
+    };
+
+    return ::LvglWindowsTestsRun(
+        Cases,
+        sizeof(Cases) / sizeof(*Cases),
+        argc,
+        argv);
+}
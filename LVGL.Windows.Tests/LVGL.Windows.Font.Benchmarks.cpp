@@ -0,0 +1,1122 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Font.Benchmarks.cpp
+ * PURPOSE:   Implementation for the benchmarks of the Windows GDI font engine
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Windows.Font.Internal.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace
+{
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+    // The text font has no CJK glyphs, the scripts after Latin-1 have about
+    // as many glyphs as a CJK text uses.
+    const std::uint32_t LvglWindowsFontBenchmarksScriptCodePoint = 0x100;
+    const char LvglWindowsFontBenchmarksScriptName[] = "Other scripts";
+
+    /**
+     * @brief Returns the text font given by the build.
+    */
+    const std::vector<std::uint8_t>& LvglWindowsFontBenchmarksGetFontData()
+    {
+        static const std::vector<std::uint8_t> Content = []()
+        {
+            std::vector<std::uint8_t> Content;
+            std::FILE* File = std::fopen(LVGL_WINDOWS_TESTS_FONT_FILE, "rb");
+            LVGL_WINDOWS_TESTS_CHECK(File);
+            if (File)
+            {
+                std::uint8_t Buffer[4096];
+                std::size_t ReadSize = 0;
+                while ((ReadSize = std::fread(Buffer, 1, sizeof(Buffer), File)))
+                {
+                    Content.insert(Content.end(), Buffer, Buffer + ReadSize);
+                }
+                std::fclose(File);
+            }
+            return Content;
+        }();
+        return Content;
+    }
+
+    /**
+     * @brief Creates a font of the size used by the LVGL demos from the text
+     *        font with the FreeType backend, the other parameters are given
+     *        by the benchmark.
+    */
+    void LvglWindowsFontBenchmarksCreateFont(
+        lv_font_t* FontObject,
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS* Parameters)
+    {
+        const std::vector<std::uint8_t>& FontData =
+            ::LvglWindowsFontBenchmarksGetFontData();
+        Parameters->FontSize = 16;
+        Parameters->Backend = LvglWindowsGdiFontBackendFreeType;
+        Parameters->FontData = FontData.data();
+        Parameters->FontDataSize = FontData.size();
+        LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+            FontObject,
+            Parameters));
+    }
+
+    /**
+     * @brief Returns whether the text font has a glyph for the code point.
+    */
+    bool LvglWindowsFontBenchmarksHasGlyph(
+        std::uint32_t CodePoint)
+    {
+        static FT_Face Face = []()
+        {
+            const std::vector<std::uint8_t>& FontData =
+                ::LvglWindowsFontBenchmarksGetFontData();
+            FT_Library Library = nullptr;
+            FT_Face Face = nullptr;
+            LVGL_WINDOWS_TESTS_CHECK(!::FT_Init_FreeType(&Library));
+            LVGL_WINDOWS_TESTS_CHECK(!::FT_New_Memory_Face(
+                Library,
+                FontData.data(),
+                static_cast<FT_Long>(FontData.size()),
+                0,
+                &Face));
+            return Face;
+        }();
+        return Face && ::FT_Get_Char_Index(Face, CodePoint);
+    }
+#else
+    const std::uint32_t LvglWindowsFontBenchmarksScriptCodePoint = 0x4E00;
+    const char LvglWindowsFontBenchmarksScriptName[] = "CJK";
+
+    const wchar_t LvglWindowsFontBenchmarksFontName[] = L"Segoe UI";
+
+    /**
+     * @brief Creates a font of the size used by the LVGL demos, the other
+     *        parameters are given by the benchmark.
+    */
+    void LvglWindowsFontBenchmarksCreateFont(
+        lv_font_t* FontObject,
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS* Parameters)
+    {
+        Parameters->FontSize = 16;
+        Parameters->FontName = LvglWindowsFontBenchmarksFontName;
+        LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+            FontObject,
+            Parameters));
+    }
+
+    bool LvglWindowsFontBenchmarksHasGlyph(
+        std::uint32_t CodePoint)
+    {
+        return ::LvglWindowsTestsHasGlyph(CodePoint);
+    }
+#endif
+
+    /**
+     * @brief Returns the code points of the glyphs the main font has, from
+     *        the first one on, fewer when the font has no more.
+    */
+    std::vector<std::uint32_t> LvglWindowsFontBenchmarksGetCodePoints(
+        std::uint32_t FirstCodePoint,
+        std::size_t Count)
+    {
+        std::vector<std::uint32_t> CodePoints;
+        for (std::uint32_t CodePoint = FirstCodePoint;
+            CodePoints.size() < Count && CodePoint < 0x10000;
+            ++CodePoint)
+        {
+            if (::LvglWindowsFontBenchmarksHasGlyph(CodePoint))
+            {
+                CodePoints.push_back(CodePoint);
+            }
+        }
+        return CodePoints;
+    }
+
+    /**
+     * @brief Returns the code points in a random order, each one several
+     *        times, so the lookups are not served by the last resolved glyph
+     *        and the order does not favor any structure.
+    */
+    std::vector<std::uint32_t> LvglWindowsFontBenchmarksShuffle(
+        const std::vector<std::uint32_t>& CodePoints,
+        std::size_t Count)
+    {
+        std::vector<std::uint32_t> Sequence(Count);
+        for (std::uint32_t& CodePoint : Sequence)
+        {
+            CodePoint = CodePoints[
+                ::LvglWindowsTestsRandom() % CodePoints.size()];
+        }
+        return Sequence;
+    }
+
+    /**
+     * @brief Measures and draws each letter of a text like LVGL does.
+    */
+    void LvglWindowsFontBenchmarksDrawText(
+        const lv_font_t* FontObject,
+        const std::vector<std::uint32_t>& CodePoints)
+    {
+        lv_font_glyph_dsc_t Description;
+        for (std::uint32_t CodePoint : CodePoints)
+        {
+            if (FontObject->get_glyph_dsc(
+                FontObject,
+                &Description,
+                CodePoint,
+                0))
+            {
+                FontObject->get_glyph_bitmap(FontObject, CodePoint);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the UTF-8 text of the code points.
+    */
+    std::string LvglWindowsFontBenchmarksEncode(
+        const std::vector<std::uint32_t>& CodePoints)
+    {
+        std::string Text;
+        for (std::uint32_t CodePoint : CodePoints)
+        {
+            if (CodePoint < 0x80)
+            {
+                Text += static_cast<char>(CodePoint);
+            }
+            else if (CodePoint < 0x800)
+            {
+                Text += static_cast<char>(0xC0 | (CodePoint >> 6));
+                Text += static_cast<char>(0x80 | (CodePoint & 0x3F));
+            }
+            else
+            {
+                Text += static_cast<char>(0xE0 | (CodePoint >> 12));
+                Text += static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+                Text += static_cast<char>(0x80 | (CodePoint & 0x3F));
+            }
+        }
+        return Text;
+    }
+
+    /**
+     * @brief Returns the 8-bit opacity of a pixel of a glyph bitmap, expanded
+     *        from the lower bits per pixel like LVGL blends it.
+    */
+    std::uint32_t LvglWindowsFontBenchmarksGetOpacity(
+        const std::uint8_t* Bitmap,
+        std::size_t PixelIndex,
+        std::uint8_t Bpp)
+    {
+        std::size_t BitIndex = PixelIndex * Bpp;
+        std::uint32_t Value = Bitmap[BitIndex / 8] >> (8 - Bpp - BitIndex % 8);
+        Value &= (1U << Bpp) - 1;
+        return Value * 255 / ((1U << Bpp) - 1);
+    }
+
+    /**
+     * @brief Returns the count of glyphs the font rasterized, with either
+     *        backend.
+    */
+    std::size_t LvglWindowsFontBenchmarksGetMisses(
+        const lv_font_t* FontObject)
+    {
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        ::LvglWindowsGdiFontGetStatistics(FontObject, &Statistics);
+        return Statistics.CacheMisses;
+    }
+
+    double LvglWindowsFontBenchmarksElapsed(
+        std::chrono::steady_clock::time_point Start)
+    {
+        std::chrono::duration<double, std::nano> Duration =
+            std::chrono::steady_clock::now() - Start;
+        return Duration.count();
+    }
+}
+
+/**
+ * @brief The lookups of cached glyphs through the glyph index of the engine,
+ *        and through a std::map of the same glyphs like the engine used to
+ *        keep them.
+*/
+static void LvglWindowsFontBenchmarksGlyphIndex()
+{
+    static const struct
+    {
+        const char* Name;
+        std::uint32_t FirstCodePoint;
+        std::size_t GlyphCount;
+    } Sets[] =
+    {
+        { "ASCII", 0x20, 95 },
+        { "Latin-1", 0x20, 190 },
+        {
+            LvglWindowsFontBenchmarksScriptName,
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            500
+        },
+        {
+            LvglWindowsFontBenchmarksScriptName,
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            5000
+        },
+    };
+
+    const std::size_t LookupCount = 4096;
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(200);
+
+    std::printf("Lookup of a cached glyph, nanoseconds per lookup\n");
+    std::printf("%-30s %12s %12s\n", "Glyphs", "Index", "std::map");
+    for (const auto& Set : Sets)
+    {
+        std::vector<std::uint32_t> CodePoints =
+            ::LvglWindowsFontBenchmarksGetCodePoints(
+                Set.FirstCodePoint,
+                Set.GlyphCount);
+        std::vector<std::uint32_t> Sequence =
+            ::LvglWindowsFontBenchmarksShuffle(CodePoints, LookupCount);
+
+        lv_font_t FontObject;
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+
+        std::map<std::uint32_t, lv_font_glyph_dsc_t> Map;
+        for (std::uint32_t CodePoint : CodePoints)
+        {
+            FontObject.get_glyph_dsc(
+                &FontObject,
+                &Map[CodePoint],
+                CodePoint,
+                0);
+        }
+
+        lv_font_glyph_dsc_t Description;
+        std::uint32_t Checksum = 0;
+
+        auto Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            for (std::uint32_t CodePoint : Sequence)
+            {
+                FontObject.get_glyph_dsc(
+                    &FontObject,
+                    &Description,
+                    CodePoint,
+                    0);
+                Checksum += Description.adv_w;
+            }
+        }
+        double Index = ::LvglWindowsFontBenchmarksElapsed(Start);
+
+        Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            for (std::uint32_t CodePoint : Sequence)
+            {
+                auto Iterator = Map.find(CodePoint);
+                if (Iterator != Map.end())
+                {
+                    Description = Iterator->second;
+                }
+                Checksum -= Description.adv_w;
+            }
+        }
+        double MapLookup = ::LvglWindowsFontBenchmarksElapsed(Start);
+
+        // Both found the same glyphs.
+        LVGL_WINDOWS_TESTS_CHECK(Checksum == 0);
+
+        char Name[64];
+        std::snprintf(
+            Name,
+            sizeof(Name),
+            "%s, %zu glyphs",
+            Set.Name,
+            CodePoints.size());
+        std::printf(
+            "%-30s %12.1f %12.1f\n",
+            Name,
+            Index / (RepeatCount * LookupCount),
+            MapLookup / (RepeatCount * LookupCount));
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+}
+
+/**
+ * @brief A window with text moved back and forth between two monitors. The
+ *        first visit of each DPI value rasterizes the glyphs, which is what
+ *        every move cost when the engine kept one cache for all DPI values.
+*/
+static void LvglWindowsFontBenchmarksDpiSwitch()
+{
+    std::vector<std::uint32_t> Text =
+        ::LvglWindowsFontBenchmarksGetCodePoints(0x20, 95);
+    std::vector<std::uint32_t> Symbols =
+        ::LvglWindowsFontBenchmarksGetCodePoints(
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            200);
+    Text.insert(Text.end(), Symbols.begin(), Symbols.end());
+
+    const std::size_t SwitchCount = ::LvglWindowsTestsRepeatCount(1000);
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+    ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+    ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+
+    std::size_t MissCount =
+        ::LvglWindowsFontBenchmarksGetMisses(&FontObject);
+    auto Start = std::chrono::steady_clock::now();
+    ::LvglWindowsGdiFontNotifyDpiChanged(3 * USER_DEFAULT_SCREEN_DPI / 2);
+    ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+    double FirstVisit = ::LvglWindowsFontBenchmarksElapsed(Start);
+    std::size_t FirstVisitMisses =
+        ::LvglWindowsFontBenchmarksGetMisses(&FontObject) - MissCount;
+
+    MissCount = ::LvglWindowsFontBenchmarksGetMisses(&FontObject);
+    Start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < SwitchCount; ++i)
+    {
+        ::LvglWindowsGdiFontNotifyDpiChanged(i % 2
+            ? 3 * USER_DEFAULT_SCREEN_DPI / 2
+            : USER_DEFAULT_SCREEN_DPI);
+        ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+    }
+    double Return = ::LvglWindowsFontBenchmarksElapsed(Start) / SwitchCount;
+    double ReturnMisses = static_cast<double>(
+        ::LvglWindowsFontBenchmarksGetMisses(&FontObject) - MissCount)
+        / SwitchCount;
+
+    std::printf(
+        "Move of a window with %zu glyphs to a monitor with another DPI "
+        "value\n",
+        Text.size());
+    std::printf("%-30s %12s %12s\n", "DPI value", "Nanoseconds", "Misses");
+    std::printf(
+        "%-30s %12.0f %12zu\n",
+        "First visit",
+        FirstVisit,
+        FirstVisitMisses);
+    std::printf(
+        "%-30s %12.0f %12.1f\n",
+        "Cached",
+        Return,
+        ReturnMisses);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief The first frame of a new screen of text, with a cold cache and after
+ *        the text was prewarmed on another thread while the previous screen
+ *        was shown.
+*/
+static void LvglWindowsFontBenchmarksFirstFrame()
+{
+    std::vector<std::uint32_t> Text =
+        ::LvglWindowsFontBenchmarksGetCodePoints(0x20, 95);
+    std::vector<std::uint32_t> Symbols =
+        ::LvglWindowsFontBenchmarksGetCodePoints(
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            400);
+    Text.insert(Text.end(), Symbols.begin(), Symbols.end());
+    std::string Utf8Text = ::LvglWindowsFontBenchmarksEncode(Text);
+
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(50);
+
+    double ColdFrame = 0;
+    double WarmFrame = 0;
+    double Prewarm = 0;
+    std::size_t ColdMisses = 0;
+    std::size_t WarmMisses = 0;
+    for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+    {
+        lv_font_t FontObject;
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+        auto Start = std::chrono::steady_clock::now();
+        ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+        ColdFrame += ::LvglWindowsFontBenchmarksElapsed(Start);
+        ColdMisses += ::LvglWindowsFontBenchmarksGetMisses(&FontObject);
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+        Start = std::chrono::steady_clock::now();
+        std::thread PrewarmThread([&]()
+        {
+            ::LvglWindowsGdiFontPrewarm(&FontObject, Utf8Text.c_str());
+        });
+        PrewarmThread.join();
+        Prewarm += ::LvglWindowsFontBenchmarksElapsed(Start);
+        std::size_t MissCount =
+            ::LvglWindowsFontBenchmarksGetMisses(&FontObject);
+        Start = std::chrono::steady_clock::now();
+        ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+        WarmFrame += ::LvglWindowsFontBenchmarksElapsed(Start);
+        WarmMisses +=
+            ::LvglWindowsFontBenchmarksGetMisses(&FontObject) - MissCount;
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+
+    std::printf(
+        "First frame of a screen with %zu glyphs, nanoseconds\n",
+        Text.size());
+    std::printf(
+        "%-30s %12s %12s %12s\n",
+        "Cache",
+        "Frame",
+        "Misses",
+        "Prewarm");
+    std::printf(
+        "%-30s %12.0f %12zu %12s\n",
+        "Cold",
+        ColdFrame / RepeatCount,
+        ColdMisses / RepeatCount,
+        "-");
+    std::printf(
+        "%-30s %12.0f %12zu %12.0f\n",
+        "Prewarmed",
+        WarmFrame / RepeatCount,
+        WarmMisses / RepeatCount,
+        Prewarm / RepeatCount);
+}
+
+/**
+ * @brief The glyphs which are not cached yet, in the main font and in the
+ *        built-in symbol font, with the GDI calls each one needs with the
+ *        GDI backend.
+*/
+static void LvglWindowsFontBenchmarksGlyphMiss()
+{
+    std::vector<std::uint32_t> Symbols;
+    {
+        lv_font_t FontObject;
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+        lv_font_glyph_dsc_t Description;
+        for (std::uint32_t CodePoint = 0xF000; CodePoint <= 0xF8FF; ++CodePoint)
+        {
+            if (!::LvglWindowsFontBenchmarksHasGlyph(CodePoint)
+                && FontObject.get_glyph_dsc(
+                    &FontObject,
+                    &Description,
+                    CodePoint,
+                    0))
+            {
+                Symbols.push_back(CodePoint);
+            }
+        }
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+
+    const struct
+    {
+        const char* Name;
+        std::vector<std::uint32_t> Text;
+    } Fonts[] =
+    {
+        {
+            "Main font",
+            ::LvglWindowsFontBenchmarksGetCodePoints(
+                LvglWindowsFontBenchmarksScriptCodePoint,
+                20000)
+        },
+        { "Symbol font", Symbols },
+    };
+
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(20);
+
+    std::printf("Miss of a glyph, per glyph\n");
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+    std::printf("%-30s %12s %12s\n", "Font", "Glyphs", "Nanoseconds");
+#else
+    std::printf(
+        "%-30s %12s %12s %12s %12s\n",
+        "Font",
+        "Glyphs",
+        "Nanoseconds",
+        "GetDC",
+        "SelectObject");
+#endif
+    for (const auto& Font : Fonts)
+    {
+        double Duration = 0;
+        std::size_t GetDCCount = 0;
+        std::size_t SelectObjectCount = 0;
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            lv_font_t FontObject;
+            LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+            ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+
+            GetDCCount -= g_LvglWindowsTestsGetDCCount;
+            SelectObjectCount -= g_LvglWindowsTestsSelectObjectCount;
+            auto Start = std::chrono::steady_clock::now();
+            ::LvglWindowsFontBenchmarksDrawText(&FontObject, Font.Text);
+            Duration += ::LvglWindowsFontBenchmarksElapsed(Start);
+            GetDCCount += g_LvglWindowsTestsGetDCCount;
+            SelectObjectCount += g_LvglWindowsTestsSelectObjectCount;
+
+            ::LvglWindowsGdiFontDestroyFont(&FontObject);
+        }
+
+        double MissCount = static_cast<double>(
+            RepeatCount * Font.Text.size());
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+        std::printf(
+            "%-30s %12zu %12.0f\n",
+            Font.Name,
+            Font.Text.size(),
+            Duration / MissCount);
+#else
+        std::printf(
+            "%-30s %12zu %12.0f %12.2f %12.2f\n",
+            Font.Name,
+            Font.Text.size(),
+            Duration / MissCount,
+            GetDCCount / MissCount,
+            SelectObjectCount / MissCount);
+#endif
+    }
+}
+
+#if !defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+
+// The conversion, the DWORD padding and the kerning are only done for GDI,
+// the FreeType backend has no kerning.
+
+/**
+ * @brief The conversion of the GDI coverage of glyphs of the usual sizes to
+ *        8-bpp alpha, by each kernel and through the dispatcher the engine
+ *        calls.
+*/
+static void LvglWindowsFontBenchmarksConvertCoverage()
+{
+    static const struct
+    {
+        const char* Name;
+        void (*Function)(std::uint8_t*, std::size_t);
+    } Kernels[] =
+    {
+        { "Scalar", ::LvglWindowsGdiFontConvertCoverageScalar },
+#if defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+        { "SSE2", ::LvglWindowsGdiFontConvertCoverageSse2 },
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+        { "NEON", ::LvglWindowsGdiFontConvertCoverageNeon },
+#endif
+        { "Dispatched", ::LvglWindowsGdiFontConvertCoverage },
+    };
+
+    static const struct
+    {
+        const char* Name;
+        std::size_t Width;
+        std::size_t Height;
+    } Sizes[] =
+    {
+        { "12 px letter", 6, 9 },
+        { "16 px letter", 9, 12 },
+        { "16 px CJK", 15, 15 },
+        { "32 px CJK", 30, 31 },
+        { "96 px CJK", 90, 92 },
+    };
+
+    const std::size_t GlyphCount = 4096;
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(20);
+
+    std::printf("Conversion of the coverage, nanoseconds per glyph\n");
+    std::printf("%-30s", "Glyph");
+    for (const auto& Kernel : Kernels)
+    {
+        std::printf(" %12s", Kernel.Name);
+    }
+    std::printf("\n");
+    for (const auto& Size : Sizes)
+    {
+        // The rows of GDI are padded to 4 bytes and converted as one run.
+        // The engine converts each glyph right after GDI wrote it, so the
+        // same buffer is converted again and again while it is in the cache,
+        // none of the kernels depends on the values.
+        std::size_t Length = ((Size.Width + 3) & ~std::size_t(3))
+            * Size.Height;
+        std::vector<std::uint8_t> Buffer(Length);
+        for (std::uint8_t& Level : Buffer)
+        {
+            Level = static_cast<std::uint8_t>(
+                ::LvglWindowsTestsRandom() % 65);
+        }
+
+        std::printf("%-30s", Size.Name);
+        for (const auto& Kernel : Kernels)
+        {
+            auto Start = std::chrono::steady_clock::now();
+            for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+            {
+                for (std::size_t i = 0; i < GlyphCount; ++i)
+                {
+                    Kernel.Function(Buffer.data(), Length);
+                }
+            }
+            double Duration = ::LvglWindowsFontBenchmarksElapsed(Start);
+            std::printf(" %12.1f", Duration / (RepeatCount * GlyphCount));
+        }
+        std::printf("\n");
+    }
+}
+
+/**
+ * @brief The pixels LVGL blends for a screen of text and the size of its
+ *        glyph bitmaps, with the packed rows the engine stores and with the
+ *        rows padded to 4 bytes like GDI returns them.
+*/
+static void LvglWindowsFontBenchmarksBlendPixels()
+{
+    static const char LatinText[] =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+        "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+        "ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+        "aliquip ex ea commodo consequat. 0123456789 ABCDEFGHIJKLMNOPQRSTUVW";
+
+    std::vector<std::uint32_t> Latin(
+        LatinText,
+        LatinText + sizeof(LatinText) - 1);
+
+    const struct
+    {
+        const char* Name;
+        std::vector<std::uint32_t> Text;
+    } Texts[] =
+    {
+        { "Latin text", Latin },
+        {
+            "CJK text",
+            ::LvglWindowsFontBenchmarksGetCodePoints(0x4E00, 500)
+        },
+    };
+
+    std::printf("Blended pixels and bitmap bytes of a screen of text\n");
+    std::printf(
+        "%-30s %12s %12s %12s %12s\n",
+        "Text",
+        "Pixels",
+        "Padded",
+        "Bytes",
+        "Padded");
+    for (const auto& Text : Texts)
+    {
+        lv_font_t FontObject;
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+
+        std::size_t PackedPixels = 0;
+        std::size_t PaddedPixels = 0;
+        std::map<std::uint32_t, std::size_t> PaddedBytes;
+        lv_font_glyph_dsc_t Description;
+        for (std::uint32_t CodePoint : Text.Text)
+        {
+            if (!FontObject.get_glyph_dsc(
+                &FontObject,
+                &Description,
+                CodePoint,
+                0))
+            {
+                continue;
+            }
+            std::size_t PaddedWidth = (Description.box_w + 3) & ~3;
+            PackedPixels += Description.box_w * Description.box_h;
+            PaddedPixels += PaddedWidth * Description.box_h;
+            PaddedBytes[CodePoint] = PaddedWidth * Description.box_h;
+        }
+
+        std::size_t PaddedBitmapSize = 0;
+        for (const auto& Bytes : PaddedBytes)
+        {
+            PaddedBitmapSize += Bytes.second;
+        }
+
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+        std::printf(
+            "%-30s %12zu %12zu %12zu %12zu\n",
+            Text.Name,
+            PackedPixels,
+            PaddedPixels,
+            static_cast<std::size_t>(Statistics.BitmapUsedBytes),
+            PaddedBitmapSize);
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+}
+
+/**
+ * @brief The measurement of cached letters of a label, without the next
+ *        letter like before kerning, and with it for a font with the kerning
+ *        pairs of the tests and for one with as many pairs as a text font.
+*/
+static void LvglWindowsFontBenchmarksKerning()
+{
+    static const char LabelText[] =
+        "AVATAR WAVE To Ty Yo Vo We LT P. F, r. y. 0123456789 "
+        "The quick brown fox jumps over the lazy dog.";
+    std::vector<std::uint32_t> Text(
+        LabelText,
+        LabelText + sizeof(LabelText) - 1);
+
+    // Text fonts have a few thousand pairs, mostly between Latin letters.
+    std::vector<KERNINGPAIR> TextFontPairs;
+    for (std::uint32_t First = 0x21; First < 0x180; ++First)
+    {
+        for (std::uint32_t j = 0; j < 8; ++j)
+        {
+            KERNINGPAIR Pair;
+            Pair.wFirst = static_cast<WORD>(First);
+            Pair.wSecond = static_cast<WORD>(
+                0x21 + (First * 7 + j * 43) % 0x15F);
+            Pair.iKernAmount = -1 - static_cast<int>(j % 3);
+            TextFontPairs.push_back(Pair);
+        }
+    }
+
+    const struct
+    {
+        const char* Name;
+        std::size_t PairCount;
+        bool IsNextLetterPassed;
+    } Modes[] =
+    {
+        { "No next letter", 0, false },
+        { "2 pairs", 0, true },
+        { "Text font pairs", TextFontPairs.size(), true },
+    };
+
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(20000);
+
+    std::printf(
+        "Measurement of a label of %zu cached letters, nanoseconds per "
+        "letter\n",
+        Text.size());
+    std::printf("%-30s %12s %12s\n", "Kerning", "Pairs", "Nanoseconds");
+    for (const auto& Mode : Modes)
+    {
+        g_LvglWindowsTestsExtraKerningPairs.assign(
+            TextFontPairs.begin(),
+            TextFontPairs.begin() + Mode.PairCount);
+
+        lv_font_t FontObject;
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+        ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+
+        lv_font_glyph_dsc_t Description;
+        std::uint32_t Width = 0;
+        auto Start = std::chrono::steady_clock::now();
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            for (std::size_t i = 0; i < Text.size(); ++i)
+            {
+                std::uint32_t NextLetter = 0;
+                if (Mode.IsNextLetterPassed && i + 1 < Text.size())
+                {
+                    NextLetter = Text[i + 1];
+                }
+                FontObject.get_glyph_dsc(
+                    &FontObject,
+                    &Description,
+                    Text[i],
+                    NextLetter);
+                Width += Description.adv_w;
+            }
+        }
+        double Duration = ::LvglWindowsFontBenchmarksElapsed(Start);
+        LVGL_WINDOWS_TESTS_CHECK(Width != 0);
+
+        std::printf(
+            "%-30s %12zu %12.1f\n",
+            Mode.Name,
+            Mode.PairCount + sizeof(LvglWindowsTestsKerningPairs)
+            / sizeof(*LvglWindowsTestsKerningPairs),
+            Duration / (RepeatCount * Text.size()));
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+    g_LvglWindowsTestsExtraKerningPairs.clear();
+}
+
+#endif
+
+/**
+ * @brief The memory of the glyph cache and the opacity error against 8 bpp
+ *        for each of the bits per pixel the glyphs can be stored with, and
+ *        the cost of rasterizing them.
+*/
+static void LvglWindowsFontBenchmarksGlyphBpp()
+{
+    std::vector<std::uint32_t> Text =
+        ::LvglWindowsFontBenchmarksGetCodePoints(0x20, 95);
+    std::vector<std::uint32_t> Symbols =
+        ::LvglWindowsFontBenchmarksGetCodePoints(
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            500);
+    Text.insert(Text.end(), Symbols.begin(), Symbols.end());
+
+    const std::size_t RepeatCount = ::LvglWindowsTestsRepeatCount(20);
+
+    lv_font_t ReferenceFont;
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.GlyphBpp = 8;
+    ::LvglWindowsFontBenchmarksCreateFont(&ReferenceFont, &Parameters);
+
+    std::printf(
+        "Glyph cache of %zu glyphs for each bits per pixel\n",
+        Text.size());
+    std::printf(
+        "%-10s %12s %12s %12s %12s %12s\n",
+        "Bpp",
+        "Resident",
+        "Bitmaps",
+        "Mean error",
+        "Max error",
+        "Miss ns");
+    static const std::uint8_t BppValues[] = { 8, 4, 2 };
+    for (std::uint8_t Bpp : BppValues)
+    {
+        Parameters.GlyphBpp = Bpp;
+
+        double Duration = 0;
+        for (std::size_t Repeat = 0; Repeat < RepeatCount; ++Repeat)
+        {
+            lv_font_t FontObject;
+            ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+            auto Start = std::chrono::steady_clock::now();
+            ::LvglWindowsFontBenchmarksDrawText(&FontObject, Text);
+            Duration += ::LvglWindowsFontBenchmarksElapsed(Start);
+            ::LvglWindowsGdiFontDestroyFont(&FontObject);
+        }
+
+        lv_font_t FontObject;
+        ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+
+        double ErrorSum = 0;
+        std::uint32_t MaximumError = 0;
+        std::size_t PixelCount = 0;
+        lv_font_glyph_dsc_t Description;
+        lv_font_glyph_dsc_t ReferenceDescription;
+        for (std::uint32_t CodePoint : Text)
+        {
+            if (!FontObject.get_glyph_dsc(
+                &FontObject,
+                &Description,
+                CodePoint,
+                0))
+            {
+                continue;
+            }
+            const std::uint8_t* Bitmap =
+                FontObject.get_glyph_bitmap(&FontObject, CodePoint);
+            ReferenceFont.get_glyph_dsc(
+                &ReferenceFont,
+                &ReferenceDescription,
+                CodePoint,
+                0);
+            const std::uint8_t* ReferenceBitmap =
+                ReferenceFont.get_glyph_bitmap(&ReferenceFont, CodePoint);
+            LVGL_WINDOWS_TESTS_CHECK(Description.bpp == Bpp);
+            LVGL_WINDOWS_TESTS_CHECK(
+                Description.box_w == ReferenceDescription.box_w
+                && Description.box_h == ReferenceDescription.box_h);
+
+            std::size_t GlyphPixelCount = static_cast<std::size_t>(
+                Description.box_w) * Description.box_h;
+            for (std::size_t i = 0; i < GlyphPixelCount; ++i)
+            {
+                std::uint32_t Opacity = ::LvglWindowsFontBenchmarksGetOpacity(
+                    Bitmap,
+                    i,
+                    Bpp);
+                std::uint32_t Reference = ReferenceBitmap[i];
+                std::uint32_t Error = Opacity > Reference
+                    ? Opacity - Reference
+                    : Reference - Opacity;
+                ErrorSum += Error;
+                MaximumError = Error > MaximumError ? Error : MaximumError;
+            }
+            PixelCount += GlyphPixelCount;
+        }
+
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+        std::printf(
+            "%-10u %12zu %12zu %12.2f %12u %12.0f\n",
+            Bpp,
+            static_cast<std::size_t>(Statistics.ResidentBytes),
+            static_cast<std::size_t>(Statistics.BitmapUsedBytes),
+            PixelCount ? ErrorSum / PixelCount : 0.0,
+            MaximumError,
+            Duration / (RepeatCount * Text.size()));
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+
+    ::LvglWindowsGdiFontDestroyFont(&ReferenceFont);
+}
+
+/**
+ * @brief The frames of a list of text scrolled by one line per frame, each
+ *        frame draws a screen of lines and one line is new, with the misses
+ *        rasterized on the LVGL thread and on the worker thread of an
+ *        asynchronous font. The LVGL thread is idle for the rest of the frame
+ *        period, like at 60 frames per second. The GDI fake rasterizes in no
+ *        time, so it is given the cost of a bitmap.
+*/
+static void LvglWindowsFontBenchmarksColdText()
+{
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+    static const std::uint32_t BitmapDelays[] = { 0 };
+#else
+    static const std::uint32_t BitmapDelays[] = { 0, 10, 50 };
+#endif
+
+    const std::size_t LineLength = 20;
+    const std::size_t LineCount = 12;
+    std::size_t FrameCount = ::LvglWindowsTestsRepeatCount(120);
+
+    std::vector<std::uint32_t> Text =
+        ::LvglWindowsFontBenchmarksGetCodePoints(
+            LvglWindowsFontBenchmarksScriptCodePoint,
+            (FrameCount + LineCount) * LineLength);
+    // The text font may have fewer glyphs.
+    if (Text.size() < (FrameCount + LineCount) * LineLength)
+    {
+        FrameCount = Text.size() / LineLength - LineCount;
+    }
+
+    std::printf(
+        "Frames of %zu letters with %zu cold ones, microseconds\n",
+        LineCount * LineLength,
+        LineLength);
+    std::printf(
+        "%-30s %12s %12s %12s\n",
+        "Bitmap cost, rasterization",
+        "Mean frame",
+        "Max frame",
+        "Placeholders");
+    for (std::uint32_t BitmapDelay : BitmapDelays)
+    {
+        for (BOOL Asynchronous = FALSE; Asynchronous <= TRUE; ++Asynchronous)
+        {
+            lv_font_t FontObject;
+            LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+            Parameters.Asynchronous = Asynchronous;
+            ::LvglWindowsFontBenchmarksCreateFont(&FontObject, &Parameters);
+            ::LvglWindowsFontBenchmarksDrawText(
+                &FontObject,
+                std::vector<std::uint32_t>(
+                    Text.begin(),
+                    Text.begin() + LineCount * LineLength));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            g_LvglWindowsTestsGlyphBitmapDelay = BitmapDelay;
+
+            LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+            ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+            std::size_t PlaceholderHits = Statistics.PlaceholderHits;
+
+            double Sum = 0;
+            double Maximum = 0;
+            for (std::size_t Frame = 1; Frame <= FrameCount; ++Frame)
+            {
+                if (g_LvglWindowsTestsTimer.timer_cb)
+                {
+                    g_LvglWindowsTestsTimer.timer_cb(
+                        &g_LvglWindowsTestsTimer);
+                }
+
+                std::vector<std::uint32_t> Screen(
+                    Text.begin() + Frame * LineLength,
+                    Text.begin() + (Frame + LineCount) * LineLength);
+                auto Start = std::chrono::steady_clock::now();
+                ::LvglWindowsFontBenchmarksDrawText(&FontObject, Screen);
+                double Duration = ::LvglWindowsFontBenchmarksElapsed(Start);
+                Sum += Duration;
+                Maximum = Duration > Maximum ? Duration : Maximum;
+
+                std::this_thread::sleep_until(
+                    Start + std::chrono::microseconds(16667));
+            }
+
+            g_LvglWindowsTestsGlyphBitmapDelay = 0;
+
+            ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+            PlaceholderHits = Statistics.PlaceholderHits - PlaceholderHits;
+            char Name[64];
+#if defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+            UNREFERENCED_PARAMETER(BitmapDelay);
+            std::snprintf(
+                Name,
+                sizeof(Name),
+                "FreeType, %s",
+                Asynchronous ? "asynchronous" : "synchronous");
+#else
+            std::snprintf(
+                Name,
+                sizeof(Name),
+                "%u us, %s",
+                BitmapDelay,
+                Asynchronous ? "asynchronous" : "synchronous");
+#endif
+            std::printf(
+                "%-30s %12.1f %12.1f %12zu\n",
+                Name,
+                Sum / FrameCount / 1000,
+                Maximum / 1000,
+                PlaceholderHits);
+
+            ::LvglWindowsGdiFontDestroyFont(&FontObject);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    static const LVGL_WINDOWS_TESTS_CASE Cases[] =
+    {
+        { "GlyphIndex", ::LvglWindowsFontBenchmarksGlyphIndex },
+        { "DpiSwitch", ::LvglWindowsFontBenchmarksDpiSwitch },
+        { "FirstFrame", ::LvglWindowsFontBenchmarksFirstFrame },
+        { "GlyphMiss", ::LvglWindowsFontBenchmarksGlyphMiss },
+#if !defined(LVGL_WINDOWS_TESTS_FONT_FILE)
+        { "ConvertCoverage", ::LvglWindowsFontBenchmarksConvertCoverage },
+        { "BlendPixels", ::LvglWindowsFontBenchmarksBlendPixels },
+        { "Kerning", ::LvglWindowsFontBenchmarksKerning },
+#endif
+        { "GlyphBpp", ::LvglWindowsFontBenchmarksGlyphBpp },
+        { "ColdText", ::LvglWindowsFontBenchmarksColdText },
+    };
+
+    return ::LvglWindowsTestsRunBenchmarks(
+        Cases,
+        sizeof(Cases) / sizeof(*Cases),
+        argc,
+        argv);
+}
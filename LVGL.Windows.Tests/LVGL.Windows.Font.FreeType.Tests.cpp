@@ -0,0 +1,250 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Font.FreeType.Tests.cpp
+ * PURPOSE:   Implementation for the tests of the FreeType backend of the
+ *            Windows GDI font engine
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Windows.Font.h"
+
+#include "LVGL.Resource.FontAwesome5FreeLVGL.h"
+
+#include <cstdio>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+namespace
+{
+    const int LvglWindowsFontFreeTypeTestsFontSize = 16;
+
+    /**
+     * @brief Reads the text font given by the build, a TrueType font without
+     *        the symbols.
+    */
+    std::vector<std::uint8_t> LvglWindowsFontFreeTypeTestsReadFontFile()
+    {
+        std::vector<std::uint8_t> Content;
+
+        std::FILE* File = std::fopen(LVGL_WINDOWS_TESTS_FONT_FILE, "rb");
+        LVGL_WINDOWS_TESTS_CHECK(File);
+        if (File)
+        {
+            std::uint8_t Buffer[4096];
+            std::size_t ReadSize = 0;
+            while ((ReadSize = std::fread(Buffer, 1, sizeof(Buffer), File)))
+            {
+                Content.insert(Content.end(), Buffer, Buffer + ReadSize);
+            }
+            std::fclose(File);
+        }
+
+        return Content;
+    }
+
+    bool LvglWindowsFontFreeTypeTestsCreateFont(
+        lv_font_t* FontObject,
+        LPCWSTR FontName,
+        const std::uint8_t* FontData,
+        std::size_t FontDataSize)
+    {
+        // The glyphs are not scaled at the default DPI value.
+        ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        Parameters.FontSize = LvglWindowsFontFreeTypeTestsFontSize;
+        Parameters.FontName = FontName;
+        Parameters.Backend = LvglWindowsGdiFontBackendFreeType;
+        Parameters.FontData = FontData;
+        Parameters.FontDataSize = FontDataSize;
+        return ::LvglWindowsGdiFontCreateFontIndirect(
+            FontObject,
+            &Parameters) != FALSE;
+    }
+
+    /**
+     * @brief Checks a glyph looked up by LVGL against the glyph rendered by
+     *        FreeType directly from the font data.
+    */
+    void LvglWindowsFontFreeTypeTestsCheckGlyph(
+        const lv_font_t* FontObject,
+        std::uint32_t CodePoint,
+        const std::uint8_t* FontData,
+        std::size_t FontDataSize)
+    {
+        FT_Library Library = nullptr;
+        LVGL_WINDOWS_TESTS_CHECK(!::FT_Init_FreeType(&Library));
+        FT_Face Face = nullptr;
+        LVGL_WINDOWS_TESTS_CHECK(!::FT_New_Memory_Face(
+            Library,
+            FontData,
+            static_cast<FT_Long>(FontDataSize),
+            0,
+            &Face));
+        LVGL_WINDOWS_TESTS_CHECK(!::FT_Set_Pixel_Sizes(
+            Face,
+            0,
+            LvglWindowsFontFreeTypeTestsFontSize));
+        LVGL_WINDOWS_TESTS_CHECK(::FT_Get_Char_Index(Face, CodePoint));
+        LVGL_WINDOWS_TESTS_CHECK(!::FT_Load_Char(
+            Face,
+            CodePoint,
+            FT_LOAD_NO_BITMAP | FT_LOAD_RENDER));
+
+        const FT_GlyphSlot Slot = Face->glyph;
+        const FT_Bitmap& Bitmap = Slot->bitmap;
+
+        lv_font_glyph_dsc_t Description;
+        LVGL_WINDOWS_TESTS_CHECK(FontObject->get_glyph_dsc(
+            FontObject,
+            &Description,
+            CodePoint,
+            0));
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_w == Bitmap.width);
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_h == Bitmap.rows);
+        LVGL_WINDOWS_TESTS_CHECK(Description.ofs_x == Slot->bitmap_left);
+        LVGL_WINDOWS_TESTS_CHECK(
+            Description.ofs_y == Slot->bitmap_top
+            - static_cast<std::int32_t>(Bitmap.rows));
+        LVGL_WINDOWS_TESTS_CHECK(
+            Description.adv_w == (Slot->advance.x + 32) >> 6);
+        LVGL_WINDOWS_TESTS_CHECK(Description.bpp == 8);
+
+        const std::uint8_t* GlyphBitmap = FontObject->get_glyph_bitmap(
+            FontObject,
+            CodePoint);
+        LVGL_WINDOWS_TESTS_CHECK(GlyphBitmap);
+        bool IsSame = GlyphBitmap != nullptr;
+        for (unsigned int y = 0; IsSame && y < Bitmap.rows; ++y)
+        {
+            IsSame = std::memcmp(
+                GlyphBitmap + y * Bitmap.width,
+                Bitmap.buffer + y * Bitmap.pitch,
+                Bitmap.width) == 0;
+        }
+        LVGL_WINDOWS_TESTS_CHECK(IsSame);
+
+        ::FT_Done_Face(Face);
+        ::FT_Done_FreeType(Library);
+    }
+}
+
+/**
+ * @brief The built-in symbol font is read from its font data without GDI.
+*/
+static void LvglWindowsFontFreeTypeTestsSymbolFont()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontFreeTypeTestsCreateFont(
+        &FontObject,
+        LvglFontAwesome5FreeLvglFontName,
+        LvglFontAwesome5FreeLvglFontResource,
+        LvglFontAwesome5FreeLvglFontResourceSize));
+
+    for (std::uint32_t CodePoint : { 0xF001u, 0xF00Cu, 0xF015u, 0xF293u })
+    {
+        ::LvglWindowsFontFreeTypeTestsCheckGlyph(
+            &FontObject,
+            CodePoint,
+            LvglFontAwesome5FreeLvglFontResource,
+            LvglFontAwesome5FreeLvglFontResourceSize);
+    }
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.GdiObjectCount == 0);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The main font is read from the font data given with the font, the
+ *        symbols fall back to the built-in symbol font.
+*/
+static void LvglWindowsFontFreeTypeTestsFontData()
+{
+    std::vector<std::uint8_t> FontData =
+        ::LvglWindowsFontFreeTypeTestsReadFontFile();
+    if (FontData.empty())
+    {
+        return;
+    }
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontFreeTypeTestsCreateFont(
+        &FontObject,
+        nullptr,
+        FontData.data(),
+        FontData.size()));
+
+    LVGL_WINDOWS_TESTS_CHECK(FontObject.line_height > 0);
+    LVGL_WINDOWS_TESTS_CHECK(FontObject.base_line > 0);
+    LVGL_WINDOWS_TESTS_CHECK(FontObject.base_line < FontObject.line_height);
+
+    for (std::uint32_t CodePoint : { 0x41u, 0x67u, 0xE9u, 0x3A9u })
+    {
+        ::LvglWindowsFontFreeTypeTestsCheckGlyph(
+            &FontObject,
+            CodePoint,
+            FontData.data(),
+            FontData.size());
+    }
+    // The text font has no glyph for it.
+    ::LvglWindowsFontFreeTypeTestsCheckGlyph(
+        &FontObject,
+        0xF00C,
+        LvglFontAwesome5FreeLvglFontResource,
+        LvglFontAwesome5FreeLvglFontResourceSize);
+
+    // In neither font.
+    lv_font_glyph_dsc_t Description;
+    LVGL_WINDOWS_TESTS_CHECK(!FontObject.get_glyph_dsc(
+        &FontObject,
+        &Description,
+        0x4E00,
+        0));
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.GdiObjectCount == 0);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.MissingGlyphCount == 1);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The fonts given by name are found with GDI, creating the font fails
+ *        when GDI has no font data for them.
+*/
+static void LvglWindowsFontFreeTypeTestsFontName()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsFontFreeTypeTestsCreateFont(
+        &FontObject,
+        L"Segoe UI",
+        nullptr,
+        0));
+}
+
+int main(int argc, char** argv)
+{
+    static const LVGL_WINDOWS_TESTS_CASE Cases[] =
+    {
+        { "SymbolFont", ::LvglWindowsFontFreeTypeTestsSymbolFont },
+        { "FontData", ::LvglWindowsFontFreeTypeTestsFontData },
+        { "FontName", ::LvglWindowsFontFreeTypeTestsFontName },
+    };
+
+    return ::LvglWindowsTestsRun(
+        Cases,
+        sizeof(Cases) / sizeof(*Cases),
+        argc,
+        argv);
+}
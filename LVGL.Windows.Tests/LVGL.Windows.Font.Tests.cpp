@@ -0,0 +1,1692 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Font.Tests.cpp
+ * PURPOSE:   Implementation for the tests of the Windows GDI font engine
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Windows.Font.Internal.h"
+
+#include "LVGL.Resource.FontAwesome5FreeLVGL.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+    const wchar_t LvglWindowsFontTestsFontName[] = L"Segoe UI";
+
+    typedef void (*LVGL_WINDOWS_FONT_TESTS_CONVERT_COVERAGE)(
+        std::uint8_t* Buffer,
+        std::size_t Length);
+
+    // The dispatched kernel and each kernel built for the architecture.
+    const LVGL_WINDOWS_FONT_TESTS_CONVERT_COVERAGE
+        LvglWindowsFontTestsConvertCoverages[] =
+    {
+        ::LvglWindowsGdiFontConvertCoverage,
+        ::LvglWindowsGdiFontConvertCoverageScalar,
+#if defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+        ::LvglWindowsGdiFontConvertCoverageSse2,
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+        ::LvglWindowsGdiFontConvertCoverageNeon,
+#endif
+    };
+
+    std::uint8_t LvglWindowsFontTestsConvertLevel(
+        std::uint8_t Level)
+    {
+        return static_cast<std::uint8_t>(Level == 0x40 ? 0xFF : Level << 2);
+    }
+
+    bool LvglWindowsFontTestsCreateFont(
+        lv_font_t* FontObject,
+        SIZE_T GlyphCacheBudget,
+        BOOL Asynchronous)
+    {
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        Parameters.FontSize = 16;
+        Parameters.FontName = LvglWindowsFontTestsFontName;
+        Parameters.GlyphCacheBudget = GlyphCacheBudget;
+        Parameters.Asynchronous = Asynchronous;
+        return ::LvglWindowsGdiFontCreateFontIndirect(
+            FontObject,
+            &Parameters) != FALSE;
+    }
+
+    /**
+     * @brief Checks a glyph looked up by LVGL against the GDI fake. The
+     *        placeholders of the asynchronous fonts are counted instead.
+    */
+    void LvglWindowsFontTestsCheckGlyph(
+        const lv_font_t* FontObject,
+        std::uint32_t CodePoint,
+        std::size_t* PlaceholderCount)
+    {
+        lv_font_glyph_dsc_t Description;
+        bool HasGlyph = FontObject->get_glyph_dsc(
+            FontObject,
+            &Description,
+            CodePoint,
+            0);
+        LVGL_WINDOWS_TESTS_CHECK(
+            HasGlyph == ::LvglWindowsTestsHasGlyph(CodePoint));
+        if (!HasGlyph)
+        {
+            return;
+        }
+
+        const std::uint8_t* Bitmap = FontObject->get_glyph_bitmap(
+            FontObject,
+            CodePoint);
+
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        ::LvglWindowsTestsGetGlyphBox(CodePoint, &Width, &Height);
+
+        if (!Description.box_w)
+        {
+            LVGL_WINDOWS_TESTS_CHECK(PlaceholderCount);
+            if (PlaceholderCount)
+            {
+                ++*PlaceholderCount;
+            }
+            LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == Width + 2);
+            return;
+        }
+
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_w == Width);
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_h == Height);
+        LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == Width + 2);
+        LVGL_WINDOWS_TESTS_CHECK(Description.bpp == 8);
+        LVGL_WINDOWS_TESTS_CHECK(Bitmap);
+        if (!Bitmap)
+        {
+            return;
+        }
+
+        std::uint8_t Expected = ::LvglWindowsFontTestsConvertLevel(
+            ::LvglWindowsTestsGetGlyphLevel(CodePoint));
+        for (std::uint32_t i = 0; i < Width * Height; ++i)
+        {
+            if (Bitmap[i] != Expected)
+            {
+                LVGL_WINDOWS_TESTS_CHECK(Bitmap[i] == Expected);
+                break;
+            }
+        }
+    }
+
+    void LvglWindowsFontTestsRunRedrawTimer()
+    {
+        if (g_LvglWindowsTestsTimer.timer_cb)
+        {
+            g_LvglWindowsTestsTimer.timer_cb(&g_LvglWindowsTestsTimer);
+        }
+    }
+
+    /**
+     * @brief Looks up the glyphs of the code points like LVGL draws them into
+     *        the area, or like it measures them when no area is given.
+    */
+    void LvglWindowsFontTestsDrawPlaceholders(
+        const lv_font_t* FontObject,
+        std::uint32_t FirstCodePoint,
+        std::uint32_t LastCodePoint,
+        const lv_area_t* Area)
+    {
+        lv_draw_ctx_t DrawContext = {};
+        DrawContext.clip_area = Area;
+        g_LvglWindowsTestsDisplayDriver.draw_ctx = &DrawContext;
+        g_LvglWindowsTestsDisplay.rendering_in_progress = Area ? 1 : 0;
+
+        lv_font_glyph_dsc_t Description;
+        for (std::uint32_t CodePoint = FirstCodePoint;
+            CodePoint <= LastCodePoint;
+            ++CodePoint)
+        {
+            if (FontObject->get_glyph_dsc(
+                FontObject,
+                &Description,
+                CodePoint,
+                0))
+            {
+                LVGL_WINDOWS_TESTS_CHECK(!Description.box_w);
+            }
+        }
+
+        g_LvglWindowsTestsDisplay.rendering_in_progress = 0;
+        g_LvglWindowsTestsDisplayDriver.draw_ctx = nullptr;
+    }
+
+    bool LvglWindowsFontTestsIsAreaIn(
+        const lv_area_t& Area,
+        const lv_area_t& Outer)
+    {
+        return Area.x1 >= Outer.x1
+            && Area.y1 >= Outer.y1
+            && Area.x2 <= Outer.x2
+            && Area.y2 <= Outer.y2;
+    }
+
+    /**
+     * @brief Runs the redraw timer until the worker thread rasterized a glyph
+     *        and the timer invalidated the areas drawn with placeholders.
+    */
+    void LvglWindowsFontTestsWaitForRedraw()
+    {
+        for (std::size_t i = 0;
+            i < 10000 && g_LvglWindowsTestsInvalidatedAreas.empty();
+            ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ::LvglWindowsFontTestsRunRedrawTimer();
+        }
+    }
+
+    /**
+     * @brief Spreads each subpixel of a row over its neighbours with the
+     *        weights of the FreeType default LCD filter, the first target
+     *        subpixel is 2 subpixels before the first source subpixel.
+    */
+    std::vector<std::uint8_t> LvglWindowsFontTestsFilterRow(
+        const std::vector<std::uint8_t>& Source)
+    {
+        static const std::uint32_t Weights[5] =
+        {
+            0x08, 0x4D, 0x56, 0x4D, 0x08
+        };
+
+        std::vector<std::uint32_t> Sums(Source.size() + 4, 0);
+        for (std::size_t x = 0; x < Source.size(); ++x)
+        {
+            for (std::size_t t = 0; t < 5; ++t)
+            {
+                Sums[x + t] += Weights[t] * Source[x];
+            }
+        }
+
+        std::vector<std::uint8_t> Target;
+        for (std::uint32_t Sum : Sums)
+        {
+            Target.push_back(static_cast<std::uint8_t>((Sum + 128) >> 8));
+        }
+        return Target;
+    }
+}
+
+/**
+ * @brief The coverage conversion gives the same bytes as the scalar loop it
+ *        replaced, for all the 65 levels, lengths and alignments.
+*/
+static void LvglWindowsFontTestsConvertCoverage()
+{
+    std::vector<std::uint8_t> Buffer(256 + 16);
+    for (LVGL_WINDOWS_FONT_TESTS_CONVERT_COVERAGE ConvertCoverage
+        : LvglWindowsFontTestsConvertCoverages)
+    {
+        for (std::size_t Offset = 0; Offset < 16; ++Offset)
+        {
+            for (std::size_t Length = 0;
+                Length <= 256;
+                Length += 1 + Length / 8)
+            {
+                for (std::size_t i = 0; i < Length; ++i)
+                {
+                    Buffer[Offset + i] = static_cast<std::uint8_t>(
+                        ::LvglWindowsTestsRandom() % 65);
+                }
+                Buffer[Offset + Length] = 0xA5;
+
+                std::vector<std::uint8_t> Expected(
+                    Buffer.begin() + Offset,
+                    Buffer.begin() + Offset + Length);
+                for (std::uint8_t& Value : Expected)
+                {
+                    Value = ::LvglWindowsFontTestsConvertLevel(Value);
+                }
+
+                ConvertCoverage(&Buffer[Offset], Length);
+
+                LVGL_WINDOWS_TESTS_CHECK(std::equal(
+                    Expected.begin(),
+                    Expected.end(),
+                    Buffer.begin() + Offset));
+                LVGL_WINDOWS_TESTS_CHECK(Buffer[Offset + Length] == 0xA5);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The packed 4-bpp and 2-bpp bitmaps have the first pixel in the most
+ *        significant bits, the levels rounded to the nearest and the last
+ *        byte padded with zeros.
+*/
+static void LvglWindowsFontTestsPackCoverage()
+{
+    const std::uint8_t Source[] = { 0, 255, 128, 17, 255, 85, 170 };
+
+    std::uint8_t Target[4] = { 0xA5, 0xA5, 0xA5, 0xA5 };
+    ::LvglWindowsGdiFontPackCoverage(Target, Source, 7, 4);
+    // 0, 15, 8, 1, 15, 5, 10 and the padding.
+    LVGL_WINDOWS_TESTS_CHECK(Target[0] == 0x0F);
+    LVGL_WINDOWS_TESTS_CHECK(Target[1] == 0x81);
+    LVGL_WINDOWS_TESTS_CHECK(Target[2] == 0xF5);
+    LVGL_WINDOWS_TESTS_CHECK(Target[3] == 0xA0);
+
+    std::memset(Target, 0xA5, sizeof(Target));
+    ::LvglWindowsGdiFontPackCoverage(Target, Source, 7, 2);
+    // 0, 3, 2, 0 then 3, 1, 2 and the padding.
+    LVGL_WINDOWS_TESTS_CHECK(Target[0] == 0x38);
+    LVGL_WINDOWS_TESTS_CHECK(Target[1] == 0xD8);
+    LVGL_WINDOWS_TESTS_CHECK(Target[2] == 0xA5);
+
+    // Every level rounds to the nearest packed level.
+    for (std::uint32_t Bpp = 2; Bpp <= 4; Bpp += 2)
+    {
+        std::uint32_t MaximumLevel = (1U << Bpp) - 1;
+        for (std::uint32_t Value = 0; Value < 256; ++Value)
+        {
+            std::uint8_t Pixel = static_cast<std::uint8_t>(Value);
+            std::uint8_t Packed = 0;
+            ::LvglWindowsGdiFontPackCoverage(
+                &Packed,
+                &Pixel,
+                1,
+                static_cast<std::uint8_t>(Bpp));
+            std::uint32_t Level = Packed >> (8 - Bpp);
+            std::int32_t Error = static_cast<std::int32_t>(
+                Level * 255) - static_cast<std::int32_t>(
+                    Value * MaximumLevel);
+            LVGL_WINDOWS_TESTS_CHECK(
+                2 * std::abs(Error) <= static_cast<std::int32_t>(255));
+        }
+    }
+}
+
+/**
+ * @brief The glyphs are stored without the DWORD padding of the rows of
+ *        GGO_GRAY8_BITMAP and with the converted coverage, and the second
+ *        lookups are served by the cache.
+*/
+static void LvglWindowsFontTestsGlyphs()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x400; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x400; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount == OutlineCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The glyph index keeps finding every glyph while its hash table
+ *        grows, for the code points in random order on both sides of the
+ *        direct-indexed range.
+*/
+static void LvglWindowsFontTestsGlyphIndex()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    std::vector<std::uint32_t> CodePoints;
+    for (std::size_t i = 0; i < 4000; ++i)
+    {
+        CodePoints.push_back((::LvglWindowsTestsRandom() % 8)
+            ? 0x100 + ::LvglWindowsTestsRandom() % 0x9F00
+            : ::LvglWindowsTestsRandom() % 0x100);
+    }
+
+    for (std::uint32_t CodePoint : CodePoints)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+
+    // Every glyph is found again, including the ones added before the
+    // table grew.
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t CodePoint : CodePoints)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount == OutlineCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The bitmap callback for the letter which has just been measured is
+ *        served by the last resolved glyph, the other lookups search the
+ *        cache.
+*/
+static void LvglWindowsFontTestsLastGlyph()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    lv_font_glyph_dsc_t Description;
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+
+    // Measured then drawn, like LVGL draws a letter.
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'A', 0);
+    FontObject.get_glyph_bitmap(&FontObject, L'A');
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphHits == 1);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphMisses == 1);
+
+    // Another letter in between.
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'B', 0);
+    FontObject.get_glyph_bitmap(&FontObject, L'A');
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphHits == 1);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphMisses == 3);
+
+    // The letters missing from the fonts are not remembered.
+    LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsTestsHasGlyph(L'f'));
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'f', 0);
+    FontObject.get_glyph_bitmap(&FontObject, L'f');
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphHits == 1);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphMisses == 5);
+
+    ::LvglWindowsFontTestsCheckGlyph(&FontObject, L'C', nullptr);
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphHits == 2);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.LastGlyphMisses == 6);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief Each DPI value has its own glyph cache, switching back to a DPI
+ *        value which has been used does not rasterize the glyphs again.
+*/
+static void LvglWindowsFontTestsDpiCaches()
+{
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x200; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount > OutlineCount);
+
+    // A new DPI value rasterizes the glyphs again.
+    ::LvglWindowsGdiFontNotifyDpiChanged(2 * USER_DEFAULT_SCREEN_DPI);
+    OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x200; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount > OutlineCount);
+
+    // Both caches are kept.
+    OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (int Round = 0; Round < 4; ++Round)
+    {
+        ::LvglWindowsGdiFontNotifyDpiChanged(
+            (Round % 2 ? 2 : 1) * USER_DEFAULT_SCREEN_DPI);
+        for (std::uint32_t CodePoint = 0x20; CodePoint < 0x200; ++CodePoint)
+        {
+            ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+        }
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount == OutlineCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief The glyph bitmaps keep their addresses while the cache grows.
+*/
+static void LvglWindowsFontTestsBitmapSlabs()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    std::vector<const std::uint8_t*> Bitmaps;
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x120; ++CodePoint)
+    {
+        Bitmaps.push_back(FontObject.get_glyph_bitmap(&FontObject, CodePoint));
+    }
+    for (std::uint32_t CodePoint = 0x120; CodePoint < 0x3000; ++CodePoint)
+    {
+        FontObject.get_glyph_bitmap(&FontObject, CodePoint);
+    }
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x120; ++CodePoint)
+    {
+        const std::uint8_t* Bitmap = Bitmaps[CodePoint - 0x20];
+        LVGL_WINDOWS_TESTS_CHECK(
+            FontObject.get_glyph_bitmap(&FontObject, CodePoint) == Bitmap);
+        LVGL_WINDOWS_TESTS_CHECK(
+            reinterpret_cast<std::uintptr_t>(Bitmap) % 16 == 0);
+    }
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.BitmapSlabCount > 1);
+    LVGL_WINDOWS_TESTS_CHECK(
+        Statistics.BitmapReservedBytes
+        == Statistics.BitmapSlabCount * LvglWindowsGdiFontArenaSlabSize);
+    LVGL_WINDOWS_TESTS_CHECK(
+        Statistics.BitmapUsedBytes + Statistics.BitmapFragmentedBytes
+        <= Statistics.BitmapReservedBytes);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The cache of the DPI value which is not used is released as a whole
+ *        before any glyph of the current cache is evicted.
+*/
+static void LvglWindowsFontTestsDpiEviction()
+{
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        16 * 1024,
+        FALSE));
+
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x80; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    std::size_t InactiveGlyphCount = Statistics.GlyphCount;
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.Evictions == 0);
+
+    // Fill the cache of the other DPI value up to the first eviction.
+    ::LvglWindowsGdiFontNotifyDpiChanged(2 * USER_DEFAULT_SCREEN_DPI);
+    std::uint32_t EndCodePoint = 0x20;
+    while (!Statistics.Evictions && EndCodePoint < 0x2000)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, EndCodePoint++, nullptr);
+        ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.Evictions == InactiveGlyphCount);
+
+    // The current glyphs are all kept.
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t CodePoint = 0x20; CodePoint < EndCodePoint; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount == OutlineCount);
+
+    // The released glyphs are rasterized again.
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+    ::LvglWindowsFontTestsCheckGlyph(&FontObject, L'A', nullptr);
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount > OutlineCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief Streams random text through a font with a small budget, the
+ *        resident size must stay within the budget and the reserved bitmap
+ *        memory must stay flat.
+*/
+static void LvglWindowsFontTestsBudgetSoak()
+{
+    const SIZE_T Budget = 64 * 1024;
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        Budget,
+        FALSE));
+
+    const std::size_t RoundCount = 200;
+    std::size_t MaximumReservedBytes[2] = { 0, 0 };
+
+    for (std::size_t Round = 0; Round < RoundCount; ++Round)
+    {
+        for (std::size_t i = 0; i < 500; ++i)
+        {
+            // Mostly the CJK ideographs, like the text of a kiosk.
+            std::uint32_t CodePoint = (::LvglWindowsTestsRandom() % 4)
+                ? 0x4E00 + ::LvglWindowsTestsRandom() % 0x5200
+                : 0x20 + ::LvglWindowsTestsRandom() % 0x5E;
+            ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+        }
+
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.ResidentBytes <= Budget);
+
+        std::size_t& Maximum = MaximumReservedBytes[Round * 2 / RoundCount];
+        Maximum = std::max<std::size_t>(
+            Maximum,
+            Statistics.BitmapReservedBytes);
+    }
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.Evictions > 0);
+    LVGL_WINDOWS_TESTS_CHECK(
+        MaximumReservedBytes[1] <= MaximumReservedBytes[0]);
+
+    std::printf(
+        "evictions=%zu resident=%zu reserved=%zu/%zu\n",
+        static_cast<std::size_t>(Statistics.Evictions),
+        static_cast<std::size_t>(Statistics.ResidentBytes),
+        MaximumReservedBytes[0],
+        MaximumReservedBytes[1]);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The prewarmed glyphs are rasterized once, and the lookups which
+ *        follow are served by the cache.
+*/
+static void LvglWindowsFontTestsPrewarm()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    // "Hello, world!" and two CJK ideographs, U+4F60 and U+597D.
+    const char Text[] = "Hello, world! \xE4\xBD\xA0\xE5\xA5\xBD";
+    const std::uint32_t Letters[] =
+    {
+        L'H', L'e', L'l', L'o', L',', L' ', L'w', L'r', L'd', L'!',
+        0x4F60, 0x597D
+    };
+    std::size_t Expected = 0;
+    for (std::uint32_t Letter : Letters)
+    {
+        Expected += ::LvglWindowsTestsHasGlyph(Letter) ? 1 : 0;
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        ::LvglWindowsGdiFontPrewarm(&FontObject, Text) == Expected);
+    LVGL_WINDOWS_TESTS_CHECK(
+        ::LvglWindowsGdiFontPrewarm(&FontObject, Text) == 0);
+
+    Expected = 0;
+    for (std::uint32_t CodePoint = 0x1000; CodePoint <= 0x1400; ++CodePoint)
+    {
+        Expected += ::LvglWindowsTestsHasGlyph(CodePoint) ? 1 : 0;
+    }
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontPrewarmRange(
+        &FontObject,
+        0x1000,
+        0x1400) == Expected);
+
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+    for (std::uint32_t Letter : Letters)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, Letter, nullptr);
+    }
+    for (std::uint32_t CodePoint = 0x1000; CodePoint <= 0x1400; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount == OutlineCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The prewarmed ranges are clamped to the Unicode code points.
+*/
+static void LvglWindowsFontTestsPrewarmRange()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontPrewarmRange(
+        &FontObject,
+        0x110000,
+        0xFFFFFFFF) == 0);
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontPrewarmRange(
+        &FontObject,
+        0x10FFF0,
+        0xFFFFFFFF) == 0);
+
+    std::size_t Expected = 0;
+    for (std::uint32_t CodePoint = 0x20; CodePoint <= 0x20 + 3000; ++CodePoint)
+    {
+        Expected += ::LvglWindowsTestsHasGlyph(CodePoint) ? 1 : 0;
+    }
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontPrewarmRange(
+        &FontObject,
+        0x20,
+        0x20 + 3000) == Expected);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The cache misses use the memory DCs of the font, with the main
+ *        font and the symbol font selected once.
+*/
+static void LvglWindowsFontTestsMemoryDCs()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    std::size_t GetDCCount = g_LvglWindowsTestsGetDCCount;
+    std::size_t SelectObjectCount = g_LvglWindowsTestsSelectObjectCount;
+    std::size_t OutlineCount = g_LvglWindowsTestsGlyphOutlineCount;
+
+    for (std::uint32_t CodePoint = 0x20; CodePoint < 0x400; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+
+    // The symbols are rasterized on the DC of the symbol font.
+    for (std::uint32_t CodePoint = 0xF000; CodePoint < 0xF100; ++CodePoint)
+    {
+        lv_font_glyph_dsc_t Description;
+        LVGL_WINDOWS_TESTS_CHECK(FontObject.get_glyph_dsc(
+            &FontObject,
+            &Description,
+            CodePoint,
+            0));
+    }
+
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphOutlineCount > OutlineCount);
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsGetDCCount == GetDCCount);
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsSelectObjectCount == SelectObjectCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The glyphs saved to a glyph cache file are served from the file
+ *        after it is loaded, and the glyph records which are not valid are
+ *        skipped.
+*/
+static void LvglWindowsFontTestsCacheFile()
+{
+    std::random_device Device;
+    std::wstring FileName = L"LVGL.Windows.Font.Tests."
+        + std::to_wstring(Device()) + L".cache";
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+    ::LvglWindowsGdiFontPrewarmRange(&FontObject, 0x20, 0x200);
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontSaveCache(
+        &FontObject,
+        FileName.c_str()));
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Saved;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Saved);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontLoadCache(
+        &FontObject,
+        FileName.c_str()));
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.GlyphCount == Saved.GlyphCount);
+
+    // Only the letters missing from the fonts are looked up again, the file
+    // does not keep them.
+    std::size_t MissingCount = 0;
+    for (std::uint32_t CodePoint = 0x20; CodePoint <= 0x200; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+        MissingCount += ::LvglWindowsTestsHasGlyph(CodePoint) ? 0 : 1;
+    }
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.CacheMisses == MissingCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    // Damage three glyph records of the file.
+    std::vector<std::uint8_t> Content;
+    std::FILE* Stream = std::fopen(
+        std::string(FileName.begin(), FileName.end()).c_str(),
+        "r+b");
+    LVGL_WINDOWS_TESTS_CHECK(Stream);
+    if (!Stream)
+    {
+        return;
+    }
+    std::fseek(Stream, 0, SEEK_END);
+    Content.resize(static_cast<std::size_t>(std::ftell(Stream)));
+    std::fseek(Stream, 0, SEEK_SET);
+    LVGL_WINDOWS_TESTS_CHECK(
+        std::fread(Content.data(), 1, Content.size(), Stream)
+        == Content.size());
+
+    LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH* Records =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH>(
+            &Content[sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER)]);
+    std::uint32_t DamagedCodePoint = Records[2].CodePoint;
+    LVGL_WINDOWS_TESTS_CHECK(Records[2].BoxWidth && Records[2].BitmapSize);
+    Records[0].CodePoint = 0xFFFFFFFF;
+    Records[1].CodePoint = LvglWindowsGdiFontMaximumCodePoint + 1;
+    Records[2].BitmapSize = 0;
+
+    std::fseek(Stream, 0, SEEK_SET);
+    std::fwrite(Content.data(), 1, Content.size(), Stream);
+    std::fclose(Stream);
+
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontLoadCache(
+        &FontObject,
+        FileName.c_str()));
+
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.GlyphCount == Saved.GlyphCount - 3);
+
+    // The skipped glyph is rasterized again.
+    ::LvglWindowsFontTestsCheckGlyph(&FontObject, DamagedCodePoint, nullptr);
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.CacheMisses == 1);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    std::remove(std::string(FileName.begin(), FileName.end()).c_str());
+}
+
+/**
+ * @brief The glyph cache file has the most recently used glyphs first, so a
+ *        font with a smaller budget loads the ones drawn last.
+*/
+static void LvglWindowsFontTestsCacheFileRecency()
+{
+    std::random_device Device;
+    std::wstring FileName = L"LVGL.Windows.Font.Tests."
+        + std::to_wstring(Device()) + L".cache";
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+    ::LvglWindowsGdiFontPrewarmRange(&FontObject, 0x100, 0x1FF);
+    std::size_t RecentCount = 0;
+    std::size_t MissingCount = 0;
+    for (std::uint32_t CodePoint = 0x20; CodePoint <= 0x7E; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+        RecentCount += ::LvglWindowsTestsHasGlyph(CodePoint) ? 1 : 0;
+        MissingCount += ::LvglWindowsTestsHasGlyph(CodePoint) ? 0 : 1;
+    }
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontSaveCache(
+        &FontObject,
+        FileName.c_str()));
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    // The glyphs from the file are all charged the same size.
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontLoadCache(
+        &FontObject,
+        FileName.c_str()));
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    std::size_t SavedCount = Statistics.GlyphCount;
+    std::size_t GlyphSize = Statistics.ResidentBytes / SavedCount;
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        GlyphSize * (RecentCount + RecentCount / 2),
+        FALSE));
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontLoadCache(
+        &FontObject,
+        FileName.c_str()));
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.GlyphCount < SavedCount);
+
+    for (std::uint32_t CodePoint = 0x20; CodePoint <= 0x7E; ++CodePoint)
+    {
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.CacheMisses == MissingCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    std::remove(std::string(FileName.begin(), FileName.end()).c_str());
+}
+
+/**
+ * @brief The code points in none of the fonts are looked up with GDI once,
+ *        in the bitset of the Basic Multilingual Plane or in the list of the
+ *        other planes, for all the DPI values.
+*/
+static void LvglWindowsFontTestsMissingGlyphs()
+{
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    const std::uint32_t CodePoints[] = { 0x66, 0x3CF, 0xB000, 0xFFFF, 0x20066 };
+    for (std::uint32_t CodePoint : CodePoints)
+    {
+        LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsTestsHasGlyph(CodePoint));
+        LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsTestsHasSymbolGlyph(CodePoint));
+        ::LvglWindowsFontTestsCheckGlyph(&FontObject, CodePoint, nullptr);
+    }
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.MissingGlyphCount == 5);
+    std::size_t MissingGlyphHits = Statistics.MissingGlyphHits;
+
+    std::size_t IndicesCount = g_LvglWindowsTestsGlyphIndicesCount;
+    ::LvglWindowsGdiFontNotifyDpiChanged(2 * USER_DEFAULT_SCREEN_DPI);
+    for (std::uint32_t CodePoint : CodePoints)
+    {
+        lv_font_glyph_dsc_t Description;
+        LVGL_WINDOWS_TESTS_CHECK(!FontObject.get_glyph_dsc(
+            &FontObject,
+            &Description,
+            CodePoint,
+            0));
+        LVGL_WINDOWS_TESTS_CHECK(!FontObject.get_glyph_bitmap(
+            &FontObject,
+            CodePoint));
+    }
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontPrewarmRange(
+        &FontObject,
+        0xFFFF,
+        0xFFFF) == 0);
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphIndicesCount == IndicesCount);
+
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.MissingGlyphCount == 5);
+    LVGL_WINDOWS_TESTS_CHECK(
+        Statistics.MissingGlyphHits == MissingGlyphHits + 10);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief The letters are drawn with the first font of the chain which has
+ *        them, the main font, the fallback fonts in order and the built-in
+ *        symbol font, and the owning fonts are kept as code point ranges.
+*/
+static void LvglWindowsFontTestsFallbackChain()
+{
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+    // The first fallback font has the same letters as the main font.
+    const LPCWSTR FallbackFontNames[] =
+    {
+        LvglWindowsFontTestsFontName,
+        LvglWindowsTestsFallbackFontName,
+    };
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = 16;
+    Parameters.FontName = LvglWindowsFontTestsFontName;
+    Parameters.FallbackFontNames = FallbackFontNames;
+    Parameters.FallbackFontCount = 2;
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+        &FontObject,
+        &Parameters));
+
+    std::vector<std::uint32_t> CodePoints;
+    for (std::uint32_t CodePoint = 0x20; CodePoint <= 0x80; ++CodePoint)
+    {
+        CodePoints.push_back(CodePoint);
+    }
+    // The fallback font, the fallback font before the symbol font, the
+    // symbol font and none of the fonts.
+    CodePoints.insert(CodePoints.end(), { 0xA100, 0xF001, 0xF020, 0xB000 });
+
+    for (std::uint32_t CodePoint : CodePoints)
+    {
+        std::uint8_t Expected = 0;
+        if (::LvglWindowsTestsHasGlyph(CodePoint)
+            || ::LvglWindowsTestsHasSymbolGlyph(CodePoint))
+        {
+            Expected = ::LvglWindowsTestsGetGlyphLevel(CodePoint);
+        }
+        if (::LvglWindowsTestsHasFallbackGlyph(CodePoint))
+        {
+            Expected = LvglWindowsTestsFallbackGlyphLevel;
+        }
+
+        lv_font_glyph_dsc_t Description;
+        bool HasGlyph = FontObject.get_glyph_dsc(
+            &FontObject,
+            &Description,
+            CodePoint,
+            0);
+        LVGL_WINDOWS_TESTS_CHECK(HasGlyph == (CodePoint != 0xB000));
+        if (!HasGlyph)
+        {
+            continue;
+        }
+
+        const std::uint8_t* Bitmap = FontObject.get_glyph_bitmap(
+            &FontObject,
+            CodePoint);
+        LVGL_WINDOWS_TESTS_CHECK(Bitmap);
+        LVGL_WINDOWS_TESTS_CHECK(!Bitmap
+            || Bitmap[0] == ::LvglWindowsFontTestsConvertLevel(Expected));
+    }
+
+    // 0x20 to 0x65, 0x66, 0x67 to 0x80, 0xA100, 0xF001 and 0xF020.
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.FaceRangeCount == 6);
+
+    // Rasterized again for another DPI value, only the owning font is asked.
+    ::LvglWindowsGdiFontNotifyDpiChanged(2 * USER_DEFAULT_SCREEN_DPI);
+    std::size_t IndicesCount = g_LvglWindowsTestsGlyphIndicesCount;
+    for (std::uint32_t CodePoint : { 0x41u, 0x66u, 0xF001u, 0xF020u })
+    {
+        FontObject.get_glyph_bitmap(&FontObject, CodePoint);
+    }
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphIndicesCount == IndicesCount + 4);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief The code points above U+FFFF are mapped to their glyphs by the
+ *        format 12 cmap subtable, without GetGlyphIndicesW.
+*/
+static void LvglWindowsFontTestsCharacterMap()
+{
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = 16;
+    Parameters.FontName = LvglWindowsTestsCharacterMapFontName;
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+        &FontObject,
+        &Parameters));
+
+    std::size_t IndicesCount = g_LvglWindowsTestsGlyphIndicesCount;
+
+    const std::uint32_t CodePoints[][2] =
+    {
+        { 0x41, 0x41 },
+        { 0x1F600, 0x1000 },
+        { 0x1F64F, 0x104F },
+        { 0x20000, 0x2000 },
+    };
+    for (const auto& CodePoint : CodePoints)
+    {
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        ::LvglWindowsTestsGetGlyphBox(CodePoint[1], &Width, &Height);
+
+        lv_font_glyph_dsc_t Description;
+        LVGL_WINDOWS_TESTS_CHECK(FontObject.get_glyph_dsc(
+            &FontObject,
+            &Description,
+            CodePoint[0],
+            0));
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_w == Width);
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_h == Height);
+
+        const std::uint8_t* Bitmap = FontObject.get_glyph_bitmap(
+            &FontObject,
+            CodePoint[0]);
+        LVGL_WINDOWS_TESTS_CHECK(Bitmap);
+        LVGL_WINDOWS_TESTS_CHECK(!Bitmap
+            || Bitmap[0] == ::LvglWindowsFontTestsConvertLevel(
+                ::LvglWindowsTestsGetGlyphLevel(CodePoint[1])));
+    }
+
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsGlyphIndicesCount == IndicesCount);
+
+    // Between the groups, and in none of the fonts.
+    lv_font_glyph_dsc_t Description;
+    LVGL_WINDOWS_TESTS_CHECK(!FontObject.get_glyph_dsc(
+        &FontObject,
+        &Description,
+        0x1F650,
+        0));
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief The kerning pairs of the main font move the next letter, but only
+ *        when both letters are drawn with the main font.
+*/
+static void LvglWindowsFontTestsKerning()
+{
+    ::LvglWindowsGdiFontNotifyDpiChanged(USER_DEFAULT_SCREEN_DPI);
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        FALSE));
+
+    lv_font_glyph_dsc_t Description;
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'A', 0);
+    std::uint16_t AdvanceWidth = Description.adv_w;
+
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'A', L'V');
+    LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == AdvanceWidth - 2);
+
+    // The cached descriptor keeps the advance without kerning.
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'A', L'B');
+    LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == AdvanceWidth);
+
+    // U+F001 is drawn with the built-in symbol font.
+    FontObject.get_glyph_dsc(&FontObject, &Description, L'A', 0xF001);
+    LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == AdvanceWidth);
+    LVGL_WINDOWS_TESTS_CHECK(FontObject.get_glyph_dsc(
+        &FontObject,
+        &Description,
+        0xF001,
+        0));
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+
+    ::LvglWindowsGdiFontNotifyDpiChanged(LV_DPI_DEF);
+}
+
+/**
+ * @brief The fonts created with 4 or 2 bits per pixel give LVGL the packed
+ *        glyphs, in a half or a quarter of the memory of the 8-bpp glyphs.
+*/
+static void LvglWindowsFontTestsGlyphBpp()
+{
+    const std::uint8_t BppModes[] = { 8, 4, 2 };
+    for (std::uint8_t Bpp : BppModes)
+    {
+        LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+        Parameters.FontSize = 16;
+        Parameters.FontName = LvglWindowsFontTestsFontName;
+        Parameters.GlyphBpp = Bpp;
+        lv_font_t FontObject;
+        LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+            &FontObject,
+            &Parameters));
+
+        std::size_t BitmapBytes = 0;
+        for (std::uint32_t CodePoint = L'A'; CodePoint <= L'Z'; ++CodePoint)
+        {
+            lv_font_glyph_dsc_t Description;
+            LVGL_WINDOWS_TESTS_CHECK(FontObject.get_glyph_dsc(
+                &FontObject,
+                &Description,
+                CodePoint,
+                0));
+            LVGL_WINDOWS_TESTS_CHECK(Description.bpp == Bpp);
+
+            std::uint32_t Width = 0;
+            std::uint32_t Height = 0;
+            ::LvglWindowsTestsGetGlyphBox(CodePoint, &Width, &Height);
+            std::size_t PixelCount = Width * Height;
+            BitmapBytes += (PixelCount * Bpp + 7) / 8;
+
+            // The coverage is converted first, then packed.
+            std::vector<std::uint8_t> Pixels(
+                PixelCount,
+                ::LvglWindowsFontTestsConvertLevel(
+                    ::LvglWindowsTestsGetGlyphLevel(CodePoint)));
+            std::vector<std::uint8_t> Expected(PixelCount);
+            if (Bpp == 8)
+            {
+                Expected = Pixels;
+            }
+            else
+            {
+                ::LvglWindowsGdiFontPackCoverage(
+                    Expected.data(),
+                    Pixels.data(),
+                    PixelCount,
+                    Bpp);
+            }
+
+            const std::uint8_t* Bitmap = FontObject.get_glyph_bitmap(
+                &FontObject,
+                CodePoint);
+            LVGL_WINDOWS_TESTS_CHECK(Bitmap);
+            LVGL_WINDOWS_TESTS_CHECK(!Bitmap || std::memcmp(
+                Bitmap,
+                Expected.data(),
+                (PixelCount * Bpp + 7) / 8) == 0);
+        }
+
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontGetStatistics(
+            &FontObject,
+            &Statistics));
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.BitmapUsedBytes == BitmapBytes);
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    }
+
+    // Only 8, 4 and 2 bits per pixel.
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = 16;
+    Parameters.FontName = LvglWindowsFontTestsFontName;
+    Parameters.GlyphBpp = 1;
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsGdiFontCreateFontIndirect(
+        &FontObject,
+        &Parameters));
+}
+
+/**
+ * @brief The subpixels are filtered with the 5-tap FreeType default LCD
+ *        filter and aligned to whole pixels.
+*/
+static void LvglWindowsFontTestsFilterSubpixels()
+{
+    // A single subpixel keeps its coverage, the weights sum to 256.
+    std::vector<std::uint8_t> Target;
+    const std::uint8_t Single = 255;
+    std::uint32_t TargetWidth = 0;
+    std::int32_t TargetOffsetX = 0;
+    ::LvglWindowsGdiFontFilterSubpixels(
+        Target,
+        &Single,
+        1,
+        1,
+        0,
+        &TargetWidth,
+        &TargetOffsetX);
+    const std::uint8_t Expected[] = { 0, 8, 77, 86, 77, 8 };
+    LVGL_WINDOWS_TESTS_CHECK(TargetWidth == 6);
+    LVGL_WINDOWS_TESTS_CHECK(TargetOffsetX == -1);
+    LVGL_WINDOWS_TESTS_CHECK(Target.size() == sizeof(Expected));
+    LVGL_WINDOWS_TESTS_CHECK(Target.size() != sizeof(Expected)
+        || std::memcmp(Target.data(), Expected, sizeof(Expected)) == 0);
+
+    // Random rows at every origin against the reference filter.
+    for (std::int32_t OriginX = -4; OriginX <= 4; ++OriginX)
+    {
+        const std::uint32_t Width = 11;
+        const std::uint32_t Height = 3;
+        std::vector<std::uint8_t> Source(Width * Height);
+        for (std::uint8_t& Value : Source)
+        {
+            Value = static_cast<std::uint8_t>(::LvglWindowsTestsRandom());
+        }
+
+        ::LvglWindowsGdiFontFilterSubpixels(
+            Target,
+            Source.data(),
+            Width,
+            Height,
+            OriginX,
+            &TargetWidth,
+            &TargetOffsetX);
+        LVGL_WINDOWS_TESTS_CHECK(TargetWidth % 3 == 0);
+        LVGL_WINDOWS_TESTS_CHECK(Target.size() == TargetWidth * Height);
+
+        // The pixel of the first filtered subpixel.
+        std::int32_t Lead = OriginX - 2 - TargetOffsetX * 3;
+        LVGL_WINDOWS_TESTS_CHECK(Lead >= 0 && Lead < 3);
+        LVGL_WINDOWS_TESTS_CHECK(Lead + Width + 4 <= TargetWidth);
+        LVGL_WINDOWS_TESTS_CHECK(Lead + Width + 4 > TargetWidth - 3);
+        if (Lead < 0
+            || Lead + Width + 4 > TargetWidth
+            || Target.size() != TargetWidth * Height)
+        {
+            continue;
+        }
+
+        for (std::uint32_t y = 0; y < Height; ++y)
+        {
+            std::vector<std::uint8_t> Row(
+                Source.begin() + y * Width,
+                Source.begin() + (y + 1) * Width);
+            std::vector<std::uint8_t> Reference(TargetWidth, 0);
+            std::vector<std::uint8_t> Filtered =
+                ::LvglWindowsFontTestsFilterRow(Row);
+            std::copy(
+                Filtered.begin(),
+                Filtered.end(),
+                Reference.begin() + Lead);
+            LVGL_WINDOWS_TESTS_CHECK(std::equal(
+                Reference.begin(),
+                Reference.end(),
+                Target.begin() + y * TargetWidth));
+        }
+    }
+}
+
+/**
+ * @brief The subpixel fonts give LVGL the filtered glyphs, with box_w in
+ *        subpixels and the advance width in pixels.
+*/
+static void LvglWindowsFontTestsSubpixelGlyphs()
+{
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = 16;
+    Parameters.FontName = LvglWindowsFontTestsFontName;
+    Parameters.Subpixel = TRUE;
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+        &FontObject,
+        &Parameters));
+    LVGL_WINDOWS_TESTS_CHECK(FontObject.subpx == LV_FONT_SUBPX_HOR);
+
+    for (std::uint32_t CodePoint = L'A'; CodePoint <= L'Z'; ++CodePoint)
+    {
+        lv_font_glyph_dsc_t Description;
+        LVGL_WINDOWS_TESTS_CHECK(FontObject.get_glyph_dsc(
+            &FontObject,
+            &Description,
+            CodePoint,
+            0));
+
+        // The GDI fake puts the glyph origin at the subpixel 1.
+        std::uint32_t Width = 0;
+        std::uint32_t Height = 0;
+        ::LvglWindowsTestsGetGlyphBox(CodePoint, &Width, &Height);
+        std::uint32_t AlignedWidth = (2 + Width + 4 + 2) / 3 * 3;
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_w == AlignedWidth);
+        LVGL_WINDOWS_TESTS_CHECK(Description.box_h == Height);
+        LVGL_WINDOWS_TESTS_CHECK(Description.ofs_x == -1);
+        LVGL_WINDOWS_TESTS_CHECK(Description.adv_w == (Width + 3) / 3);
+
+        std::vector<std::uint8_t> Row(
+            Width,
+            ::LvglWindowsFontTestsConvertLevel(
+                ::LvglWindowsTestsGetGlyphLevel(CodePoint)));
+        std::vector<std::uint8_t> Reference(AlignedWidth, 0);
+        std::vector<std::uint8_t> Filtered =
+            ::LvglWindowsFontTestsFilterRow(Row);
+        std::copy(Filtered.begin(), Filtered.end(), Reference.begin() + 2);
+
+        const std::uint8_t* Bitmap = FontObject.get_glyph_bitmap(
+            &FontObject,
+            CodePoint);
+        LVGL_WINDOWS_TESTS_CHECK(Bitmap);
+        for (std::uint32_t y = 0; Bitmap && y < Height; ++y)
+        {
+            LVGL_WINDOWS_TESTS_CHECK(std::equal(
+                Reference.begin(),
+                Reference.end(),
+                Bitmap + y * AlignedWidth));
+        }
+    }
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+/**
+ * @brief Prewarms a font from other threads, with its asynchronous worker
+ *        rasterizing the misses, while the test thread looks up glyphs like
+ *        the LVGL thread. Build it with -DLVGL_WINDOWS_TESTS_SANITIZER=thread
+ *        to check the races.
+*/
+static void LvglWindowsFontTestsConcurrentStress(
+    BOOL Asynchronous)
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        48 * 1024,
+        Asynchronous));
+
+    std::atomic<bool> IsStopping(false);
+
+    std::thread FirstThread([&]()
+    {
+        for (std::uint32_t Round = 0; Round < 40; ++Round)
+        {
+            ::LvglWindowsGdiFontPrewarmRange(
+                &FontObject,
+                0x20 + Round * 50,
+                0x20 + Round * 50 + 400);
+
+            LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+            ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+        }
+        IsStopping = true;
+    });
+
+    std::thread SecondThread([&]()
+    {
+        for (std::uint32_t Round = 0; Round < 30; ++Round)
+        {
+            ::LvglWindowsGdiFontPrewarm(
+                &FontObject,
+                "Hello, world! 0123456789 \xE4\xBD\xA0\xE5\xA5\xBD");
+            ::LvglWindowsGdiFontPrewarmRange(
+                &FontObject,
+                0x1000 + Round * 20,
+                0x1100 + Round * 20);
+        }
+    });
+
+    std::size_t PlaceholderCount = 0;
+    std::size_t Lookups = 0;
+    std::uint32_t State = 1;
+    while (!IsStopping || Lookups < 10000)
+    {
+        if (Lookups % 50 == 0)
+        {
+            ::LvglWindowsFontTestsRunRedrawTimer();
+        }
+
+        State = State * 1103515245U + 12345U;
+        std::uint32_t Random = State >> 8;
+        std::uint32_t CodePoint = (Random % 3 == 0)
+            ? 0x20 + (Random >> 2) % 0x60
+            : 0x20 + (Random >> 2) % 0x2000;
+
+        ::LvglWindowsFontTestsCheckGlyph(
+            &FontObject,
+            CodePoint,
+            Asynchronous ? &PlaceholderCount : nullptr);
+        ++Lookups;
+    }
+
+    FirstThread.join();
+    SecondThread.join();
+
+    LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+    ::LvglWindowsGdiFontGetStatistics(&FontObject, &Statistics);
+    LVGL_WINDOWS_TESTS_CHECK(Statistics.PlaceholderHits == PlaceholderCount);
+
+    std::printf(
+        "lookups=%zu placeholders=%zu\n",
+        Lookups,
+        PlaceholderCount);
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+}
+
+static void LvglWindowsFontTestsSynchronousStress()
+{
+    ::LvglWindowsFontTestsConcurrentStress(FALSE);
+}
+
+static void LvglWindowsFontTestsAsynchronousStress()
+{
+    ::LvglWindowsFontTestsConcurrentStress(TRUE);
+}
+
+/**
+ * @brief The asynchronous fonts invalidate the areas drawn with placeholders
+ *        once the worker thread rasterized them, and neither the measured
+ *        letters nor the objects which did not draw them.
+*/
+static void LvglWindowsFontTestsPlaceholderRedraw()
+{
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsFontTestsCreateFont(
+        &FontObject,
+        0,
+        TRUE));
+
+    const lv_area_t Label = { 10, 20, 110, 40 };
+    const lv_area_t Part = { 20, 25, 60, 35 };
+    const lv_area_t Button = { 0, 50, 50, 60 };
+    g_LvglWindowsTestsInvalidatedAreas.clear();
+    const struct
+    {
+        std::uint32_t FirstCodePoint;
+        const lv_area_t* Area;
+    } Draws[] =
+    {
+        { 0x4E00, &Label },
+        // A part of the label, already covered.
+        { 0x4E40, &Part },
+        { 0x4E80, &Button },
+        // Only measured for the layout.
+        { 0x4EC0, nullptr },
+    };
+    for (const auto& Draw : Draws)
+    {
+        ::LvglWindowsFontTestsDrawPlaceholders(
+            &FontObject,
+            Draw.FirstCodePoint,
+            Draw.FirstCodePoint + 0x3F,
+            Draw.Area);
+    }
+    ::LvglWindowsFontTestsWaitForRedraw();
+
+    LVGL_WINDOWS_TESTS_CHECK(g_LvglWindowsTestsInvalidatedAreas.size() == 2);
+    if (g_LvglWindowsTestsInvalidatedAreas.size() == 2)
+    {
+        const lv_area_t& First = g_LvglWindowsTestsInvalidatedAreas[0];
+        const lv_area_t& Second = g_LvglWindowsTestsInvalidatedAreas[1];
+        LVGL_WINDOWS_TESTS_CHECK(
+            ::LvglWindowsFontTestsIsAreaIn(First, Label)
+            && ::LvglWindowsFontTestsIsAreaIn(Label, First));
+        LVGL_WINDOWS_TESTS_CHECK(
+            ::LvglWindowsFontTestsIsAreaIn(Second, Button)
+            && ::LvglWindowsFontTestsIsAreaIn(Button, Second));
+    }
+
+    // More areas than LVGL keeps are joined, each one stays covered.
+    std::vector<lv_area_t> Areas;
+    for (std::uint32_t i = 0; i < 3 * LV_INV_BUF_SIZE; ++i)
+    {
+        lv_area_t Area;
+        Area.x1 = static_cast<lv_coord_t>(i);
+        Area.y1 = static_cast<lv_coord_t>(i);
+        Area.x2 = static_cast<lv_coord_t>(i + 10);
+        Area.y2 = static_cast<lv_coord_t>(i + 5);
+        Areas.push_back(Area);
+        ::LvglWindowsFontTestsDrawPlaceholders(
+            &FontObject,
+            0x5000 + i * 4,
+            0x5003 + i * 4,
+            &Area);
+    }
+    g_LvglWindowsTestsInvalidatedAreas.clear();
+    ::LvglWindowsFontTestsWaitForRedraw();
+
+    LVGL_WINDOWS_TESTS_CHECK(!g_LvglWindowsTestsInvalidatedAreas.empty());
+    LVGL_WINDOWS_TESTS_CHECK(
+        g_LvglWindowsTestsInvalidatedAreas.size() <= LV_INV_BUF_SIZE);
+    for (const lv_area_t& Area : Areas)
+    {
+        bool IsCovered = false;
+        for (const lv_area_t& Invalidated : g_LvglWindowsTestsInvalidatedAreas)
+        {
+            IsCovered = IsCovered
+                || ::LvglWindowsFontTestsIsAreaIn(Area, Invalidated);
+        }
+        LVGL_WINDOWS_TESTS_CHECK(IsCovered);
+    }
+
+    ::LvglWindowsGdiFontDestroyFont(&FontObject);
+    g_LvglWindowsTestsInvalidatedAreas.clear();
+}
+
+/**
+ * @brief The fonts created with the same font names share the font family
+ *        and its resolved face ranges, and the destroyed fonts release all
+ *        their GDI objects.
+*/
+static void LvglWindowsFontTestsFamily()
+{
+    std::size_t GdiObjectCount = g_LvglWindowsTestsGdiObjectCount;
+
+    for (int Round = 0; Round < 3; ++Round)
+    {
+        lv_font_t FontObjects[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+            Parameters.FontSize = 12 + i * 4;
+            Parameters.FontName = LvglWindowsFontTestsFontName;
+            Parameters.GlyphCacheBudget = i == 1 ? 4096 : 0;
+            Parameters.Asynchronous = i == 2;
+            LVGL_WINDOWS_TESTS_CHECK(::LvglWindowsGdiFontCreateFontIndirect(
+                &FontObjects[i],
+                &Parameters));
+        }
+
+        ::LvglWindowsGdiFontPrewarmRange(&FontObjects[0], 0x20, 0x300);
+
+        LVGL_WINDOWS_GDI_FONT_STATISTICS First;
+        ::LvglWindowsGdiFontGetStatistics(&FontObjects[0], &First);
+        LVGL_WINDOWS_TESTS_CHECK(First.FaceRangeCount > 0);
+
+        std::size_t OwnedObjectCount = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+            ::LvglWindowsGdiFontGetStatistics(&FontObjects[i], &Statistics);
+            LVGL_WINDOWS_TESTS_CHECK(Statistics.FamilyReferenceCount == 3);
+            LVGL_WINDOWS_TESTS_CHECK(
+                Statistics.FaceRangeCount == First.FaceRangeCount);
+            LVGL_WINDOWS_TESTS_CHECK(Statistics.GdiObjectCount > 0);
+            OwnedObjectCount += Statistics.GdiObjectCount;
+        }
+        LVGL_WINDOWS_TESTS_CHECK(
+            g_LvglWindowsTestsGdiObjectCount
+            == GdiObjectCount + OwnedObjectCount);
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObjects[0]);
+        LVGL_WINDOWS_GDI_FONT_STATISTICS Statistics;
+        ::LvglWindowsGdiFontGetStatistics(&FontObjects[1], &Statistics);
+        LVGL_WINDOWS_TESTS_CHECK(Statistics.FamilyReferenceCount == 2);
+
+        ::LvglWindowsGdiFontDestroyFont(&FontObjects[1]);
+        ::LvglWindowsGdiFontDestroyFont(&FontObjects[2]);
+        LVGL_WINDOWS_TESTS_CHECK(
+            g_LvglWindowsTestsGdiObjectCount == GdiObjectCount);
+    }
+}
+
+/**
+ * @brief The GDI backend only finds the fonts by name, it cannot read the font
+ *        data given with the font.
+*/
+static void LvglWindowsFontTestsFontData()
+{
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = 16;
+    Parameters.FontName = LvglFontAwesome5FreeLvglFontName;
+    Parameters.FontData = LvglFontAwesome5FreeLvglFontResource;
+    Parameters.FontDataSize = LvglFontAwesome5FreeLvglFontResourceSize;
+
+    lv_font_t FontObject;
+    LVGL_WINDOWS_TESTS_CHECK(!::LvglWindowsGdiFontCreateFontIndirect(
+        &FontObject,
+        &Parameters));
+}
+
+int main(int argc, char** argv)
+{
+    static const LVGL_WINDOWS_TESTS_CASE Cases[] =
+    {
+        { "ConvertCoverage", ::LvglWindowsFontTestsConvertCoverage },
+        { "PackCoverage", ::LvglWindowsFontTestsPackCoverage },
+        { "Glyphs", ::LvglWindowsFontTestsGlyphs },
+        { "GlyphIndex", ::LvglWindowsFontTestsGlyphIndex },
+        { "LastGlyph", ::LvglWindowsFontTestsLastGlyph },
+        { "DpiCaches", ::LvglWindowsFontTestsDpiCaches },
+        { "BitmapSlabs", ::LvglWindowsFontTestsBitmapSlabs },
+        { "DpiEviction", ::LvglWindowsFontTestsDpiEviction },
+        { "BudgetSoak", ::LvglWindowsFontTestsBudgetSoak },
+        { "Prewarm", ::LvglWindowsFontTestsPrewarm },
+        { "PrewarmRange", ::LvglWindowsFontTestsPrewarmRange },
+        { "MemoryDCs", ::LvglWindowsFontTestsMemoryDCs },
+        { "CacheFile", ::LvglWindowsFontTestsCacheFile },
+        { "CacheFileRecency", ::LvglWindowsFontTestsCacheFileRecency },
+        { "MissingGlyphs", ::LvglWindowsFontTestsMissingGlyphs },
+        { "FallbackChain", ::LvglWindowsFontTestsFallbackChain },
+        { "CharacterMap", ::LvglWindowsFontTestsCharacterMap },
+        { "Kerning", ::LvglWindowsFontTestsKerning },
+        { "GlyphBpp", ::LvglWindowsFontTestsGlyphBpp },
+        { "FilterSubpixels", ::LvglWindowsFontTestsFilterSubpixels },
+        { "SubpixelGlyphs", ::LvglWindowsFontTestsSubpixelGlyphs },
+        { "SynchronousStress", ::LvglWindowsFontTestsSynchronousStress },
+        { "AsynchronousStress", ::LvglWindowsFontTestsAsynchronousStress },
+        { "PlaceholderRedraw", ::LvglWindowsFontTestsPlaceholderRedraw },
+        { "Family", ::LvglWindowsFontTestsFamily },
+        { "FontData", ::LvglWindowsFontTestsFontData },
+    };
+
+    return ::LvglWindowsTestsRun(
+        Cases,
+        sizeof(Cases) / sizeof(*Cases),
+        argc,
+        argv);
+}
@@ -0,0 +1,1263 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Tests.cpp
+ * PURPOSE:   Implementation for the test runner and the Windows API and LVGL
+ *            fakes of the LVGL ported to Windows tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#include "LVGL.Windows.Tests.h"
+
+#include "LVGL.Resource.FontAwesome5FreeLVGL.h"
+#include "lvgl/demos/lv_demos.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+std::size_t g_LvglWindowsTestsFailureCount = 0;
+
+int LvglWindowsTestsRun(
+    const LVGL_WINDOWS_TESTS_CASE* Cases,
+    std::size_t CaseCount,
+    int argc,
+    char** argv)
+{
+    std::size_t RunCount = 0;
+    std::size_t FailedCount = 0;
+
+    for (std::size_t i = 0; i < CaseCount; ++i)
+    {
+        if (argc > 1 && std::strcmp(argv[1], Cases[i].Name) != 0)
+        {
+            continue;
+        }
+
+        g_LvglWindowsTestsFailureCount = 0;
+        Cases[i].Function();
+        ++RunCount;
+
+        if (g_LvglWindowsTestsFailureCount)
+        {
+            ++FailedCount;
+        }
+
+        std::printf(
+            "%s: %s\n",
+            Cases[i].Name,
+            g_LvglWindowsTestsFailureCount ? "FAILED" : "passed");
+    }
+
+    if (!RunCount)
+    {
+        std::fprintf(stderr, "no test named %s\n", argv[1]);
+        return 1;
+    }
+
+    return FailedCount ? 1 : 0;
+}
+
+static bool g_LvglWindowsTestsIsSmokeRun = false;
+
+int LvglWindowsTestsRunBenchmarks(
+    const LVGL_WINDOWS_TESTS_CASE* Cases,
+    std::size_t CaseCount,
+    int argc,
+    char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "Smoke") == 0)
+    {
+        g_LvglWindowsTestsIsSmokeRun = true;
+        return ::LvglWindowsTestsRun(Cases, CaseCount, 1, argv);
+    }
+
+    return ::LvglWindowsTestsRun(Cases, CaseCount, argc, argv);
+}
+
+std::size_t LvglWindowsTestsRepeatCount(
+    std::size_t RepeatCount)
+{
+    return g_LvglWindowsTestsIsSmokeRun ? 1 : RepeatCount;
+}
+
+std::uint32_t LvglWindowsTestsRandom()
+{
+    // The xorshift32 generator, enough for the random inputs of the tests.
+    static std::uint32_t State = 2463534242U;
+    State ^= State << 13;
+    State ^= State >> 17;
+    State ^= State << 5;
+    return State;
+}
+
+// Kernel
+
+namespace
+{
+    typedef struct _LVGL_WINDOWS_TESTS_FILE
+    {
+        std::FILE* Stream;
+        // The content read by CreateFileMappingW, nullptr for a file.
+        std::vector<std::uint8_t>* Content;
+    } LVGL_WINDOWS_TESTS_FILE, *PLVGL_WINDOWS_TESTS_FILE;
+
+    std::string LvglWindowsTestsConvertFileName(
+        LPCWSTR FileName)
+    {
+        std::string Result;
+        for (; *FileName; ++FileName)
+        {
+            Result.push_back(static_cast<char>(*FileName));
+        }
+        return Result;
+    }
+
+    std::atomic<std::uintptr_t> g_LvglWindowsTestsNextHandle(0x1000);
+
+    template<typename HandleType>
+    HandleType LvglWindowsTestsCreateHandle()
+    {
+        return reinterpret_cast<HandleType>(
+            g_LvglWindowsTestsNextHandle.fetch_add(0x10));
+    }
+}
+
+void WINAPI Sleep(
+    DWORD dwMilliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(dwMilliseconds));
+}
+
+HMODULE WINAPI LoadLibraryW(
+    LPCWSTR lpLibFileName)
+{
+    UNREFERENCED_PARAMETER(lpLibFileName);
+    return nullptr;
+}
+
+HMODULE WINAPI GetModuleHandleW(
+    LPCWSTR lpModuleName)
+{
+    UNREFERENCED_PARAMETER(lpModuleName);
+    return nullptr;
+}
+
+FARPROC WINAPI GetProcAddress(
+    HMODULE hModule,
+    LPCSTR lpProcName)
+{
+    UNREFERENCED_PARAMETER(hModule);
+    UNREFERENCED_PARAMETER(lpProcName);
+    return nullptr;
+}
+
+BOOL WINAPI FreeLibrary(
+    HMODULE hLibModule)
+{
+    UNREFERENCED_PARAMETER(hLibModule);
+    return TRUE;
+}
+
+BOOL WINAPI VerifyVersionInfoW(
+    OSVERSIONINFOEXW* lpVersionInformation,
+    DWORD dwTypeMask,
+    DWORDLONG dwlConditionMask)
+{
+    UNREFERENCED_PARAMETER(lpVersionInformation);
+    UNREFERENCED_PARAMETER(dwTypeMask);
+    UNREFERENCED_PARAMETER(dwlConditionMask);
+    return FALSE;
+}
+
+DWORDLONG WINAPI VerSetConditionMask(
+    DWORDLONG ConditionMask,
+    DWORD TypeMask,
+    BYTE Condition)
+{
+    UNREFERENCED_PARAMETER(TypeMask);
+    UNREFERENCED_PARAMETER(Condition);
+    return ConditionMask;
+}
+
+HANDLE WINAPI CreateFileW(
+    LPCWSTR lpFileName,
+    DWORD dwDesiredAccess,
+    DWORD dwShareMode,
+    LPVOID lpSecurityAttributes,
+    DWORD dwCreationDisposition,
+    DWORD dwFlagsAndAttributes,
+    HANDLE hTemplateFile)
+{
+    UNREFERENCED_PARAMETER(dwShareMode);
+    UNREFERENCED_PARAMETER(lpSecurityAttributes);
+    UNREFERENCED_PARAMETER(dwCreationDisposition);
+    UNREFERENCED_PARAMETER(dwFlagsAndAttributes);
+    UNREFERENCED_PARAMETER(hTemplateFile);
+
+    std::FILE* Stream = std::fopen(
+        ::LvglWindowsTestsConvertFileName(lpFileName).c_str(),
+        (dwDesiredAccess & GENERIC_WRITE) ? "wb" : "rb");
+    if (!Stream)
+    {
+        return INVALID_HANDLE_VALUE;
+    }
+
+    PLVGL_WINDOWS_TESTS_FILE File = new LVGL_WINDOWS_TESTS_FILE();
+    File->Stream = Stream;
+    File->Content = nullptr;
+    return File;
+}
+
+BOOL WINAPI GetFileSizeEx(
+    HANDLE hFile,
+    PLARGE_INTEGER lpFileSize)
+{
+    PLVGL_WINDOWS_TESTS_FILE File =
+        reinterpret_cast<PLVGL_WINDOWS_TESTS_FILE>(hFile);
+    if (std::fseek(File->Stream, 0, SEEK_END) != 0)
+    {
+        return FALSE;
+    }
+    lpFileSize->QuadPart = std::ftell(File->Stream);
+    return std::fseek(File->Stream, 0, SEEK_SET) == 0;
+}
+
+BOOL WINAPI WriteFile(
+    HANDLE hFile,
+    LPCVOID lpBuffer,
+    DWORD nNumberOfBytesToWrite,
+    LPDWORD lpNumberOfBytesWritten,
+    LPVOID lpOverlapped)
+{
+    UNREFERENCED_PARAMETER(lpOverlapped);
+
+    PLVGL_WINDOWS_TESTS_FILE File =
+        reinterpret_cast<PLVGL_WINDOWS_TESTS_FILE>(hFile);
+    *lpNumberOfBytesWritten = static_cast<DWORD>(std::fwrite(
+        lpBuffer,
+        1,
+        nNumberOfBytesToWrite,
+        File->Stream));
+    return *lpNumberOfBytesWritten == nNumberOfBytesToWrite;
+}
+
+HANDLE WINAPI CreateFileMappingW(
+    HANDLE hFile,
+    LPVOID lpFileMappingAttributes,
+    DWORD flProtect,
+    DWORD dwMaximumSizeHigh,
+    DWORD dwMaximumSizeLow,
+    LPCWSTR lpName)
+{
+    UNREFERENCED_PARAMETER(lpFileMappingAttributes);
+    UNREFERENCED_PARAMETER(flProtect);
+    UNREFERENCED_PARAMETER(dwMaximumSizeHigh);
+    UNREFERENCED_PARAMETER(dwMaximumSizeLow);
+    UNREFERENCED_PARAMETER(lpName);
+
+    // The mapping keeps a copy of the file, which outlives the file handle
+    // like a real mapping does.
+    PLVGL_WINDOWS_TESTS_FILE File =
+        reinterpret_cast<PLVGL_WINDOWS_TESTS_FILE>(hFile);
+    LARGE_INTEGER FileSize;
+    if (!::GetFileSizeEx(hFile, &FileSize))
+    {
+        return nullptr;
+    }
+
+    PLVGL_WINDOWS_TESTS_FILE Mapping = new LVGL_WINDOWS_TESTS_FILE();
+    Mapping->Stream = nullptr;
+    Mapping->Content = new std::vector<std::uint8_t>(
+        static_cast<std::size_t>(FileSize.QuadPart));
+    if (std::fread(
+        Mapping->Content->data(),
+        1,
+        Mapping->Content->size(),
+        File->Stream) != Mapping->Content->size())
+    {
+        delete Mapping->Content;
+        delete Mapping;
+        return nullptr;
+    }
+    return Mapping;
+}
+
+LPVOID WINAPI MapViewOfFile(
+    HANDLE hFileMappingObject,
+    DWORD dwDesiredAccess,
+    DWORD dwFileOffsetHigh,
+    DWORD dwFileOffsetLow,
+    SIZE_T dwNumberOfBytesToMap)
+{
+    UNREFERENCED_PARAMETER(dwDesiredAccess);
+    UNREFERENCED_PARAMETER(dwFileOffsetHigh);
+    UNREFERENCED_PARAMETER(dwFileOffsetLow);
+    UNREFERENCED_PARAMETER(dwNumberOfBytesToMap);
+
+    // Views are page aligned.
+    PLVGL_WINDOWS_TESTS_FILE Mapping =
+        reinterpret_cast<PLVGL_WINDOWS_TESTS_FILE>(hFileMappingObject);
+    std::size_t Size = (Mapping->Content->size() + 4095) / 4096 * 4096;
+    void* View = std::aligned_alloc(4096, Size ? Size : 4096);
+    if (View && !Mapping->Content->empty())
+    {
+        std::memcpy(View, Mapping->Content->data(), Mapping->Content->size());
+    }
+    return View;
+}
+
+BOOL WINAPI UnmapViewOfFile(
+    LPCVOID lpBaseAddress)
+{
+    std::free(const_cast<void*>(lpBaseAddress));
+    return TRUE;
+}
+
+BOOL WINAPI CloseHandle(
+    HANDLE hObject)
+{
+    PLVGL_WINDOWS_TESTS_FILE File =
+        reinterpret_cast<PLVGL_WINDOWS_TESTS_FILE>(hObject);
+    if (File->Stream)
+    {
+        std::fclose(File->Stream);
+    }
+    delete File->Content;
+    delete File;
+    return TRUE;
+}
+
+// GDI
+
+std::vector<RECT> g_LvglWindowsTestsBitBlts;
+
+std::atomic<std::size_t> g_LvglWindowsTestsSelectObjectCount(0);
+std::atomic<std::size_t> g_LvglWindowsTestsGlyphIndicesCount(0);
+std::atomic<std::size_t> g_LvglWindowsTestsGlyphOutlineCount(0);
+std::atomic<std::size_t> g_LvglWindowsTestsGdiObjectCount(0);
+
+namespace
+{
+    // The fonts and the fonts selected into the DCs, the font engine uses
+    // them from several threads. They are never destroyed, because the
+    // workers of the asynchronous fonts may still use them while the
+    // process exits.
+    std::mutex g_LvglWindowsTestsGdiLock;
+    std::map<HFONT, std::wstring>& g_LvglWindowsTestsFontNames =
+        *new std::map<HFONT, std::wstring>();
+    std::map<HDC, HFONT>& g_LvglWindowsTestsSelectedFonts =
+        *new std::map<HDC, HFONT>();
+
+    std::wstring LvglWindowsTestsGetFaceName(
+        HDC DCHandle)
+    {
+        std::lock_guard<std::mutex> Guard(g_LvglWindowsTestsGdiLock);
+        auto Selected = g_LvglWindowsTestsSelectedFonts.find(DCHandle);
+        if (Selected == g_LvglWindowsTestsSelectedFonts.end())
+        {
+            return std::wstring();
+        }
+        return g_LvglWindowsTestsFontNames[Selected->second];
+    }
+
+    bool LvglWindowsTestsHasFaceGlyph(
+        const std::wstring& FaceName,
+        std::uint32_t CodeUnit)
+    {
+        if (FaceName == LvglFontAwesome5FreeLvglFontName)
+        {
+            return ::LvglWindowsTestsHasSymbolGlyph(CodeUnit);
+        }
+        if (FaceName == LvglWindowsTestsFallbackFontName)
+        {
+            return ::LvglWindowsTestsHasFallbackGlyph(CodeUnit);
+        }
+        if (FaceName == LvglWindowsTestsCharacterMapFontName)
+        {
+            return CodeUnit >= 0x20 && CodeUnit <= 0x7E;
+        }
+        return ::LvglWindowsTestsHasGlyph(CodeUnit);
+    }
+}
+
+HDC WINAPI CreateCompatibleDC(
+    HDC hdc)
+{
+    UNREFERENCED_PARAMETER(hdc);
+    ++g_LvglWindowsTestsGdiObjectCount;
+    return ::LvglWindowsTestsCreateHandle<HDC>();
+}
+
+BOOL WINAPI DeleteDC(
+    HDC hdc)
+{
+    --g_LvglWindowsTestsGdiObjectCount;
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsTestsGdiLock);
+    g_LvglWindowsTestsSelectedFonts.erase(hdc);
+    return TRUE;
+}
+
+HGDIOBJ WINAPI SelectObject(
+    HDC hdc,
+    HGDIOBJ h)
+{
+    ++g_LvglWindowsTestsSelectObjectCount;
+
+    // Only the fonts are tracked, the other objects are not used.
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsTestsGdiLock);
+    HFONT FontHandle = reinterpret_cast<HFONT>(h);
+    if (g_LvglWindowsTestsFontNames.count(FontHandle))
+    {
+        g_LvglWindowsTestsSelectedFonts[hdc] = FontHandle;
+    }
+    return nullptr;
+}
+
+BOOL WINAPI DeleteObject(
+    HGDIOBJ ho)
+{
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsTestsGdiLock);
+    if (g_LvglWindowsTestsFontNames.erase(reinterpret_cast<HFONT>(ho)))
+    {
+        --g_LvglWindowsTestsGdiObjectCount;
+    }
+    return TRUE;
+}
+
+int WINAPI GetDeviceCaps(
+    HDC hdc,
+    int index)
+{
+    UNREFERENCED_PARAMETER(hdc);
+    UNREFERENCED_PARAMETER(index);
+    return USER_DEFAULT_SCREEN_DPI;
+}
+
+HBITMAP WINAPI CreateDIBSection(
+    HDC hdc,
+    const BITMAPINFO* pbmi,
+    UINT usage,
+    void** ppvBits,
+    HANDLE hSection,
+    DWORD offset)
+{
+    UNREFERENCED_PARAMETER(hdc);
+    UNREFERENCED_PARAMETER(pbmi);
+    UNREFERENCED_PARAMETER(usage);
+    UNREFERENCED_PARAMETER(hSection);
+    UNREFERENCED_PARAMETER(offset);
+    *ppvBits = nullptr;
+    return nullptr;
+}
+
+BOOL WINAPI BitBlt(
+    HDC hdc,
+    int x,
+    int y,
+    int cx,
+    int cy,
+    HDC hdcSrc,
+    int x1,
+    int y1,
+    DWORD rop)
+{
+    UNREFERENCED_PARAMETER(hdc);
+    UNREFERENCED_PARAMETER(hdcSrc);
+    UNREFERENCED_PARAMETER(x1);
+    UNREFERENCED_PARAMETER(y1);
+    UNREFERENCED_PARAMETER(rop);
+
+    RECT Rectangle;
+    Rectangle.left = x;
+    Rectangle.top = y;
+    Rectangle.right = x + cx;
+    Rectangle.bottom = y + cy;
+    g_LvglWindowsTestsBitBlts.push_back(Rectangle);
+    return TRUE;
+}
+
+BOOL WINAPI GdiFlush()
+{
+    return TRUE;
+}
+
+HFONT WINAPI CreateFontW(
+    int cHeight,
+    int cWidth,
+    int cEscapement,
+    int cOrientation,
+    int cWeight,
+    DWORD bItalic,
+    DWORD bUnderline,
+    DWORD bStrikeOut,
+    DWORD iCharSet,
+    DWORD iOutPrecision,
+    DWORD iClipPrecision,
+    DWORD iQuality,
+    DWORD iPitchAndFamily,
+    LPCWSTR pszFaceName)
+{
+    UNREFERENCED_PARAMETER(cHeight);
+    UNREFERENCED_PARAMETER(cWidth);
+    UNREFERENCED_PARAMETER(cEscapement);
+    UNREFERENCED_PARAMETER(cOrientation);
+    UNREFERENCED_PARAMETER(cWeight);
+    UNREFERENCED_PARAMETER(bItalic);
+    UNREFERENCED_PARAMETER(bUnderline);
+    UNREFERENCED_PARAMETER(bStrikeOut);
+    UNREFERENCED_PARAMETER(iCharSet);
+    UNREFERENCED_PARAMETER(iOutPrecision);
+    UNREFERENCED_PARAMETER(iClipPrecision);
+    UNREFERENCED_PARAMETER(iQuality);
+    UNREFERENCED_PARAMETER(iPitchAndFamily);
+
+    ++g_LvglWindowsTestsGdiObjectCount;
+    HFONT FontHandle = ::LvglWindowsTestsCreateHandle<HFONT>();
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsTestsGdiLock);
+    g_LvglWindowsTestsFontNames[FontHandle] = pszFaceName ? pszFaceName : L"";
+    return FontHandle;
+}
+
+HANDLE WINAPI AddFontMemResourceEx(
+    LPVOID pFileView,
+    DWORD cjSize,
+    LPVOID pvResrved,
+    DWORD* pNumFonts)
+{
+    UNREFERENCED_PARAMETER(pFileView);
+    UNREFERENCED_PARAMETER(cjSize);
+    UNREFERENCED_PARAMETER(pvResrved);
+    *pNumFonts = 1;
+    return ::LvglWindowsTestsCreateHandle<HANDLE>();
+}
+
+int WINAPI GetTextFaceW(
+    HDC hdc,
+    int c,
+    LPWSTR lpName)
+{
+    std::wstring FaceName = ::LvglWindowsTestsGetFaceName(hdc);
+    std::wcsncpy(lpName, FaceName.c_str(), c);
+    lpName[c - 1] = L'\0';
+    return static_cast<int>(std::wcslen(lpName)) + 1;
+}
+
+UINT WINAPI GetOutlineTextMetricsW(
+    HDC hdc,
+    UINT cjCopy,
+    OUTLINETEXTMETRICW* potm)
+{
+    UNREFERENCED_PARAMETER(hdc);
+    UNREFERENCED_PARAMETER(cjCopy);
+    std::memset(potm, 0, sizeof(*potm));
+    potm->otmSize = sizeof(*potm);
+    potm->otmAscent = 12;
+    potm->otmDescent = -3;
+    potm->otmsUnderscoreSize = 1;
+    potm->otmsUnderscorePosition = -2;
+    return sizeof(*potm);
+}
+
+DWORD WINAPI GetFontData(
+    HDC hdc,
+    DWORD dwTable,
+    DWORD dwOffset,
+    LPVOID pvBuffer,
+    DWORD cjBuffer)
+{
+    // Only the cmap table of the font with a character map, 'cmap' in the
+    // byte order of GetFontData.
+    if (dwTable != 0x70616D63 || ::LvglWindowsTestsGetFaceName(hdc)
+        != LvglWindowsTestsCharacterMapFontName)
+    {
+        return GDI_ERROR;
+    }
+
+    // A format 12 subtable for Windows Unicode full repertoire, with the
+    // groups of LvglWindowsTestsCharacterMapGroups.
+    std::vector<std::uint8_t> Table;
+    auto Append = [&Table](std::uint32_t Value, std::size_t Size)
+    {
+        for (std::size_t i = Size; i > 0; --i)
+        {
+            Table.push_back(static_cast<std::uint8_t>(Value >> (8 * (i - 1))));
+        }
+    };
+    const std::uint32_t GroupCount = static_cast<std::uint32_t>(
+        sizeof(LvglWindowsTestsCharacterMapGroups)
+        / sizeof(*LvglWindowsTestsCharacterMapGroups));
+    Append(0, 2);
+    Append(1, 2);
+    Append(3, 2);
+    Append(10, 2);
+    Append(12, 4);
+    Append(12, 2);
+    Append(0, 2);
+    Append(16 + 12 * GroupCount, 4);
+    Append(0, 4);
+    Append(GroupCount, 4);
+    for (const auto& Group : LvglWindowsTestsCharacterMapGroups)
+    {
+        Append(Group[0], 4);
+        Append(Group[1], 4);
+        Append(Group[2], 4);
+    }
+
+    if (dwOffset > Table.size())
+    {
+        return GDI_ERROR;
+    }
+    DWORD Size = static_cast<DWORD>(Table.size() - dwOffset);
+    if (!pvBuffer)
+    {
+        return Size;
+    }
+    Size = Size < cjBuffer ? Size : cjBuffer;
+    std::memcpy(pvBuffer, &Table[dwOffset], Size);
+    return Size;
+}
+
+DWORD WINAPI GetGlyphIndicesW(
+    HDC hdc,
+    LPCWSTR lpstr,
+    int c,
+    LPWORD pgi,
+    DWORD fl)
+{
+    UNREFERENCED_PARAMETER(fl);
+
+    ++g_LvglWindowsTestsGlyphIndicesCount;
+
+    // The glyph index is the code unit.
+    std::wstring FaceName = ::LvglWindowsTestsGetFaceName(hdc);
+    for (int i = 0; i < c; ++i)
+    {
+        std::uint32_t CodeUnit = static_cast<std::uint32_t>(lpstr[i]);
+        pgi[i] = ::LvglWindowsTestsHasFaceGlyph(FaceName, CodeUnit)
+            ? static_cast<WORD>(CodeUnit)
+            : 0xFFFF;
+    }
+    return c;
+}
+
+std::atomic<std::uint32_t> g_LvglWindowsTestsGlyphBitmapDelay(0);
+
+DWORD WINAPI GetGlyphOutlineW(
+    HDC hdc,
+    UINT uChar,
+    UINT fuFormat,
+    GLYPHMETRICS* lpgm,
+    DWORD cjBuffer,
+    LPVOID pvBuffer,
+    const MAT2* lpmat2)
+{
+    UNREFERENCED_PARAMETER(lpmat2);
+
+    ++g_LvglWindowsTestsGlyphOutlineCount;
+
+    std::uint32_t Width = 0;
+    std::uint32_t Height = 0;
+    ::LvglWindowsTestsGetGlyphBox(uChar, &Width, &Height);
+
+    lpgm->gmBlackBoxX = Width;
+    lpgm->gmBlackBoxY = Height;
+    lpgm->gmptGlyphOrigin.x = 1;
+    lpgm->gmptGlyphOrigin.y = static_cast<LONG>(Height);
+    lpgm->gmCellIncX = static_cast<short>(Width + 2);
+    lpgm->gmCellIncY = 0;
+
+    if ((fuFormat & ~GGO_GLYPH_INDEX) != GGO_GRAY8_BITMAP)
+    {
+        return 0;
+    }
+
+    // The rows of GGO_GRAY8_BITMAP are DWORD aligned, the padding is empty.
+    DWORD Pitch = (Width + 3) & ~3U;
+    DWORD Size = Pitch * Height;
+    if (pvBuffer)
+    {
+        if (cjBuffer < Size)
+        {
+            return GDI_ERROR;
+        }
+
+        // Busy like a rasterizer, the worker threads must not give the time
+        // back to the LVGL thread.
+        auto End = std::chrono::steady_clock::now()
+            + std::chrono::microseconds(g_LvglWindowsTestsGlyphBitmapDelay);
+        while (std::chrono::steady_clock::now() < End)
+        {
+        }
+
+        bool IsFallbackFace = ::LvglWindowsTestsGetFaceName(hdc)
+            == LvglWindowsTestsFallbackFontName;
+        std::uint8_t Level = IsFallbackFace
+            ? LvglWindowsTestsFallbackGlyphLevel
+            : ::LvglWindowsTestsGetGlyphLevel(uChar);
+        std::uint8_t* Row = reinterpret_cast<std::uint8_t*>(pvBuffer);
+        for (std::uint32_t y = 0; y < Height; ++y, Row += Pitch)
+        {
+            std::memset(Row, Level, Width);
+            std::memset(Row + Width, 0, Pitch - Width);
+        }
+    }
+    return Size;
+}
+
+std::vector<KERNINGPAIR> g_LvglWindowsTestsExtraKerningPairs;
+
+DWORD WINAPI GetKerningPairsW(
+    HDC hdc,
+    DWORD nPairs,
+    LPKERNINGPAIR lpKernPair)
+{
+    if (::LvglWindowsTestsGetFaceName(hdc)
+        == LvglFontAwesome5FreeLvglFontName)
+    {
+        return 0;
+    }
+
+    std::vector<KERNINGPAIR> Pairs(
+        LvglWindowsTestsKerningPairs,
+        LvglWindowsTestsKerningPairs
+        + sizeof(LvglWindowsTestsKerningPairs)
+        / sizeof(*LvglWindowsTestsKerningPairs));
+    Pairs.insert(
+        Pairs.end(),
+        g_LvglWindowsTestsExtraKerningPairs.begin(),
+        g_LvglWindowsTestsExtraKerningPairs.end());
+
+    DWORD PairCount = static_cast<DWORD>(Pairs.size());
+    if (!lpKernPair)
+    {
+        return PairCount;
+    }
+
+    PairCount = PairCount < nPairs ? PairCount : nPairs;
+    std::memcpy(lpKernPair, Pairs.data(), PairCount * sizeof(KERNINGPAIR));
+    return PairCount;
+}
+
+// User
+
+std::atomic<std::size_t> g_LvglWindowsTestsGetDCCount(0);
+
+HDC WINAPI GetDC(
+    HWND hWnd)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    ++g_LvglWindowsTestsGetDCCount;
+    return ::LvglWindowsTestsCreateHandle<HDC>();
+}
+
+int WINAPI ReleaseDC(
+    HWND hWnd,
+    HDC hDC)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(hDC);
+    return 1;
+}
+
+HMONITOR WINAPI MonitorFromWindow(
+    HWND hwnd,
+    DWORD dwFlags)
+{
+    UNREFERENCED_PARAMETER(hwnd);
+    UNREFERENCED_PARAMETER(dwFlags);
+    return nullptr;
+}
+
+BOOL WINAPI GetClientRect(
+    HWND hWnd,
+    RECT* lpRect)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    std::memset(lpRect, 0, sizeof(*lpRect));
+    return TRUE;
+}
+
+BOOL WINAPI ScreenToClient(
+    HWND hWnd,
+    POINT* lpPoint)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(lpPoint);
+    return TRUE;
+}
+
+BOOL WINAPI SetWindowPos(
+    HWND hWnd,
+    HWND hWndInsertAfter,
+    int X,
+    int Y,
+    int cx,
+    int cy,
+    UINT uFlags)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(hWndInsertAfter);
+    UNREFERENCED_PARAMETER(X);
+    UNREFERENCED_PARAMETER(Y);
+    UNREFERENCED_PARAMETER(cx);
+    UNREFERENCED_PARAMETER(cy);
+    UNREFERENCED_PARAMETER(uFlags);
+    return TRUE;
+}
+
+HICON WINAPI LoadIconW(
+    HINSTANCE hInstance,
+    LPCWSTR lpIconName)
+{
+    UNREFERENCED_PARAMETER(hInstance);
+    UNREFERENCED_PARAMETER(lpIconName);
+    return nullptr;
+}
+
+HCURSOR WINAPI LoadCursorW(
+    HINSTANCE hInstance,
+    LPCWSTR lpCursorName)
+{
+    UNREFERENCED_PARAMETER(hInstance);
+    UNREFERENCED_PARAMETER(lpCursorName);
+    return nullptr;
+}
+
+WORD WINAPI RegisterClassExW(
+    const WNDCLASSEXW* lpWndClass)
+{
+    UNREFERENCED_PARAMETER(lpWndClass);
+    return 0;
+}
+
+HWND WINAPI CreateWindowExW(
+    DWORD dwExStyle,
+    LPCWSTR lpClassName,
+    LPCWSTR lpWindowName,
+    DWORD dwStyle,
+    int X,
+    int Y,
+    int nWidth,
+    int nHeight,
+    HWND hWndParent,
+    HMENU hMenu,
+    HINSTANCE hInstance,
+    LPVOID lpParam)
+{
+    UNREFERENCED_PARAMETER(dwExStyle);
+    UNREFERENCED_PARAMETER(lpClassName);
+    UNREFERENCED_PARAMETER(lpWindowName);
+    UNREFERENCED_PARAMETER(dwStyle);
+    UNREFERENCED_PARAMETER(X);
+    UNREFERENCED_PARAMETER(Y);
+    UNREFERENCED_PARAMETER(nWidth);
+    UNREFERENCED_PARAMETER(nHeight);
+    UNREFERENCED_PARAMETER(hWndParent);
+    UNREFERENCED_PARAMETER(hMenu);
+    UNREFERENCED_PARAMETER(hInstance);
+    UNREFERENCED_PARAMETER(lpParam);
+    return nullptr;
+}
+
+BOOL WINAPI ShowWindow(
+    HWND hWnd,
+    int nCmdShow)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(nCmdShow);
+    return TRUE;
+}
+
+BOOL WINAPI UpdateWindow(
+    HWND hWnd)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    return TRUE;
+}
+
+LRESULT WINAPI DefWindowProcW(
+    HWND hWnd,
+    UINT Msg,
+    WPARAM wParam,
+    LPARAM lParam)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(Msg);
+    UNREFERENCED_PARAMETER(wParam);
+    UNREFERENCED_PARAMETER(lParam);
+    return 0;
+}
+
+void WINAPI PostQuitMessage(
+    int nExitCode)
+{
+    UNREFERENCED_PARAMETER(nExitCode);
+}
+
+BOOL WINAPI GetMessageW(
+    MSG* lpMsg,
+    HWND hWnd,
+    UINT wMsgFilterMin,
+    UINT wMsgFilterMax)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(wMsgFilterMin);
+    UNREFERENCED_PARAMETER(wMsgFilterMax);
+    std::memset(lpMsg, 0, sizeof(*lpMsg));
+    return FALSE;
+}
+
+BOOL WINAPI TranslateMessage(
+    const MSG* lpMsg)
+{
+    UNREFERENCED_PARAMETER(lpMsg);
+    return FALSE;
+}
+
+LRESULT WINAPI DispatchMessageW(
+    const MSG* lpMsg)
+{
+    UNREFERENCED_PARAMETER(lpMsg);
+    return 0;
+}
+
+// IMM
+
+HIMC WINAPI ImmGetContext(
+    HWND hWnd)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    return nullptr;
+}
+
+BOOL WINAPI ImmReleaseContext(
+    HWND hWnd,
+    HIMC hIMC)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(hIMC);
+    return TRUE;
+}
+
+HIMC WINAPI ImmAssociateContext(
+    HWND hWnd,
+    HIMC hIMC)
+{
+    UNREFERENCED_PARAMETER(hWnd);
+    UNREFERENCED_PARAMETER(hIMC);
+    return nullptr;
+}
+
+BOOL WINAPI ImmSetCompositionWindow(
+    HIMC hIMC,
+    COMPOSITIONFORM* lpCompForm)
+{
+    UNREFERENCED_PARAMETER(hIMC);
+    UNREFERENCED_PARAMETER(lpCompForm);
+    return TRUE;
+}
+
+// CRT
+
+void* _aligned_malloc(
+    std::size_t size,
+    std::size_t alignment)
+{
+    return std::aligned_alloc(
+        alignment,
+        (size + alignment - 1) / alignment * alignment);
+}
+
+void _aligned_free(
+    void* memblock)
+{
+    std::free(memblock);
+}
+
+// LVGL
+
+lv_disp_drv_t g_LvglWindowsTestsDisplayDriver;
+lv_disp_t g_LvglWindowsTestsDisplay = { &g_LvglWindowsTestsDisplayDriver };
+bool g_LvglWindowsTestsIsLastFlush = true;
+std::size_t g_LvglWindowsTestsFlushReadyCount = 0;
+std::size_t g_LvglWindowsTestsBlendBasicCount = 0;
+lv_timer_t g_LvglWindowsTestsTimer;
+
+const lv_obj_class_t lv_textarea_class = { nullptr };
+const lv_obj_class_t lv_keyboard_class = { nullptr };
+
+uint32_t lv_area_get_size(
+    const lv_area_t* area_p)
+{
+    return static_cast<uint32_t>(::lv_area_get_width(area_p))
+        * static_cast<uint32_t>(::lv_area_get_height(area_p));
+}
+
+bool _lv_area_intersect(
+    lv_area_t* res_p,
+    const lv_area_t* a1_p,
+    const lv_area_t* a2_p)
+{
+    res_p->x1 = LV_MAX(a1_p->x1, a2_p->x1);
+    res_p->y1 = LV_MAX(a1_p->y1, a2_p->y1);
+    res_p->x2 = LV_MIN(a1_p->x2, a2_p->x2);
+    res_p->y2 = LV_MIN(a1_p->y2, a2_p->y2);
+    return res_p->x1 <= res_p->x2 && res_p->y1 <= res_p->y2;
+}
+
+void _lv_area_join(
+    lv_area_t* a_res_p,
+    const lv_area_t* a1_p,
+    const lv_area_t* a2_p)
+{
+    a_res_p->x1 = LV_MIN(a1_p->x1, a2_p->x1);
+    a_res_p->y1 = LV_MIN(a1_p->y1, a2_p->y1);
+    a_res_p->x2 = LV_MAX(a1_p->x2, a2_p->x2);
+    a_res_p->y2 = LV_MAX(a1_p->y2, a2_p->y2);
+}
+
+uint32_t _lv_txt_encoded_next(
+    const char* txt,
+    uint32_t* i)
+{
+    // UTF-8, without the validation of LVGL.
+    const unsigned char* Text = reinterpret_cast<const unsigned char*>(txt);
+    uint32_t Index = i ? *i : 0;
+    uint32_t Result = Text[Index];
+    uint32_t Length = 1;
+    if (Result >= 0xF0)
+    {
+        Result &= 0x07;
+        Length = 4;
+    }
+    else if (Result >= 0xE0)
+    {
+        Result &= 0x0F;
+        Length = 3;
+    }
+    else if (Result >= 0xC0)
+    {
+        Result &= 0x1F;
+        Length = 2;
+    }
+    for (uint32_t j = 1; j < Length; ++j)
+    {
+        Result = (Result << 6) | (Text[Index + j] & 0x3F);
+    }
+    if (i && Text[Index])
+    {
+        *i = Index + Length;
+    }
+    return Result;
+}
+
+uint32_t _lv_txt_unicode_to_encoded(
+    uint32_t letter_uni)
+{
+    return letter_uni;
+}
+
+const lv_obj_class_t* lv_obj_get_class(
+    const lv_obj_t* obj)
+{
+    return obj->class_p;
+}
+
+lv_obj_t* lv_textarea_get_label(
+    const lv_obj_t* obj)
+{
+    return reinterpret_cast<const lv_textarea_t*>(obj)->label;
+}
+
+lv_obj_t* lv_keyboard_get_textarea(
+    const lv_obj_t* obj)
+{
+    UNREFERENCED_PARAMETER(obj);
+    return nullptr;
+}
+
+lv_group_t* lv_group_create(void)
+{
+    return nullptr;
+}
+
+void lv_group_set_default(
+    lv_group_t* group)
+{
+    UNREFERENCED_PARAMETER(group);
+}
+
+lv_obj_t* lv_group_get_focused(
+    const lv_group_t* group)
+{
+    UNREFERENCED_PARAMETER(group);
+    return nullptr;
+}
+
+lv_timer_t* lv_timer_create(
+    lv_timer_cb_t timer_xcb,
+    uint32_t period,
+    void* user_data)
+{
+    UNREFERENCED_PARAMETER(period);
+    g_LvglWindowsTestsTimer.timer_cb = timer_xcb;
+    g_LvglWindowsTestsTimer.user_data = user_data;
+    return &g_LvglWindowsTestsTimer;
+}
+
+void lv_timer_del(
+    lv_timer_t* timer)
+{
+    timer->timer_cb = nullptr;
+    timer->user_data = nullptr;
+}
+
+uint32_t lv_timer_handler(void)
+{
+    return 1;
+}
+
+void lv_init(void)
+{
+}
+
+void lv_disp_drv_init(
+    lv_disp_drv_t* driver)
+{
+    std::memset(driver, 0, sizeof(*driver));
+}
+
+lv_disp_t* lv_disp_drv_register(
+    lv_disp_drv_t* driver)
+{
+    UNREFERENCED_PARAMETER(driver);
+    return nullptr;
+}
+
+void lv_disp_drv_update(
+    lv_disp_t* disp,
+    lv_disp_drv_t* new_drv)
+{
+    UNREFERENCED_PARAMETER(disp);
+    UNREFERENCED_PARAMETER(new_drv);
+}
+
+void lv_disp_draw_buf_init(
+    lv_disp_draw_buf_t* draw_buf,
+    void* buf1,
+    void* buf2,
+    uint32_t size_in_px_cnt)
+{
+    draw_buf->buf1 = buf1;
+    draw_buf->buf2 = buf2;
+    draw_buf->size = size_in_px_cnt;
+}
+
+lv_disp_t* lv_disp_get_default(void)
+{
+    return nullptr;
+}
+
+lv_disp_t* lv_disp_get_next(
+    lv_disp_t* disp)
+{
+    return disp ? nullptr : &g_LvglWindowsTestsDisplay;
+}
+
+void lv_disp_flush_ready(
+    lv_disp_drv_t* disp_drv)
+{
+    UNREFERENCED_PARAMETER(disp_drv);
+    ++g_LvglWindowsTestsFlushReadyCount;
+}
+
+bool lv_disp_flush_is_last(
+    lv_disp_drv_t* disp_drv)
+{
+    UNREFERENCED_PARAMETER(disp_drv);
+    return g_LvglWindowsTestsIsLastFlush;
+}
+
+lv_disp_t* _lv_refr_get_disp_refreshing(void)
+{
+    return &g_LvglWindowsTestsDisplay;
+}
+
+std::vector<lv_area_t> g_LvglWindowsTestsInvalidatedAreas;
+
+void _lv_inv_area(
+    lv_disp_t* disp,
+    const lv_area_t* area_p)
+{
+    LVGL_WINDOWS_TESTS_CHECK(disp == &g_LvglWindowsTestsDisplay);
+    LVGL_WINDOWS_TESTS_CHECK(!disp->rendering_in_progress);
+    g_LvglWindowsTestsInvalidatedAreas.push_back(*area_p);
+}
+
+void lv_refr_now(
+    lv_disp_t* disp)
+{
+    UNREFERENCED_PARAMETER(disp);
+}
+
+void lv_indev_drv_init(
+    lv_indev_drv_t* driver)
+{
+    std::memset(driver, 0, sizeof(*driver));
+}
+
+lv_indev_t* lv_indev_drv_register(
+    lv_indev_drv_t* driver)
+{
+    UNREFERENCED_PARAMETER(driver);
+    return nullptr;
+}
+
+void lv_indev_set_group(
+    lv_indev_t* indev,
+    lv_group_t* group)
+{
+    UNREFERENCED_PARAMETER(indev);
+    UNREFERENCED_PARAMETER(group);
+}
+
+void lv_draw_sw_init_ctx(
+    lv_disp_drv_t* drv,
+    lv_draw_ctx_t* draw_ctx)
+{
+    UNREFERENCED_PARAMETER(drv);
+    std::memset(draw_ctx, 0, sizeof(lv_draw_sw_ctx_t));
+}
+
+void lv_draw_sw_blend_basic(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc)
+{
+    UNREFERENCED_PARAMETER(draw_ctx);
+    UNREFERENCED_PARAMETER(dsc);
+    ++g_LvglWindowsTestsBlendBasicCount;
+}
+
+void lv_draw_sw_wait_for_finish(
+    lv_draw_ctx_t* draw_ctx)
+{
+    UNREFERENCED_PARAMETER(draw_ctx);
+}
+
+void lv_demo_widgets(void)
+{
+}
+
+void lv_demo_keypad_encoder(void)
+{
+}
+
+void lv_demo_benchmark(void)
+{
+}
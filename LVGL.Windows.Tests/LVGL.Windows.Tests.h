@@ -0,0 +1,273 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Tests.h
+ * PURPOSE:   Definition for the LVGL ported to Windows tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS
+#define LVGL_WINDOWS_TESTS
+
+#include <Windows.h>
+
+#include "lvgl/lvgl.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief The count of the failed checks of the running test.
+*/
+extern std::size_t g_LvglWindowsTestsFailureCount;
+
+/**
+ * @brief Fails the running test if the condition is false, the test goes on.
+*/
+#define LVGL_WINDOWS_TESTS_CHECK(Condition) \
+    do \
+    { \
+        if (!(Condition)) \
+        { \
+            if (g_LvglWindowsTestsFailureCount++ < 16) \
+            { \
+                std::fprintf( \
+                    stderr, \
+                    "%s(%d): check failed: %s\n", \
+                    __FILE__, \
+                    __LINE__, \
+                    #Condition); \
+            } \
+        } \
+    } while (false)
+
+typedef struct _LVGL_WINDOWS_TESTS_CASE
+{
+    const char* Name;
+    void (*Function)();
+} LVGL_WINDOWS_TESTS_CASE, *PLVGL_WINDOWS_TESTS_CASE;
+
+/**
+ * @brief Runs the test named by the first argument, or all the tests without
+ *        arguments.
+ * @return The exit code of the test executable, 0 if the tests passed.
+*/
+int LvglWindowsTestsRun(
+    const LVGL_WINDOWS_TESTS_CASE* Cases,
+    std::size_t CaseCount,
+    int argc,
+    char** argv);
+
+/**
+ * @brief Runs the benchmarks like LvglWindowsTestsRun. With "Smoke" as the
+ *        first argument, all of them run with the repeat counts reduced to 1,
+ *        which only checks that they still work.
+ * @return The exit code of the benchmark executable.
+*/
+int LvglWindowsTestsRunBenchmarks(
+    const LVGL_WINDOWS_TESTS_CASE* Cases,
+    std::size_t CaseCount,
+    int argc,
+    char** argv);
+
+/**
+ * @brief Returns the repeat count of a benchmark, 1 for the smoke runs.
+*/
+std::size_t LvglWindowsTestsRepeatCount(
+    std::size_t RepeatCount);
+
+/**
+ * @brief A pseudorandom generator, the same sequence on all the platforms.
+*/
+std::uint32_t LvglWindowsTestsRandom();
+
+// The state of the fakes in LVGL.Windows.Tests.cpp.
+
+/**
+ * @brief The display returned by _lv_refr_get_disp_refreshing.
+*/
+extern lv_disp_t g_LvglWindowsTestsDisplay;
+
+/**
+ * @brief The display driver of g_LvglWindowsTestsDisplay.
+*/
+extern lv_disp_drv_t g_LvglWindowsTestsDisplayDriver;
+
+/**
+ * @brief Returned by lv_disp_flush_is_last.
+*/
+extern bool g_LvglWindowsTestsIsLastFlush;
+
+/**
+ * @brief The count of lv_disp_flush_ready calls.
+*/
+extern std::size_t g_LvglWindowsTestsFlushReadyCount;
+
+/**
+ * @brief The count of lv_draw_sw_blend_basic calls.
+*/
+extern std::size_t g_LvglWindowsTestsBlendBasicCount;
+
+/**
+ * @brief The areas copied by BitBlt, in the order of the calls.
+*/
+extern std::vector<RECT> g_LvglWindowsTestsBitBlts;
+
+/**
+ * @brief The areas passed to _lv_inv_area, in the order of the calls.
+*/
+extern std::vector<lv_area_t> g_LvglWindowsTestsInvalidatedAreas;
+
+/**
+ * @brief The count of GetDC calls.
+*/
+extern std::atomic<std::size_t> g_LvglWindowsTestsGetDCCount;
+
+/**
+ * @brief The count of SelectObject calls.
+*/
+extern std::atomic<std::size_t> g_LvglWindowsTestsSelectObjectCount;
+
+/**
+ * @brief The count of GetGlyphIndicesW calls.
+*/
+extern std::atomic<std::size_t> g_LvglWindowsTestsGlyphIndicesCount;
+
+/**
+ * @brief The count of GetGlyphOutlineW calls, one or more for each glyph
+ *        rasterized by the font engine.
+*/
+extern std::atomic<std::size_t> g_LvglWindowsTestsGlyphOutlineCount;
+
+/**
+ * @brief The microseconds GetGlyphOutlineW spends on each bitmap it writes,
+ *        for the benchmarks which need the cost of a real rasterizer.
+*/
+extern std::atomic<std::uint32_t> g_LvglWindowsTestsGlyphBitmapDelay;
+
+/**
+ * @brief The count of the fonts and the memory DCs created by the GDI fake
+ *        and not deleted yet.
+*/
+extern std::atomic<std::size_t> g_LvglWindowsTestsGdiObjectCount;
+
+/**
+ * @brief The last timer created by lv_timer_create.
+*/
+extern lv_timer_t g_LvglWindowsTestsTimer;
+
+/**
+ * @brief The GDI fake gives the glyph index of the code units below this
+ *        value, except for the ones which are 5 modulo 97.
+*/
+const std::uint32_t LvglWindowsTestsGlyphLimit = 0xA000;
+
+/**
+ * @brief Returns whether the GDI fake has a glyph for the code unit.
+*/
+inline bool LvglWindowsTestsHasGlyph(
+    std::uint32_t CodeUnit)
+{
+    return CodeUnit < LvglWindowsTestsGlyphLimit && CodeUnit % 97 != 5;
+}
+
+/**
+ * @brief Returns whether the GDI fake has a glyph for the code unit in the
+ *        built-in symbol font, which has the private use code units from
+ *        U+F000 to U+F8FF.
+*/
+inline bool LvglWindowsTestsHasSymbolGlyph(
+    std::uint32_t CodeUnit)
+{
+    return CodeUnit >= 0xF000 && CodeUnit <= 0xF8FF;
+}
+
+/**
+ * @brief The kerning pairs of the fonts of the GDI fake other than the
+ *        built-in symbol font.
+*/
+const KERNINGPAIR LvglWindowsTestsKerningPairs[] =
+{
+    { L'A', L'V', -2 },
+    // U+F001 is drawn with the built-in symbol font.
+    { L'A', 0xF001, -5 },
+};
+
+/**
+ * @brief The kerning pairs the fonts of the GDI fake have after
+ *        LvglWindowsTestsKerningPairs, for the benchmarks which need the
+ *        pair count of a real font.
+*/
+extern std::vector<KERNINGPAIR> g_LvglWindowsTestsExtraKerningPairs;
+
+/**
+ * @brief The name of the fallback font of the GDI fake.
+*/
+const wchar_t LvglWindowsTestsFallbackFontName[] = L"LVGL Tests Fallback";
+
+/**
+ * @brief Returns whether the GDI fake has a glyph for the code unit in the
+ *        fallback font, which has the code units below U+A000 missing from
+ *        the other fonts, the code units from U+A000 to U+AFFF and the first
+ *        16 symbols of the built-in symbol font.
+*/
+inline bool LvglWindowsTestsHasFallbackGlyph(
+    std::uint32_t CodeUnit)
+{
+    return (CodeUnit < LvglWindowsTestsGlyphLimit && CodeUnit % 97 == 5)
+        || (CodeUnit >= 0xA000 && CodeUnit <= 0xAFFF)
+        || (CodeUnit >= 0xF000 && CodeUnit <= 0xF00F);
+}
+
+/**
+ * @brief The 65 level coverage of every pixel of the glyphs of the fallback
+ *        font, which tells them apart from the glyphs of the other fonts.
+*/
+const std::uint8_t LvglWindowsTestsFallbackGlyphLevel = 64;
+
+/**
+ * @brief The name of the font of the GDI fake with a cmap table, the other
+ *        fonts have none. GetGlyphIndicesW gives the glyph indexes of the
+ *        code units from U+0020 to U+007E for it.
+*/
+const wchar_t LvglWindowsTestsCharacterMapFontName[] = L"LVGL Tests Cmap";
+
+/**
+ * @brief The groups of the format 12 cmap subtable of the font with a cmap
+ *        table: the first and the last code points and the first glyph
+ *        index.
+*/
+const std::uint32_t LvglWindowsTestsCharacterMapGroups[][3] =
+{
+    { 0x20, 0x7E, 0x20 },
+    { 0x1F600, 0x1F64F, 0x1000 },
+    { 0x20000, 0x20000, 0x2000 },
+};
+
+/**
+ * @brief The box of a glyph rasterized by the GDI fake, whatever the size.
+*/
+inline void LvglWindowsTestsGetGlyphBox(
+    std::uint32_t GlyphIndex,
+    std::uint32_t* Width,
+    std::uint32_t* Height)
+{
+    *Width = 3 + GlyphIndex % 9;
+    *Height = 4 + GlyphIndex % 7;
+}
+
+/**
+ * @brief The 65 level coverage of every pixel of a glyph rasterized by the
+ *        GDI fake.
+*/
+inline std::uint8_t LvglWindowsTestsGetGlyphLevel(
+    std::uint32_t GlyphIndex)
+{
+    return static_cast<std::uint8_t>(GlyphIndex % 65);
+}
+
+#endif // !LVGL_WINDOWS_TESTS
@@ -0,0 +1,495 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      Windows.h
+ * PURPOSE:   Definition for the subset of the Windows API used by the tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS_STUBS_WINDOWS
+#define LVGL_WINDOWS_TESTS_STUBS_WINDOWS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+
+// The functions are implemented by LVGL.Windows.Tests.Fakes.cpp.
+
+#define WINAPI
+#define CALLBACK
+#define EXTERN_C extern "C"
+
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _In_reads_(x)
+#define _In_reads_opt_(x)
+#define _In_reads_bytes_(x)
+#define _Out_writes_(x)
+#define _Out_writes_opt_(x)
+#define _Out_writes_bytes_(x)
+
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+
+typedef int BOOL;
+typedef int INT;
+typedef unsigned int UINT;
+typedef unsigned int UINT32;
+typedef long LONG;
+typedef unsigned long ULONG;
+typedef unsigned long DWORD;
+typedef unsigned short WORD;
+typedef unsigned char BYTE;
+typedef std::int64_t LONGLONG;
+typedef std::uint64_t ULONGLONG;
+typedef std::uint64_t DWORDLONG;
+typedef std::size_t SIZE_T;
+typedef std::uintptr_t ULONG_PTR;
+typedef std::uintptr_t WPARAM;
+typedef std::intptr_t LPARAM;
+typedef std::intptr_t LRESULT;
+typedef long HRESULT;
+typedef wchar_t WCHAR;
+typedef wchar_t* LPWSTR;
+typedef const wchar_t* LPCWSTR;
+typedef const char* LPCSTR;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef WORD* LPWORD;
+typedef DWORD* LPDWORD;
+
+typedef void* HANDLE;
+typedef void* HGDIOBJ;
+typedef struct HBITMAP__* HBITMAP;
+typedef struct HBRUSH__* HBRUSH;
+typedef struct HCURSOR__* HCURSOR;
+typedef struct HDC__* HDC;
+typedef struct HFONT__* HFONT;
+typedef struct HICON__* HICON;
+typedef struct HIMC__* HIMC;
+typedef struct HINSTANCE__* HINSTANCE;
+typedef HINSTANCE HMODULE;
+typedef struct HMENU__* HMENU;
+typedef struct HMONITOR__* HMONITOR;
+typedef struct HTOUCHINPUT__* HTOUCHINPUT;
+typedef struct HWND__* HWND;
+typedef std::intptr_t(WINAPI* FARPROC)();
+
+#define TRUE 1
+#define FALSE 0
+#define INFINITE 0xFFFFFFFF
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(-1))
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+
+#define LOWORD(l) ((WORD)(((ULONG_PTR)(l)) & 0xffff))
+#define HIWORD(l) ((WORD)((((ULONG_PTR)(l)) >> 16) & 0xffff))
+#define MAKEINTRESOURCE(i) (reinterpret_cast<LPCWSTR>((ULONG_PTR)((WORD)(i))))
+#define IS_HIGH_SURROGATE(wch) (((wch) >= 0xd800) && ((wch) <= 0xdbff))
+#define IS_LOW_SURROGATE(wch) (((wch) >= 0xdc00) && ((wch) <= 0xdfff))
+
+#define PF_XMMI64_INSTRUCTIONS_AVAILABLE 10
+
+#define GENERIC_READ 0x80000000L
+#define GENERIC_WRITE 0x40000000L
+#define FILE_SHARE_READ 0x00000001
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define FILE_ATTRIBUTE_NORMAL 0x00000080
+#define PAGE_READONLY 0x02
+#define FILE_MAP_READ 0x0004
+
+#define GDI_ERROR 0xFFFFFFFFL
+#define LF_FACESIZE 32
+#define FW_NORMAL 400
+#define DEFAULT_CHARSET 1
+#define OUT_DEFAULT_PRECIS 0
+#define CLIP_DEFAULT_PRECIS 0
+#define ANTIALIASED_QUALITY 4
+#define CLEARTYPE_NATURAL_QUALITY 6
+#define FF_DONTCARE 0
+#define GGO_METRICS 0
+#define GGO_GRAY8_BITMAP 6
+#define GGO_GLYPH_INDEX 0x0080
+#define GGI_MARK_NONEXISTING_GLYPHS 0x0001
+#define SRCCOPY 0x00CC0020
+#define DIB_RGB_COLORS 0
+#define BI_RGB 0
+#define LOGPIXELSX 88
+#define USER_DEFAULT_SCREEN_DPI 96
+#define MONITOR_DEFAULTTONEAREST 0x00000002
+
+#define VER_MINORVERSION 0x0000001
+#define VER_MAJORVERSION 0x0000002
+#define VER_BUILDNUMBER 0x0000004
+#define VER_GREATER_EQUAL 3
+#define VER_LESS 4
+
+#define WS_EX_CLIENTEDGE 0x00000200L
+#define WS_OVERLAPPEDWINDOW 0x00CF0000L
+#define CW_USEDEFAULT ((int)0x80000000)
+#define COLOR_WINDOW 5
+#define IDC_ARROW MAKEINTRESOURCE(32512)
+#define SIZE_MINIMIZED 1
+#define SWP_NOZORDER 0x0004
+#define SWP_NOACTIVATE 0x0010
+#define CFS_POINT 0x0002
+#define WHEEL_DELTA 120
+#define GET_WHEEL_DELTA_WPARAM(wParam) ((short)HIWORD(wParam))
+#define TOUCHEVENTF_MOVE 0x0001
+#define TOUCHEVENTF_DOWN 0x0002
+#define TOUCH_COORD_TO_PIXEL(l) ((l) / 100)
+
+#define WM_CREATE 0x0001
+#define WM_DESTROY 0x0002
+#define WM_SIZE 0x0005
+#define WM_KEYDOWN 0x0100
+#define WM_KEYUP 0x0101
+#define WM_CHAR 0x0102
+#define WM_IME_STARTCOMPOSITION 0x010D
+#define WM_MOUSEMOVE 0x0200
+#define WM_LBUTTONDOWN 0x0201
+#define WM_LBUTTONUP 0x0202
+#define WM_MBUTTONDOWN 0x0207
+#define WM_MBUTTONUP 0x0208
+#define WM_MOUSEWHEEL 0x020A
+#define WM_TOUCH 0x0240
+#define WM_IME_SETCONTEXT 0x0281
+#define WM_DPICHANGED 0x02E0
+
+#define VK_BACK 0x08
+#define VK_RETURN 0x0D
+#define VK_ESCAPE 0x1B
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_DELETE 0x2E
+
+typedef union _LARGE_INTEGER
+{
+    LONGLONG QuadPart;
+} LARGE_INTEGER, *PLARGE_INTEGER;
+
+typedef struct tagPOINT
+{
+    LONG x;
+    LONG y;
+} POINT, *PPOINT;
+
+typedef struct tagRECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+} RECT, *PRECT;
+
+typedef struct _FIXED
+{
+    WORD fract;
+    short value;
+} FIXED;
+
+typedef struct _MAT2
+{
+    FIXED eM11;
+    FIXED eM12;
+    FIXED eM21;
+    FIXED eM22;
+} MAT2;
+
+typedef struct _GLYPHMETRICS
+{
+    UINT gmBlackBoxX;
+    UINT gmBlackBoxY;
+    POINT gmptGlyphOrigin;
+    short gmCellIncX;
+    short gmCellIncY;
+} GLYPHMETRICS;
+
+typedef struct tagTEXTMETRICW
+{
+    LONG tmHeight;
+    LONG tmAscent;
+    LONG tmDescent;
+} TEXTMETRICW;
+
+typedef struct _OUTLINETEXTMETRICW
+{
+    UINT otmSize;
+    TEXTMETRICW otmTextMetrics;
+    int otmAscent;
+    int otmDescent;
+    UINT otmLineGap;
+    UINT otmEMSquare;
+    int otmsUnderscoreSize;
+    int otmsUnderscorePosition;
+} OUTLINETEXTMETRICW;
+
+typedef struct tagKERNINGPAIR
+{
+    WORD wFirst;
+    WORD wSecond;
+    int iKernAmount;
+} KERNINGPAIR, *LPKERNINGPAIR;
+
+typedef struct tagBITMAPINFOHEADER
+{
+    DWORD biSize;
+    LONG biWidth;
+    LONG biHeight;
+    WORD biPlanes;
+    WORD biBitCount;
+    DWORD biCompression;
+} BITMAPINFOHEADER;
+
+typedef struct tagBITMAPINFO
+{
+    BITMAPINFOHEADER bmiHeader;
+} BITMAPINFO;
+
+typedef struct _OSVERSIONINFOEXW
+{
+    DWORD dwOSVersionInfoSize;
+    DWORD dwMajorVersion;
+    DWORD dwMinorVersion;
+    DWORD dwBuildNumber;
+} OSVERSIONINFOEXW;
+
+typedef struct tagTOUCHINPUT
+{
+    LONG x;
+    LONG y;
+    DWORD dwFlags;
+} TOUCHINPUT, *PTOUCHINPUT;
+
+typedef struct tagCOMPOSITIONFORM
+{
+    DWORD dwStyle;
+    POINT ptCurrentPos;
+} COMPOSITIONFORM;
+
+typedef struct tagMSG
+{
+    HWND hwnd;
+    UINT message;
+    WPARAM wParam;
+    LPARAM lParam;
+} MSG;
+
+typedef LRESULT(CALLBACK* WNDPROC)(HWND, UINT, WPARAM, LPARAM);
+
+typedef struct tagWNDCLASSEXW
+{
+    UINT cbSize;
+    UINT style;
+    WNDPROC lpfnWndProc;
+    int cbClsExtra;
+    int cbWndExtra;
+    HINSTANCE hInstance;
+    HICON hIcon;
+    HCURSOR hCursor;
+    HBRUSH hbrBackground;
+    LPCWSTR lpszMenuName;
+    LPCWSTR lpszClassName;
+    HICON hIconSm;
+} WNDCLASSEXW;
+
+// Kernel
+
+BOOL WINAPI IsProcessorFeaturePresent(DWORD ProcessorFeature);
+void WINAPI Sleep(DWORD dwMilliseconds);
+HMODULE WINAPI LoadLibraryW(LPCWSTR lpLibFileName);
+HMODULE WINAPI GetModuleHandleW(LPCWSTR lpModuleName);
+FARPROC WINAPI GetProcAddress(HMODULE hModule, LPCSTR lpProcName);
+BOOL WINAPI FreeLibrary(HMODULE hLibModule);
+BOOL WINAPI VerifyVersionInfoW(
+    OSVERSIONINFOEXW* lpVersionInformation,
+    DWORD dwTypeMask,
+    DWORDLONG dwlConditionMask);
+DWORDLONG WINAPI VerSetConditionMask(
+    DWORDLONG ConditionMask,
+    DWORD TypeMask,
+    BYTE Condition);
+HANDLE WINAPI CreateFileW(
+    LPCWSTR lpFileName,
+    DWORD dwDesiredAccess,
+    DWORD dwShareMode,
+    LPVOID lpSecurityAttributes,
+    DWORD dwCreationDisposition,
+    DWORD dwFlagsAndAttributes,
+    HANDLE hTemplateFile);
+BOOL WINAPI GetFileSizeEx(HANDLE hFile, PLARGE_INTEGER lpFileSize);
+BOOL WINAPI WriteFile(
+    HANDLE hFile,
+    LPCVOID lpBuffer,
+    DWORD nNumberOfBytesToWrite,
+    LPDWORD lpNumberOfBytesWritten,
+    LPVOID lpOverlapped);
+HANDLE WINAPI CreateFileMappingW(
+    HANDLE hFile,
+    LPVOID lpFileMappingAttributes,
+    DWORD flProtect,
+    DWORD dwMaximumSizeHigh,
+    DWORD dwMaximumSizeLow,
+    LPCWSTR lpName);
+LPVOID WINAPI MapViewOfFile(
+    HANDLE hFileMappingObject,
+    DWORD dwDesiredAccess,
+    DWORD dwFileOffsetHigh,
+    DWORD dwFileOffsetLow,
+    SIZE_T dwNumberOfBytesToMap);
+BOOL WINAPI UnmapViewOfFile(LPCVOID lpBaseAddress);
+BOOL WINAPI CloseHandle(HANDLE hObject);
+
+// GDI
+
+HDC WINAPI CreateCompatibleDC(HDC hdc);
+BOOL WINAPI DeleteDC(HDC hdc);
+HGDIOBJ WINAPI SelectObject(HDC hdc, HGDIOBJ h);
+BOOL WINAPI DeleteObject(HGDIOBJ ho);
+int WINAPI GetDeviceCaps(HDC hdc, int index);
+HBITMAP WINAPI CreateDIBSection(
+    HDC hdc,
+    const BITMAPINFO* pbmi,
+    UINT usage,
+    void** ppvBits,
+    HANDLE hSection,
+    DWORD offset);
+BOOL WINAPI BitBlt(
+    HDC hdc,
+    int x,
+    int y,
+    int cx,
+    int cy,
+    HDC hdcSrc,
+    int x1,
+    int y1,
+    DWORD rop);
+BOOL WINAPI GdiFlush();
+HFONT WINAPI CreateFontW(
+    int cHeight,
+    int cWidth,
+    int cEscapement,
+    int cOrientation,
+    int cWeight,
+    DWORD bItalic,
+    DWORD bUnderline,
+    DWORD bStrikeOut,
+    DWORD iCharSet,
+    DWORD iOutPrecision,
+    DWORD iClipPrecision,
+    DWORD iQuality,
+    DWORD iPitchAndFamily,
+    LPCWSTR pszFaceName);
+HANDLE WINAPI AddFontMemResourceEx(
+    LPVOID pFileView,
+    DWORD cjSize,
+    LPVOID pvResrved,
+    DWORD* pNumFonts);
+int WINAPI GetTextFaceW(HDC hdc, int c, LPWSTR lpName);
+UINT WINAPI GetOutlineTextMetricsW(
+    HDC hdc,
+    UINT cjCopy,
+    OUTLINETEXTMETRICW* potm);
+DWORD WINAPI GetFontData(
+    HDC hdc,
+    DWORD dwTable,
+    DWORD dwOffset,
+    LPVOID pvBuffer,
+    DWORD cjBuffer);
+DWORD WINAPI GetGlyphIndicesW(
+    HDC hdc,
+    LPCWSTR lpstr,
+    int c,
+    LPWORD pgi,
+    DWORD fl);
+DWORD WINAPI GetGlyphOutlineW(
+    HDC hdc,
+    UINT uChar,
+    UINT fuFormat,
+    GLYPHMETRICS* lpgm,
+    DWORD cjBuffer,
+    LPVOID pvBuffer,
+    const MAT2* lpmat2);
+DWORD WINAPI GetKerningPairsW(
+    HDC hdc,
+    DWORD nPairs,
+    LPKERNINGPAIR lpKernPair);
+
+// User
+
+HDC WINAPI GetDC(HWND hWnd);
+int WINAPI ReleaseDC(HWND hWnd, HDC hDC);
+HMONITOR WINAPI MonitorFromWindow(HWND hwnd, DWORD dwFlags);
+BOOL WINAPI GetClientRect(HWND hWnd, RECT* lpRect);
+BOOL WINAPI ScreenToClient(HWND hWnd, POINT* lpPoint);
+BOOL WINAPI SetWindowPos(
+    HWND hWnd,
+    HWND hWndInsertAfter,
+    int X,
+    int Y,
+    int cx,
+    int cy,
+    UINT uFlags);
+HICON WINAPI LoadIconW(HINSTANCE hInstance, LPCWSTR lpIconName);
+HCURSOR WINAPI LoadCursorW(HINSTANCE hInstance, LPCWSTR lpCursorName);
+WORD WINAPI RegisterClassExW(const WNDCLASSEXW* lpWndClass);
+HWND WINAPI CreateWindowExW(
+    DWORD dwExStyle,
+    LPCWSTR lpClassName,
+    LPCWSTR lpWindowName,
+    DWORD dwStyle,
+    int X,
+    int Y,
+    int nWidth,
+    int nHeight,
+    HWND hWndParent,
+    HMENU hMenu,
+    HINSTANCE hInstance,
+    LPVOID lpParam);
+BOOL WINAPI ShowWindow(HWND hWnd, int nCmdShow);
+BOOL WINAPI UpdateWindow(HWND hWnd);
+LRESULT WINAPI DefWindowProcW(
+    HWND hWnd,
+    UINT Msg,
+    WPARAM wParam,
+    LPARAM lParam);
+void WINAPI PostQuitMessage(int nExitCode);
+BOOL WINAPI GetMessageW(
+    MSG* lpMsg,
+    HWND hWnd,
+    UINT wMsgFilterMin,
+    UINT wMsgFilterMax);
+BOOL WINAPI TranslateMessage(const MSG* lpMsg);
+LRESULT WINAPI DispatchMessageW(const MSG* lpMsg);
+BOOL WINAPI RegisterTouchWindow(HWND hwnd, ULONG ulFlags);
+BOOL WINAPI GetTouchInputInfo(
+    HTOUCHINPUT hTouchInput,
+    UINT cInputs,
+    PTOUCHINPUT pInputs,
+    int cbSize);
+BOOL WINAPI CloseTouchInputHandle(HTOUCHINPUT hTouchInput);
+
+// IMM
+
+HIMC WINAPI ImmGetContext(HWND hWnd);
+BOOL WINAPI ImmReleaseContext(HWND hWnd, HIMC hIMC);
+HIMC WINAPI ImmAssociateContext(HWND hWnd, HIMC hIMC);
+BOOL WINAPI ImmSetCompositionWindow(HIMC hIMC, COMPOSITIONFORM* lpCompForm);
+
+// CRT
+
+void* _aligned_malloc(std::size_t size, std::size_t alignment);
+void _aligned_free(void* memblock);
+
+#endif // !LVGL_WINDOWS_TESTS_STUBS_WINDOWS
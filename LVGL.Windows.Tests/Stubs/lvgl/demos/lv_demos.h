@@ -0,0 +1,28 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      lv_demos.h
+ * PURPOSE:   Definition for the subset of the LVGL 8.3 demos used by the tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS_STUBS_LV_DEMOS
+#define LVGL_WINDOWS_TESTS_STUBS_LV_DEMOS
+
+#include "../lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void lv_demo_widgets(void);
+void lv_demo_keypad_encoder(void);
+void lv_demo_benchmark(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // !LVGL_WINDOWS_TESTS_STUBS_LV_DEMOS
@@ -0,0 +1,409 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      lvgl.h
+ * PURPOSE:   Definition for the subset of LVGL 8.3 used by the tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS_STUBS_LVGL
+#define LVGL_WINDOWS_TESTS_STUBS_LVGL
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The configuration of lv_conf.h which the tested code depends on.
+
+#define LV_COLOR_DEPTH 32
+#define LV_COLOR_MIX_ROUND_OFS 0
+#define LV_DPI_DEF 130
+#define LV_DRAW_COMPLEX 1
+#define LV_USE_FONT_SUBPX 1
+#define LV_FONT_SUBPX_BGR 0
+#define LV_INV_BUF_SIZE 32
+#ifndef LV_USE_FREETYPE
+#define LV_USE_FREETYPE 0
+#endif
+
+// The functions are implemented by LVGL.Windows.Tests.Fakes.cpp.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LV_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define LV_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define LV_UDIV255(x) (((x) * 0x8081U) >> 0x17)
+
+typedef int16_t lv_coord_t;
+typedef uint8_t lv_opa_t;
+
+enum
+{
+    LV_OPA_TRANSP = 0,
+    LV_OPA_COVER = 255,
+};
+
+#define LV_OPA_MIN 2
+#define LV_OPA_MAX 253
+
+typedef union
+{
+    struct
+    {
+        uint8_t blue;
+        uint8_t green;
+        uint8_t red;
+        uint8_t alpha;
+    } ch;
+    uint32_t full;
+} lv_color32_t;
+
+typedef lv_color32_t lv_color_t;
+
+static inline lv_color_t lv_color_mix(
+    lv_color_t c1,
+    lv_color_t c2,
+    uint8_t mix)
+{
+    lv_color_t ret;
+    ret.ch.red = LV_UDIV255((uint16_t)c1.ch.red * mix
+        + c2.ch.red * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.green = LV_UDIV255((uint16_t)c1.ch.green * mix
+        + c2.ch.green * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.blue = LV_UDIV255((uint16_t)c1.ch.blue * mix
+        + c2.ch.blue * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    ret.ch.alpha = 0xFF;
+    return ret;
+}
+
+typedef struct
+{
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;
+    lv_coord_t y2;
+} lv_area_t;
+
+typedef struct
+{
+    lv_coord_t x;
+    lv_coord_t y;
+} lv_point_t;
+
+static inline lv_coord_t lv_area_get_width(const lv_area_t* area_p)
+{
+    return (lv_coord_t)(area_p->x2 - area_p->x1 + 1);
+}
+
+static inline lv_coord_t lv_area_get_height(const lv_area_t* area_p)
+{
+    return (lv_coord_t)(area_p->y2 - area_p->y1 + 1);
+}
+
+uint32_t lv_area_get_size(const lv_area_t* area_p);
+bool _lv_area_intersect(
+    lv_area_t* res_p,
+    const lv_area_t* a1_p,
+    const lv_area_t* a2_p);
+void _lv_area_join(
+    lv_area_t* a_res_p,
+    const lv_area_t* a1_p,
+    const lv_area_t* a2_p);
+
+// Fonts
+
+struct _lv_font_t;
+
+typedef struct
+{
+    const struct _lv_font_t* resolved_font;
+    uint16_t adv_w;
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint8_t bpp : 4;
+    uint8_t is_placeholder : 1;
+} lv_font_glyph_dsc_t;
+
+enum
+{
+    LV_FONT_SUBPX_NONE,
+    LV_FONT_SUBPX_HOR,
+    LV_FONT_SUBPX_VER,
+    LV_FONT_SUBPX_BOTH,
+};
+
+typedef struct _lv_font_t
+{
+    bool (*get_glyph_dsc)(
+        const struct _lv_font_t*,
+        lv_font_glyph_dsc_t*,
+        uint32_t letter,
+        uint32_t letter_next);
+    const uint8_t* (*get_glyph_bitmap)(const struct _lv_font_t*, uint32_t);
+    lv_coord_t line_height;
+    lv_coord_t base_line;
+    uint8_t subpx : 2;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    const void* dsc;
+    const struct _lv_font_t* fallback;
+    void* user_data;
+} lv_font_t;
+
+uint32_t _lv_txt_encoded_next(const char* txt, uint32_t* i);
+uint32_t _lv_txt_unicode_to_encoded(uint32_t letter_uni);
+
+// Objects
+
+typedef struct _lv_obj_class_t
+{
+    const struct _lv_obj_class_t* base_class;
+} lv_obj_class_t;
+
+typedef struct _lv_obj_t
+{
+    const lv_obj_class_t* class_p;
+    lv_area_t coords;
+} lv_obj_t;
+
+typedef struct
+{
+    lv_obj_t obj;
+    lv_obj_t* label;
+    struct
+    {
+        lv_area_t area;
+    } cursor;
+} lv_textarea_t;
+
+extern const lv_obj_class_t lv_textarea_class;
+extern const lv_obj_class_t lv_keyboard_class;
+
+const lv_obj_class_t* lv_obj_get_class(const lv_obj_t* obj);
+lv_obj_t* lv_textarea_get_label(const lv_obj_t* obj);
+lv_obj_t* lv_keyboard_get_textarea(const lv_obj_t* obj);
+
+typedef struct _lv_group_t lv_group_t;
+
+lv_group_t* lv_group_create(void);
+void lv_group_set_default(lv_group_t* group);
+lv_obj_t* lv_group_get_focused(const lv_group_t* group);
+
+// Timers
+
+struct _lv_timer_t;
+
+typedef void (*lv_timer_cb_t)(struct _lv_timer_t*);
+
+typedef struct _lv_timer_t
+{
+    lv_timer_cb_t timer_cb;
+    void* user_data;
+} lv_timer_t;
+
+lv_timer_t* lv_timer_create(
+    lv_timer_cb_t timer_xcb,
+    uint32_t period,
+    void* user_data);
+void lv_timer_del(lv_timer_t* timer);
+uint32_t lv_timer_handler(void);
+
+// Displays
+
+struct _lv_disp_drv_t;
+struct _lv_draw_ctx_t;
+
+typedef struct
+{
+    void* buf1;
+    void* buf2;
+    uint32_t size;
+} lv_disp_draw_buf_t;
+
+typedef struct _lv_disp_drv_t
+{
+    lv_coord_t hor_res;
+    lv_coord_t ver_res;
+    lv_disp_draw_buf_t* draw_buf;
+    uint32_t direct_mode : 1;
+    uint32_t full_refresh : 1;
+    uint32_t antialiasing : 1;
+    uint32_t screen_transp : 1;
+    void (*flush_cb)(
+        struct _lv_disp_drv_t* disp_drv,
+        const lv_area_t* area,
+        lv_color_t* color_p);
+    void (*set_px_cb)(
+        struct _lv_disp_drv_t* disp_drv,
+        uint8_t* buf,
+        lv_coord_t buf_w,
+        lv_coord_t x,
+        lv_coord_t y,
+        lv_color_t color,
+        lv_opa_t opa);
+    lv_coord_t dpi;
+    struct _lv_draw_ctx_t* draw_ctx;
+    void (*draw_ctx_init)(
+        struct _lv_disp_drv_t* disp_drv,
+        struct _lv_draw_ctx_t* draw_ctx);
+    void (*draw_ctx_deinit)(
+        struct _lv_disp_drv_t* disp_drv,
+        struct _lv_draw_ctx_t* draw_ctx);
+    size_t draw_ctx_size;
+    void* user_data;
+} lv_disp_drv_t;
+
+typedef struct _lv_disp_t
+{
+    lv_disp_drv_t* driver;
+    uint32_t rendering_in_progress : 1;
+    lv_area_t inv_areas[LV_INV_BUF_SIZE];
+    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+    uint16_t inv_p;
+} lv_disp_t;
+
+void lv_init(void);
+void lv_disp_drv_init(lv_disp_drv_t* driver);
+lv_disp_t* lv_disp_drv_register(lv_disp_drv_t* driver);
+void lv_disp_drv_update(lv_disp_t* disp, lv_disp_drv_t* new_drv);
+void lv_disp_draw_buf_init(
+    lv_disp_draw_buf_t* draw_buf,
+    void* buf1,
+    void* buf2,
+    uint32_t size_in_px_cnt);
+lv_disp_t* lv_disp_get_default(void);
+lv_disp_t* lv_disp_get_next(lv_disp_t* disp);
+void lv_disp_flush_ready(lv_disp_drv_t* disp_drv);
+bool lv_disp_flush_is_last(lv_disp_drv_t* disp_drv);
+lv_disp_t* _lv_refr_get_disp_refreshing(void);
+void _lv_inv_area(lv_disp_t* disp, const lv_area_t* area_p);
+void lv_refr_now(lv_disp_t* disp);
+
+// Input devices
+
+typedef uint8_t lv_indev_state_t;
+
+enum
+{
+    LV_INDEV_STATE_REL = 0,
+    LV_INDEV_STATE_PR,
+};
+
+typedef uint8_t lv_indev_type_t;
+
+enum
+{
+    LV_INDEV_TYPE_NONE,
+    LV_INDEV_TYPE_POINTER,
+    LV_INDEV_TYPE_KEYPAD,
+    LV_INDEV_TYPE_BUTTON,
+    LV_INDEV_TYPE_ENCODER,
+};
+
+enum
+{
+    LV_KEY_UP = 17,
+    LV_KEY_DOWN = 18,
+    LV_KEY_RIGHT = 19,
+    LV_KEY_LEFT = 20,
+    LV_KEY_ESC = 27,
+    LV_KEY_DEL = 127,
+    LV_KEY_BACKSPACE = 8,
+    LV_KEY_ENTER = 10,
+    LV_KEY_NEXT = 9,
+    LV_KEY_PREV = 11,
+    LV_KEY_HOME = 2,
+    LV_KEY_END = 3,
+};
+
+typedef struct
+{
+    lv_point_t point;
+    uint32_t key;
+    uint32_t btn_id;
+    int16_t enc_diff;
+    lv_indev_state_t state;
+    bool continue_reading;
+} lv_indev_data_t;
+
+typedef struct _lv_indev_drv_t
+{
+    lv_indev_type_t type;
+    void (*read_cb)(struct _lv_indev_drv_t* indev_drv, lv_indev_data_t* data);
+} lv_indev_drv_t;
+
+typedef struct _lv_indev_t lv_indev_t;
+
+void lv_indev_drv_init(lv_indev_drv_t* driver);
+lv_indev_t* lv_indev_drv_register(lv_indev_drv_t* driver);
+void lv_indev_set_group(lv_indev_t* indev, lv_group_t* group);
+
+// Software renderer
+
+typedef uint8_t lv_blend_mode_t;
+
+enum
+{
+    LV_BLEND_MODE_NORMAL,
+    LV_BLEND_MODE_ADDITIVE,
+    LV_BLEND_MODE_SUBTRACTIVE,
+    LV_BLEND_MODE_MULTIPLY,
+    LV_BLEND_MODE_REPLACE,
+};
+
+typedef uint8_t lv_draw_mask_res_t;
+
+enum
+{
+    LV_DRAW_MASK_RES_TRANSP,
+    LV_DRAW_MASK_RES_FULL_COVER,
+    LV_DRAW_MASK_RES_CHANGED,
+    LV_DRAW_MASK_RES_UNKNOWN,
+};
+
+typedef struct _lv_draw_ctx_t
+{
+    void* buf;
+    lv_area_t* buf_area;
+    const lv_area_t* clip_area;
+    void (*wait_for_finish)(struct _lv_draw_ctx_t* draw_ctx);
+    void* user_data;
+} lv_draw_ctx_t;
+
+typedef struct
+{
+    const lv_area_t* blend_area;
+    const lv_color_t* src_buf;
+    lv_color_t color;
+    lv_opa_t* mask_buf;
+    lv_draw_mask_res_t mask_res;
+    const lv_area_t* mask_area;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+} lv_draw_sw_blend_dsc_t;
+
+typedef struct
+{
+    lv_draw_ctx_t base_draw;
+    void (*blend)(
+        lv_draw_ctx_t* draw_ctx,
+        const lv_draw_sw_blend_dsc_t* dsc);
+} lv_draw_sw_ctx_t;
+
+void lv_draw_sw_init_ctx(lv_disp_drv_t* drv, lv_draw_ctx_t* draw_ctx);
+void lv_draw_sw_blend_basic(
+    lv_draw_ctx_t* draw_ctx,
+    const lv_draw_sw_blend_dsc_t* dsc);
+void lv_draw_sw_wait_for_finish(lv_draw_ctx_t* draw_ctx);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // !LVGL_WINDOWS_TESTS_STUBS_LVGL
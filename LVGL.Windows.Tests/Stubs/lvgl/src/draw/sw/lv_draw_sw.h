@@ -0,0 +1,17 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      lv_draw_sw.h
+ * PURPOSE:   Definition for the subset of LVGL 8.3 used by the tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS_STUBS_LV_DRAW_SW
+#define LVGL_WINDOWS_TESTS_STUBS_LV_DRAW_SW
+
+// The software renderer is declared by lvgl.h like it is in LVGL.
+#include "../../../lvgl.h"
+
+#endif // !LVGL_WINDOWS_TESTS_STUBS_LV_DRAW_SW
@@ -0,0 +1,19 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      windowsx.h
+ * PURPOSE:   Definition for the subset of the Windows API used by the tests
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_TESTS_STUBS_WINDOWSX
+#define LVGL_WINDOWS_TESTS_STUBS_WINDOWSX
+
+#include <Windows.h>
+
+#define GET_X_LPARAM(lp) ((int)(short)LOWORD(lp))
+#define GET_Y_LPARAM(lp) ((int)(short)HIWORD(lp))
+
+#endif // !LVGL_WINDOWS_TESTS_STUBS_WINDOWSX
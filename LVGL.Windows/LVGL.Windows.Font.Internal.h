@@ -0,0 +1,143 @@
+﻿/*
+ * PROJECT:   LVGL ported to Windows
+ * FILE:      LVGL.Windows.Font.Internal.h
+ * PURPOSE:   Definition for the internal functions of the Windows LVGL font
+ *            engine, shared with the tests and the benchmarks
+ *
+ * LICENSE:   The MIT License
+ *
+ * DEVELOPER: Mouri_Naruto (Mouri_Naruto AT Outlook.com)
+ */
+
+#ifndef LVGL_WINDOWS_FONT_INTERNAL
+#define LVGL_WINDOWS_FONT_INTERNAL
+
+#include "LVGL.Windows.Font.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The x86 build checks for SSE2 at run time, it is always present on x64.
+#if defined(_M_IX86) || defined(_M_X64) || defined(__x86_64__)
+#define LVGL_WINDOWS_GDI_FONT_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define LVGL_WINDOWS_GDI_FONT_NEON
+#endif
+
+/**
+ * @brief The default size of the slabs in the glyph bitmap arena.
+*/
+const std::size_t LvglWindowsGdiFontArenaSlabSize = 64 * 1024;
+
+/**
+ * @brief The alignment of the slabs and the allocations in the glyph bitmap
+ *        arena.
+*/
+const std::size_t LvglWindowsGdiFontArenaAlignment = 16;
+
+/**
+ * @brief The largest Unicode code point.
+*/
+const std::uint32_t LvglWindowsGdiFontMaximumCodePoint = 0x10FFFF;
+
+/**
+ * @brief The signature of the glyph cache files, "LVGC" in little endian.
+*/
+const std::uint32_t LvglWindowsGdiFontCacheFileMagic = 0x4347564C;
+
+/**
+ * @brief The version of the glyph rasterization and the glyph cache file
+ *        format. It must be increased when the glyph bitmaps or descriptors
+ *        produced by the engine are changed, so stale files are ignored.
+*/
+const std::uint32_t LvglWindowsGdiFontCacheEngineVersion = 5;
+
+// The glyph cache file only uses fixed size little endian fields, it is laid
+// out as the header, the glyph records and the bitmap section. The bitmap
+// section and each bitmap in it are aligned to LvglWindowsGdiFontArenaAlignment
+// bytes.
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER
+{
+    std::uint32_t Magic;
+    std::uint32_t EngineVersion;
+    std::uint32_t HeaderSize;
+    std::uint32_t DpiValue;
+    std::int32_t FontSize;
+    std::uint32_t FaceSetHash;
+    // Bit 0 is set for the LV_FONT_SUBPX_HOR glyphs, bit 1 for the glyphs
+    // rasterized by FreeType.
+    std::uint32_t Flags;
+    std::uint32_t GlyphCount;
+    std::uint32_t BitmapOffset;
+    std::uint32_t BitmapSize;
+    std::uint16_t FaceName[LF_FACESIZE];
+} LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER, *PLVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH
+{
+    std::uint32_t CodePoint;
+    // Relative to the bitmap section.
+    std::uint32_t BitmapOffset;
+    std::uint32_t BitmapSize;
+    std::uint16_t AdvanceWidth;
+    std::uint16_t BoxWidth;
+    std::uint16_t BoxHeight;
+    std::int16_t OffsetX;
+    std::int16_t OffsetY;
+    std::uint8_t Bpp;
+    std::uint8_t Reserved;
+} LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH, *PLVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH;
+
+/**
+ * @brief Converts the 65 levels of a GGO_GRAY8_BITMAP glyph bitmap in place to
+ *        8-bpp alpha, 0x40 becomes 0xFF and other levels are multiplied by 4.
+ *        It uses the fastest of the kernels below available on the processor.
+*/
+void LvglWindowsGdiFontConvertCoverage(
+    std::uint8_t* Buffer,
+    std::size_t Length);
+
+void LvglWindowsGdiFontConvertCoverageScalar(
+    std::uint8_t* Buffer,
+    std::size_t Length);
+
+#if defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+void LvglWindowsGdiFontConvertCoverageSse2(
+    std::uint8_t* Buffer,
+    std::size_t Length);
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+void LvglWindowsGdiFontConvertCoverageNeon(
+    std::uint8_t* Buffer,
+    std::size_t Length);
+#endif
+
+/**
+ * @brief Packs 8-bpp alpha into the 4-bpp or 2-bpp format of LVGL, a bit
+ *        stream which is continuous across the rows with the first pixel in
+ *        the most significant bits.
+*/
+void LvglWindowsGdiFontPackCoverage(
+    std::uint8_t* Target,
+    const std::uint8_t* Source,
+    std::size_t PixelCount,
+    std::uint8_t Bpp);
+
+/**
+ * @brief Filters the 8-bpp alpha of a glyph rasterized 3 times wider for
+ *        LV_FONT_SUBPX_HOR. Each subpixel is spread over its neighbours with
+ *        the 5-tap weights of the FreeType default LCD filter to limit the
+ *        color fringes. The result is aligned to whole pixels, so its width
+ *        is a multiple of 3.
+*/
+void LvglWindowsGdiFontFilterSubpixels(
+    std::vector<std::uint8_t>& Target,
+    const std::uint8_t* Source,
+    std::uint32_t Width,
+    std::uint32_t Height,
+    std::int32_t OriginX,
+    std::uint32_t* TargetWidth,
+    std::int32_t* TargetOffsetX);
+
+#endif // !LVGL_WINDOWS_FONT_INTERNAL
@@ -9,377 +9,4105 @@
  */
 
 #include "LVGL.Windows.Font.h"
+#include "LVGL.Windows.Font.Internal.h"
 
 #include "LVGL.Resource.FontAwesome5Free.h"
 #include "LVGL.Resource.FontAwesome5FreeLVGL.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <iterator>
 #include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
-static FIXED ConvertDoubleToFixed(double value)
+#if defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+#include <emmintrin.h>
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+#include <arm_neon.h>
+#endif
+
+#if LV_USE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#include FT_TRUETYPE_TABLES_H
+#endif
+
+lv_font_t LvglDefaultFont;
+
+/**
+ * @brief The DPI value used by the fonts, updated by
+ *        LvglWindowsGdiFontNotifyDpiChanged from the window procedure.
+*/
+static std::atomic<std::uint32_t> g_LvglWindowsGdiFontDpiValue(LV_DPI_DEF);
+
+/**
+ * @brief The count of code points which are indexed directly instead of being
+ *        hashed, covers ASCII and Latin-1.
+*/
+const std::size_t LvglWindowsGdiFontDirectGlyphCount = 0x100;
+
+/**
+ * @brief The marker for empty index entries. It is not a valid code point.
+*/
+const std::uint32_t LvglWindowsGdiFontInvalidIndex = 0xFFFFFFFF;
+
+/**
+ * @brief The initial slot count of the glyph hash table, must be a power of 2.
+*/
+const std::size_t LvglWindowsGdiFontInitialTableSize = 64;
+
+/**
+ * @brief The marker for empty slots of the glyph hash table.
+*/
+const std::uint64_t LvglWindowsGdiFontEmptyTableSlot = UINT64_MAX;
+
+/**
+ * @brief The count of glyph records allocated together, the records are never
+ *        moved once allocated.
+*/
+const std::size_t LvglWindowsGdiFontGlyphChunkSize = 512;
+
+/**
+ * @brief The maximum count of glyph record chunks of a glyph cache.
+*/
+const std::size_t LvglWindowsGdiFontMaximumGlyphChunks = 2048;
+
+/**
+ * @brief The period, in milliseconds, of the timer which invalidates the
+ *        objects using an asynchronous font after its glyphs are ready.
+*/
+const std::uint32_t LvglWindowsGdiFontRedrawPeriod = 30;
+
+/**
+ * @brief The count of code points of a range prewarmed in one batch.
+*/
+const std::size_t LvglWindowsGdiFontPrewarmChunkSize = 1024;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_GLYPH
+{
+    lv_font_glyph_dsc_t Description;
+    std::uint8_t* Bitmap;
+    std::uint32_t BitmapSize;
+    // The bitmap points into a mapped glyph cache file instead of the arena.
+    bool IsMapped;
+    // Set by the lookups and cleared by the CLOCK sweep of the eviction, both
+    // only run on the LVGL thread.
+    bool IsReferenced;
+    // The metrics of a glyph queued for the worker thread with an empty box,
+    // never stored in a glyph cache.
+    bool IsPlaceholder;
+    std::uint32_t CodePoint;
+    // The link of the free list for unused entries.
+    std::uint32_t NextFree;
+} LVGL_WINDOWS_GDI_FONT_GLYPH, *PLVGL_WINDOWS_GDI_FONT_GLYPH;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_TABLE
+{
+    std::size_t Size;
+    std::uint32_t Shift;
+    // The code point in the high 32 bits and the glyph index in the low 32
+    // bits, so the lookups without the lock read both with one atomic load.
+    std::atomic<std::uint64_t>* Slots;
+} LVGL_WINDOWS_GDI_FONT_TABLE, *PLVGL_WINDOWS_GDI_FONT_TABLE;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_ARENA_SLAB
+{
+    std::uint8_t* Base;
+    std::size_t Size;
+    std::size_t Used;
+} LVGL_WINDOWS_GDI_FONT_ARENA_SLAB, *PLVGL_WINDOWS_GDI_FONT_ARENA_SLAB;
+
+// The glyph bitmaps are carved from fixed slabs which are never moved, so the
+// pointers returned to LVGL stay valid until the glyph is evicted. Evicted
+// blocks are kept in free lists per 16-byte size class, the first bytes of a
+// free block hold the link to the next one.
+typedef struct _LVGL_WINDOWS_GDI_FONT_ARENA
+{
+    std::vector<LVGL_WINDOWS_GDI_FONT_ARENA_SLAB> Slabs;
+    std::vector<std::uint8_t*> FreeLists;
+    std::size_t ReservedSize;
+    std::size_t UsedSize;
+    std::size_t FreeSize;
+    std::size_t FragmentedSize;
+} LVGL_WINDOWS_GDI_FONT_ARENA, *PLVGL_WINDOWS_GDI_FONT_ARENA;
+
+// The scale of the glyphs from the font size, in 16.16 fixed point.
+typedef struct _LVGL_WINDOWS_GDI_FONT_SCALE
+{
+    std::int32_t X;
+    std::int32_t Y;
+} LVGL_WINDOWS_GDI_FONT_SCALE, *PLVGL_WINDOWS_GDI_FONT_SCALE;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_CACHE
+{
+    std::uint32_t DpiValue;
+    LVGL_WINDOWS_GDI_FONT_SCALE Scale;
+    // The glyph records are allocated in chunks which are published before
+    // any index inside them, so the lookups can use them without the lock.
+    std::atomic<PLVGL_WINDOWS_GDI_FONT_GLYPH> GlyphChunks[
+        LvglWindowsGdiFontMaximumGlyphChunks];
+    std::uint32_t GlyphCapacity;
+    std::atomic<std::uint32_t> DirectGlyphTable[
+        LvglWindowsGdiFontDirectGlyphCount];
+    std::atomic<PLVGL_WINDOWS_GDI_FONT_TABLE> GlyphTable;
+    // The tables replaced by a larger one, the lookups without the lock may
+    // still probe them, so they are only freed with the cache.
+    std::vector<PLVGL_WINDOWS_GDI_FONT_TABLE> RetiredTables;
+    std::size_t GlyphTableCount;
+    std::uint32_t ClockHand;
+    std::uint32_t FreeGlyph;
+    std::size_t GlyphCount;
+    std::size_t ResidentSize;
+    LVGL_WINDOWS_GDI_FONT_ARENA GlyphBitmapArena;
+} LVGL_WINDOWS_GDI_FONT_CACHE, *PLVGL_WINDOWS_GDI_FONT_CACHE;
+
+// The best Unicode subtable of the cmap table of a font, format 12 or format
+// 4. It maps the code points to the glyph indices without calling GDI, and it
+// is the only way to map the supplementary planes because GetGlyphIndicesW
+// works on UTF-16 code units. Empty if the font has no usable cmap table.
+typedef struct _LVGL_WINDOWS_GDI_FONT_CHARACTER_MAP
+{
+    std::vector<std::uint8_t> Table;
+    std::uint16_t Format;
+} LVGL_WINDOWS_GDI_FONT_CHARACTER_MAP, *PLVGL_WINDOWS_GDI_FONT_CHARACTER_MAP;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_FACE
+{
+    HFONT FontHandle;
+    // A memory DC with the font selected for the whole lifetime of the
+    // context, so a cache miss only needs the outline calls.
+    HDC DCHandle;
+    // Owned by the family.
+    const LVGL_WINDOWS_GDI_FONT_CHARACTER_MAP* CharacterMap;
+#if LV_USE_FREETYPE
+    // Only used by the FreeType backend. The face reads the font data given
+    // with the font, or a copy of the font data read from GDI which is owned
+    // by the face.
+    FT_Face FreeTypeFace;
+    std::uint8_t* FreeTypeData;
+#endif
+} LVGL_WINDOWS_GDI_FONT_FACE, *PLVGL_WINDOWS_GDI_FONT_FACE;
+
+// The font of a face. The backends which rasterize the font data themselves
+// read the data instead of looking the name up when it is given, it must
+// outlive the face.
+typedef struct _LVGL_WINDOWS_GDI_FONT_SOURCE
+{
+    const wchar_t* FontName;
+    const std::uint8_t* FontData;
+    std::size_t FontDataSize;
+} LVGL_WINDOWS_GDI_FONT_SOURCE, *PLVGL_WINDOWS_GDI_FONT_SOURCE;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_KERNING_PAIR
+{
+    std::uint16_t First;
+    std::uint16_t Second;
+    // In pixels at the font size.
+    std::int32_t Amount;
+} LVGL_WINDOWS_GDI_FONT_KERNING_PAIR, *PLVGL_WINDOWS_GDI_FONT_KERNING_PAIR;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_GLYPH_METRICS
+{
+    // The black box, GDI reports a 1x1 box for the glyphs without pixels.
+    std::uint32_t BoxWidth;
+    std::uint32_t BoxHeight;
+    // The top left corner of the black box, y points up from the base line.
+    std::int32_t OriginX;
+    std::int32_t OriginY;
+    std::int32_t AdvanceWidth;
+    // No pixels have been rasterized, like for the space.
+    bool IsBlank;
+} LVGL_WINDOWS_GDI_FONT_GLYPH_METRICS, *PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_METRICS
+{
+    std::int32_t LineHeight;
+    std::int32_t BaseLine;
+    std::int32_t UnderlinePosition;
+    std::int32_t UnderlineThickness;
+} LVGL_WINDOWS_GDI_FONT_METRICS, *PLVGL_WINDOWS_GDI_FONT_METRICS;
+
+// The rasterizer behind the glyph caches. The caches, the fallback chain, the
+// cmap lookups and the bitmap formats only depend on these operations, which
+// only use plain types. The metrics are in pixels at the font size unless a
+// scale is given.
+typedef struct _LVGL_WINDOWS_GDI_FONT_BACKEND
+{
+    bool (*CreateFace)(
+        int FontSize,
+        const LVGL_WINDOWS_GDI_FONT_SOURCE* Source,
+        PLVGL_WINDOWS_GDI_FONT_FACE Face);
+    void (*ReleaseFace)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face);
+    // The tag is in the byte order of the font file, like 'cmap'.
+    bool (*GetFontTable)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        std::uint32_t Tag,
+        std::vector<std::uint8_t>& Table);
+    // Maps UTF-16 code units, the missing ones are mapped to 0xffff.
+    bool (*GetGlyphIndices)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        const wchar_t* CodeUnits,
+        std::size_t Count,
+        std::uint16_t* GlyphIndices);
+    bool (*GetGlyphMetrics)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        std::uint16_t GlyphIndex,
+        const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+        PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics);
+    // Produces the 8-bpp alpha of the black box without row padding at the
+    // beginning of the buffer, which is only grown.
+    bool (*RasterizeGlyph)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        std::uint16_t GlyphIndex,
+        const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+        PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics,
+        std::vector<std::uint8_t>& Pixels);
+    bool (*GetKerningPairs)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_PAIR>& Pairs);
+    // The buffer has LF_FACESIZE characters.
+    void (*GetFaceName)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        wchar_t* FaceName);
+    bool (*GetFontMetrics)(
+        PLVGL_WINDOWS_GDI_FONT_FACE Face,
+        PLVGL_WINDOWS_GDI_FONT_METRICS Metrics);
+} LVGL_WINDOWS_GDI_FONT_BACKEND, *PLVGL_WINDOWS_GDI_FONT_BACKEND;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_FACE_RANGE
+{
+    std::uint32_t FirstCodePoint;
+    std::uint32_t LastCodePoint;
+    std::uint32_t FaceIndex;
+} LVGL_WINDOWS_GDI_FONT_FACE_RANGE, *PLVGL_WINDOWS_GDI_FONT_FACE_RANGE;
+
+// The size independent data of a fallback chain, shared by all the LVGL font
+// objects created for the same font names. Only the face ranges are changed
+// after it has been created, under their own lock, so the fonts use the rest
+// without locking.
+typedef struct _LVGL_WINDOWS_GDI_FONT_FAMILY
+{
+    // The requested font names and the font data of the main font, the key
+    // of the family.
+    std::vector<std::wstring> FontNames;
+    const std::uint8_t* FontData;
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend;
+    // Protected by g_LvglWindowsGdiFontFamilyLock.
+    std::size_t ReferenceCount;
+    // One for each face of the fallback chain.
+    std::vector<LVGL_WINDOWS_GDI_FONT_CHARACTER_MAP> CharacterMaps;
+    wchar_t FaceName[LF_FACESIZE];
+    std::uint32_t FaceSetHash;
+    // The sorted and disjoint ranges of resolved code points with the index
+    // of the face which owns them, so the fallback chain is only probed once
+    // for each code point whatever the size. It is a leaf lock, taken after
+    // the lock of a context.
+    std::mutex FaceRangeLock;
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE_RANGE> FaceRanges;
+} LVGL_WINDOWS_GDI_FONT_FAMILY, *PLVGL_WINDOWS_GDI_FONT_FAMILY;
+
+/**
+ * @brief The font families which are used by at least one LVGL font object.
+*/
+static std::mutex g_LvglWindowsGdiFontFamilyLock;
+static std::vector<PLVGL_WINDOWS_GDI_FONT_FAMILY> g_LvglWindowsGdiFontFamilies;
+
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_KERNING_SLOT
+{
+    // The first letter in the high 16 bits and the second letter in the low
+    // 16 bits, or LvglWindowsGdiFontInvalidIndex for an empty slot.
+    std::uint32_t LetterPair;
+    std::int32_t Amount;
+} LVGL_WINDOWS_GDI_FONT_KERNING_SLOT, *PLVGL_WINDOWS_GDI_FONT_KERNING_SLOT;
+
+/**
+ * @brief An area of a display drawn with placeholder glyphs.
+*/
+typedef struct _LVGL_WINDOWS_GDI_FONT_DIRTY_AREA
+{
+    lv_disp_t* Display;
+    lv_area_t Area;
+} LVGL_WINDOWS_GDI_FONT_DIRTY_AREA, *PLVGL_WINDOWS_GDI_FONT_DIRTY_AREA;
+
+typedef struct _LVGL_WINDOWS_GDI_FONT_CONTEXT
+{
+    PLVGL_WINDOWS_GDI_FONT_FAMILY Family;
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend;
+    // The main font, the fallback fonts in order and the symbol font.
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE> FaceSet;
+    // The kerning pairs of the main font in logical units at 96 DPI, an open
+    // addressing table at most half full, empty if the font has no pairs.
+    std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_SLOT> KerningTable;
+    std::uint32_t KerningTableShift;
+    int FontSize;
+    // The bits per pixel of the cached glyph bitmaps, 8, 4 or 2.
+    std::uint8_t GlyphBpp;
+    // The glyphs are rasterized for LV_FONT_SUBPX_HOR, box_w counts the
+    // subpixels.
+    bool IsSubpixel;
+    // The 8-bpp output of the backend before it is filtered or packed.
+    std::vector<std::uint8_t> RasterBuffer;
+    // The filtered subpixels of the glyph being rasterized.
+    std::vector<std::uint8_t> SubpixelBuffer;
+    // The view of the loaded glyph cache file, kept until the context is
+    // destroyed because the mapped glyphs point into it.
+    HANDLE CacheFileMappingHandle;
+    const std::uint8_t* CacheFileView;
+    // Serializes the changes of the glyph caches, the face ranges and the
+    // negative cache. The LVGL thread looks up the glyphs of the current cache
+    // without it, so other threads can rasterize glyphs meanwhile.
+    std::mutex Lock;
+    // One glyph cache per DPI value, moving the window between monitors only
+    // switches the current cache instead of rasterizing every glyph again.
+    std::map<std::uint32_t, LVGL_WINDOWS_GDI_FONT_CACHE> CacheSet;
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache;
+    std::size_t GlyphCacheBudget;
+    std::size_t ResidentSize;
+    // LVGL always asks for the bitmap right after the descriptor of the same
+    // letter, remember the last resolved glyph to skip the second lookup.
+    std::uint32_t LastCodePoint;
+    PLVGL_WINDOWS_GDI_FONT_GLYPH LastGlyph;
+    // Only updated on the LVGL thread without the lock.
+    std::atomic<std::size_t> LastGlyphHits;
+    std::atomic<std::size_t> LastGlyphMisses;
+    std::atomic<std::size_t> CacheHits;
+    std::size_t CacheMisses;
+    std::size_t Evictions;
+    // The code points which are in neither font, a bitset for the Basic
+    // Multilingual Plane and a sorted set for the other planes. It does not
+    // depend on the DPI value.
+    std::atomic<std::uint64_t> MissingBmpGlyphs[0x10000 / 64];
+    std::vector<std::uint32_t> MissingGlyphs;
+    std::size_t MissingGlyphCount;
+    std::atomic<std::size_t> MissingGlyphHits;
+    // The misses on the LVGL thread only measure the glyph and queue it for
+    // the worker thread, the queued glyphs are drawn with an empty box.
+    bool IsAsynchronous;
+    std::thread Worker;
+    std::condition_variable WorkerCondition;
+    bool IsWorkerStopping;
+    // The queued code points for the current DPI value.
+    std::set<std::uint32_t> PendingGlyphs;
+    // The placeholders of the queued code points. Only used on the LVGL
+    // thread without the lock, so the letters waiting for the worker thread
+    // are found without it, and pruned by the redraw timer once they are
+    // rasterized.
+    std::map<std::uint32_t, LVGL_WINDOWS_GDI_FONT_GLYPH> PlaceholderGlyphs;
+    // Only updated on the LVGL thread without the lock, once per letter.
+    std::atomic<std::size_t> PlaceholderHits;
+    // The areas drawn with placeholders. Only used on the LVGL thread, the
+    // timer invalidates them once the worker thread rasterized a glyph.
+    std::vector<LVGL_WINDOWS_GDI_FONT_DIRTY_AREA> PlaceholderAreas;
+    // Set by the worker thread, the timer invalidates the placeholder areas
+    // on the LVGL thread.
+    std::atomic<bool> IsRedrawPending;
+    lv_timer_t* RedrawTimer;
+} LVGL_WINDOWS_GDI_FONT_CONTEXT, *PLVGL_WINDOWS_GDI_FONT_CONTEXT;
+
+void LvglWindowsGdiFontConvertCoverageScalar(
+    std::uint8_t* Buffer,
+    std::size_t Length)
+{
+    for (std::size_t i = 0; i < Length; ++i)
+    {
+        Buffer[i] = static_cast<std::uint8_t>(
+            Buffer[i] == 0x40 ? 0xFF : Buffer[i] << 2);
+    }
+}
+
+#if defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+
+void LvglWindowsGdiFontConvertCoverageSse2(
+    std::uint8_t* Buffer,
+    std::size_t Length)
+{
+    // There is no 8-bit shift in SSE2, the 16-bit shift carries bit 6 of the
+    // low byte into the high byte, which the mask removes. Only 0x40 has that
+    // bit set and it is replaced by 0xFF anyway.
+    const __m128i ShiftMask = ::_mm_set1_epi8(static_cast<char>(0xFC));
+    const __m128i FullLevel = ::_mm_set1_epi8(0x40);
+
+    std::size_t i = 0;
+    for (; i + 16 <= Length; i += 16)
+    {
+        __m128i* Pointer = reinterpret_cast<__m128i*>(Buffer + i);
+        __m128i Value = ::_mm_loadu_si128(Pointer);
+        __m128i Result = ::_mm_or_si128(
+            ::_mm_and_si128(::_mm_slli_epi16(Value, 2), ShiftMask),
+            ::_mm_cmpeq_epi8(Value, FullLevel));
+        ::_mm_storeu_si128(Pointer, Result);
+    }
+
+    ::LvglWindowsGdiFontConvertCoverageScalar(Buffer + i, Length - i);
+}
+
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+
+void LvglWindowsGdiFontConvertCoverageNeon(
+    std::uint8_t* Buffer,
+    std::size_t Length)
+{
+    const uint8x16_t FullLevel = ::vdupq_n_u8(0x40);
+
+    std::size_t i = 0;
+    for (; i + 16 <= Length; i += 16)
+    {
+        uint8x16_t Value = ::vld1q_u8(Buffer + i);
+        uint8x16_t Result = ::vorrq_u8(
+            ::vshlq_n_u8(Value, 2),
+            ::vceqq_u8(Value, FullLevel));
+        ::vst1q_u8(Buffer + i, Result);
+    }
+
+    ::LvglWindowsGdiFontConvertCoverageScalar(Buffer + i, Length - i);
+}
+
+#endif
+
+void LvglWindowsGdiFontConvertCoverage(
+    std::uint8_t* Buffer,
+    std::size_t Length)
+{
+#if defined(_M_IX86)
+    // The x86 build does not assume SSE2.
+    static const bool IsSse2Available = ::IsProcessorFeaturePresent(
+        PF_XMMI64_INSTRUCTIONS_AVAILABLE) != FALSE;
+    if (IsSse2Available)
+    {
+        ::LvglWindowsGdiFontConvertCoverageSse2(Buffer, Length);
+    }
+    else
+    {
+        ::LvglWindowsGdiFontConvertCoverageScalar(Buffer, Length);
+    }
+#elif defined(LVGL_WINDOWS_GDI_FONT_SSE2)
+    ::LvglWindowsGdiFontConvertCoverageSse2(Buffer, Length);
+#elif defined(LVGL_WINDOWS_GDI_FONT_NEON)
+    ::LvglWindowsGdiFontConvertCoverageNeon(Buffer, Length);
+#else
+    ::LvglWindowsGdiFontConvertCoverageScalar(Buffer, Length);
+#endif
+}
+
+void LvglWindowsGdiFontPackCoverage(
+    std::uint8_t* Target,
+    const std::uint8_t* Source,
+    std::size_t PixelCount,
+    std::uint8_t Bpp)
+{
+    // Round to the nearest level, LVGL expands the levels back evenly over
+    // the 0 to 255 range.
+    const std::uint32_t MaximumLevel = (1U << Bpp) - 1;
+    const std::uint32_t PixelsPerByte = 8U / Bpp;
+
+    std::size_t i = 0;
+    while (i < PixelCount)
+    {
+        std::uint32_t Value = 0;
+        for (std::uint32_t j = 0; j < PixelsPerByte; ++j, ++i)
+        {
+            std::uint32_t Level = 0;
+            if (i < PixelCount)
+            {
+                Level = (Source[i] * MaximumLevel + 127) / 255;
+            }
+            Value = (Value << Bpp) | Level;
+        }
+        *Target++ = static_cast<std::uint8_t>(Value);
+    }
+}
+
+void LvglWindowsGdiFontFilterSubpixels(
+    std::vector<std::uint8_t>& Target,
+    const std::uint8_t* Source,
+    std::uint32_t Width,
+    std::uint32_t Height,
+    std::int32_t OriginX,
+    std::uint32_t* TargetWidth,
+    std::int32_t* TargetOffsetX)
+{
+    static const std::uint32_t Weights[5] = { 0x08, 0x4D, 0x56, 0x4D, 0x08 };
+
+    // The filter widens the glyph by 2 subpixels on each side, the result
+    // starts at the pixel containing the first of them.
+    std::int32_t First = OriginX - 2;
+    std::int32_t OffsetX = First >= 0 ? First / 3 : -((2 - First) / 3);
+    std::uint32_t Lead = static_cast<std::uint32_t>(First - OffsetX * 3);
+    std::uint32_t FilteredWidth = Width + 4;
+    std::uint32_t AlignedWidth = (Lead + FilteredWidth + 2) / 3 * 3;
+
+    Target.assign(AlignedWidth * Height, 0);
+
+    for (std::uint32_t y = 0; y < Height; ++y)
+    {
+        const std::uint8_t* SourceRow = Source + y * Width;
+        std::uint8_t* TargetRow = &Target[y * AlignedWidth + Lead];
+
+        for (std::uint32_t x = 0; x < FilteredWidth; ++x)
+        {
+            // Target x is centered on the source subpixel x - 2.
+            std::uint32_t Sum = 0;
+            for (std::uint32_t t = 0; t < 5; ++t)
+            {
+                std::uint32_t k = x + t;
+                if (k >= 4 && k - 4 < Width)
+                {
+                    Sum += Weights[t] * SourceRow[k - 4];
+                }
+            }
+            TargetRow[x] = static_cast<std::uint8_t>((Sum + 128) >> 8);
+        }
+    }
+
+    *TargetWidth = AlignedWidth;
+    *TargetOffsetX = OffsetX;
+}
+
+static void LvglWindowsGdiFontIncrementCounter(
+    std::atomic<std::size_t>& Counter)
+{
+    // Only the LVGL thread updates the counter, a relaxed load and store
+    // avoid a locked instruction and still let other threads read it.
+    Counter.store(
+        Counter.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+}
+
+static std::uint8_t* LvglWindowsGdiFontArenaAllocate(
+    PLVGL_WINDOWS_GDI_FONT_ARENA Arena,
+    std::size_t Size)
+{
+    const std::size_t AlignmentMask = LvglWindowsGdiFontArenaAlignment - 1;
+    std::size_t AlignedSize = (Size + AlignmentMask) & ~AlignmentMask;
+    std::size_t SizeClass = AlignedSize / LvglWindowsGdiFontArenaAlignment;
+
+    if (SizeClass < Arena->FreeLists.size() && Arena->FreeLists[SizeClass])
+    {
+        std::uint8_t* Result = Arena->FreeLists[SizeClass];
+        std::memcpy(
+            &Arena->FreeLists[SizeClass],
+            Result,
+            sizeof(std::uint8_t*));
+        Arena->FreeSize -= AlignedSize;
+        Arena->UsedSize += Size;
+        Arena->FragmentedSize += AlignedSize - Size;
+        return Result;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_ARENA_SLAB Slab =
+        Arena->Slabs.empty() ? nullptr : &Arena->Slabs.back();
+    if (!Slab || Slab->Size - Slab->Used < AlignedSize)
+    {
+        std::size_t SlabSize = std::max(
+            LvglWindowsGdiFontArenaSlabSize,
+            AlignedSize);
+
+        LVGL_WINDOWS_GDI_FONT_ARENA_SLAB NewSlab;
+        NewSlab.Base = reinterpret_cast<std::uint8_t*>(::_aligned_malloc(
+            SlabSize,
+            LvglWindowsGdiFontArenaAlignment));
+        if (!NewSlab.Base)
+        {
+            return nullptr;
+        }
+        NewSlab.Size = SlabSize;
+        NewSlab.Used = 0;
+
+        if (Slab)
+        {
+            // The tail of the previous slab will never be used.
+            Arena->FragmentedSize += Slab->Size - Slab->Used;
+        }
+
+        Arena->Slabs.push_back(NewSlab);
+        Arena->ReservedSize += SlabSize;
+        Slab = &Arena->Slabs.back();
+    }
+
+    std::uint8_t* Result = Slab->Base + Slab->Used;
+    Slab->Used += AlignedSize;
+    Arena->UsedSize += Size;
+    Arena->FragmentedSize += AlignedSize - Size;
+
+    return Result;
+}
+
+static void LvglWindowsGdiFontArenaFree(
+    PLVGL_WINDOWS_GDI_FONT_ARENA Arena,
+    std::uint8_t* Block,
+    std::size_t Size)
+{
+    const std::size_t AlignmentMask = LvglWindowsGdiFontArenaAlignment - 1;
+    std::size_t AlignedSize = (Size + AlignmentMask) & ~AlignmentMask;
+    std::size_t SizeClass = AlignedSize / LvglWindowsGdiFontArenaAlignment;
+
+    if (SizeClass >= Arena->FreeLists.size())
+    {
+        Arena->FreeLists.resize(SizeClass + 1, nullptr);
+    }
+
+    std::memcpy(
+        Block,
+        &Arena->FreeLists[SizeClass],
+        sizeof(std::uint8_t*));
+    Arena->FreeLists[SizeClass] = Block;
+
+    Arena->UsedSize -= Size;
+    Arena->FragmentedSize -= AlignedSize - Size;
+    Arena->FreeSize += AlignedSize;
+}
+
+static void LvglWindowsGdiFontArenaRelease(
+    PLVGL_WINDOWS_GDI_FONT_ARENA Arena)
+{
+    for (LVGL_WINDOWS_GDI_FONT_ARENA_SLAB& Slab : Arena->Slabs)
+    {
+        ::_aligned_free(Slab.Base);
+    }
+
+    Arena->Slabs.clear();
+    Arena->FreeLists.clear();
+    Arena->ReservedSize = 0;
+    Arena->UsedSize = 0;
+    Arena->FreeSize = 0;
+    Arena->FragmentedSize = 0;
+}
+
+static PLVGL_WINDOWS_GDI_FONT_GLYPH LvglWindowsGdiFontGetGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t GlyphIndex)
+{
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Chunk =
+        Cache->GlyphChunks[GlyphIndex / LvglWindowsGdiFontGlyphChunkSize].load(
+            std::memory_order_acquire);
+    return &Chunk[GlyphIndex % LvglWindowsGdiFontGlyphChunkSize];
+}
+
+static std::size_t LvglWindowsGdiFontGetTableSlot(
+    std::uint32_t CodePoint,
+    std::uint32_t TableShift)
+{
+    // Fibonacci hashing, the table size is always a power of 2.
+    return static_cast<std::size_t>(
+        (CodePoint * UINT32_C(0x9E3779B1)) >> TableShift);
+}
+
+static std::uint64_t LvglWindowsGdiFontPackTableSlot(
+    std::uint32_t CodePoint,
+    std::uint32_t GlyphIndex)
+{
+    return (static_cast<std::uint64_t>(CodePoint) << 32) | GlyphIndex;
+}
+
+static PLVGL_WINDOWS_GDI_FONT_TABLE LvglWindowsGdiFontCreateGlyphTable(
+    std::size_t TableSize)
+{
+    std::uint32_t TableShift = 32;
+    for (std::size_t i = TableSize; i > 1; i >>= 1)
+    {
+        --TableShift;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table = new LVGL_WINDOWS_GDI_FONT_TABLE();
+    Table->Size = TableSize;
+    Table->Shift = TableShift;
+    Table->Slots = new std::atomic<std::uint64_t>[TableSize];
+    for (std::size_t i = 0; i < TableSize; ++i)
+    {
+        Table->Slots[i].store(
+            LvglWindowsGdiFontEmptyTableSlot,
+            std::memory_order_relaxed);
+    }
+
+    return Table;
+}
+
+static void LvglWindowsGdiFontReleaseGlyphTable(
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table)
+{
+    delete[] Table->Slots;
+    delete Table;
+}
+
+/**
+ * @brief Stores an entry in a glyph hash table, the caller must hold the lock
+ *        of the context.
+ * @return True if the code point was not in the table yet.
+*/
+static bool LvglWindowsGdiFontStoreTableSlot(
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table,
+    std::uint32_t CodePoint,
+    std::uint32_t GlyphIndex)
+{
+    bool IsNew = false;
+
+    std::size_t Mask = Table->Size - 1;
+    std::size_t Index = ::LvglWindowsGdiFontGetTableSlot(
+        CodePoint,
+        Table->Shift);
+    for (;;)
+    {
+        std::uint64_t Slot = Table->Slots[Index].load(
+            std::memory_order_relaxed);
+        if (Slot == LvglWindowsGdiFontEmptyTableSlot)
+        {
+            IsNew = true;
+            break;
+        }
+        if (static_cast<std::uint32_t>(Slot >> 32) == CodePoint)
+        {
+            break;
+        }
+
+        Index = (Index + 1) & Mask;
+    }
+
+    // The glyph record has been filled before, the release store publishes
+    // it with the slot.
+    Table->Slots[Index].store(
+        ::LvglWindowsGdiFontPackTableSlot(CodePoint, GlyphIndex),
+        std::memory_order_release);
+
+    return IsNew;
+}
+
+static void LvglWindowsGdiFontInsertGlyphIndex(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t CodePoint,
+    std::uint32_t GlyphIndex)
+{
+    if (CodePoint < LvglWindowsGdiFontDirectGlyphCount)
+    {
+        Cache->DirectGlyphTable[CodePoint].store(
+            GlyphIndex,
+            std::memory_order_release);
+        return;
+    }
+
+    // Keep the load factor below 3/4 so the linear probing stays short. The
+    // table grows with the observed usage and is never shrunk.
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table = Cache->GlyphTable.load(
+        std::memory_order_relaxed);
+    std::size_t TableSize = Table ? Table->Size : 0;
+    if ((Cache->GlyphTableCount + 1) * 4 > TableSize * 3)
+    {
+        // The lookups without the lock may still probe the previous table, so
+        // the new one is filled before it is published and the previous one
+        // is only freed with the cache.
+        PLVGL_WINDOWS_GDI_FONT_TABLE NewTable =
+            ::LvglWindowsGdiFontCreateGlyphTable(
+                TableSize ? TableSize * 2 : LvglWindowsGdiFontInitialTableSize);
+
+        if (Table)
+        {
+            for (std::size_t i = 0; i < Table->Size; ++i)
+            {
+                std::uint64_t Slot = Table->Slots[i].load(
+                    std::memory_order_relaxed);
+                if (Slot != LvglWindowsGdiFontEmptyTableSlot)
+                {
+                    ::LvglWindowsGdiFontStoreTableSlot(
+                        NewTable,
+                        static_cast<std::uint32_t>(Slot >> 32),
+                        static_cast<std::uint32_t>(Slot));
+                }
+            }
+
+            Cache->RetiredTables.push_back(Table);
+        }
+
+        Cache->GlyphTable.store(NewTable, std::memory_order_release);
+        Table = NewTable;
+    }
+
+    if (::LvglWindowsGdiFontStoreTableSlot(Table, CodePoint, GlyphIndex))
+    {
+        ++Cache->GlyphTableCount;
+    }
+}
+
+static void LvglWindowsGdiFontRemoveGlyphIndex(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t CodePoint)
+{
+    if (CodePoint < LvglWindowsGdiFontDirectGlyphCount)
+    {
+        Cache->DirectGlyphTable[CodePoint].store(
+            LvglWindowsGdiFontInvalidIndex,
+            std::memory_order_relaxed);
+        return;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table = Cache->GlyphTable.load(
+        std::memory_order_relaxed);
+    if (!Cache->GlyphTableCount)
+    {
+        return;
+    }
+
+    std::size_t Mask = Table->Size - 1;
+    std::size_t Index = ::LvglWindowsGdiFontGetTableSlot(
+        CodePoint,
+        Table->Shift);
+    for (;;)
+    {
+        std::uint64_t Slot = Table->Slots[Index].load(
+            std::memory_order_relaxed);
+        if (Slot == LvglWindowsGdiFontEmptyTableSlot)
+        {
+            return;
+        }
+        if (static_cast<std::uint32_t>(Slot >> 32) == CodePoint)
+        {
+            break;
+        }
+
+        Index = (Index + 1) & Mask;
+    }
+
+    // Backward shift deletion, so the lookups never need tombstones. Only the
+    // LVGL thread removes glyphs, so no lookup runs concurrently with it.
+    std::size_t Next = Index;
+    for (;;)
+    {
+        Next = (Next + 1) & Mask;
+
+        std::uint64_t Slot = Table->Slots[Next].load(
+            std::memory_order_relaxed);
+        if (Slot == LvglWindowsGdiFontEmptyTableSlot)
+        {
+            break;
+        }
+
+        std::size_t Home = ::LvglWindowsGdiFontGetTableSlot(
+            static_cast<std::uint32_t>(Slot >> 32),
+            Table->Shift);
+        bool Stay = (Index <= Next)
+            ? (Index < Home && Home <= Next)
+            : (Index < Home || Home <= Next);
+        if (!Stay)
+        {
+            Table->Slots[Index].store(Slot, std::memory_order_relaxed);
+            Index = Next;
+        }
+    }
+
+    Table->Slots[Index].store(
+        LvglWindowsGdiFontEmptyTableSlot,
+        std::memory_order_relaxed);
+    --Cache->GlyphTableCount;
+}
+
+/**
+ * @brief Looks up the index of a cached glyph. It does not need the lock of
+ *        the context, the acquire loads pair with the release stores of
+ *        LvglWindowsGdiFontInsertGlyphIndex.
+*/
+static std::uint32_t LvglWindowsGdiFontFindGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t CodePoint)
+{
+    if (CodePoint < LvglWindowsGdiFontDirectGlyphCount)
+    {
+        return Cache->DirectGlyphTable[CodePoint].load(
+            std::memory_order_acquire);
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table = Cache->GlyphTable.load(
+        std::memory_order_acquire);
+    if (Table)
+    {
+        std::size_t Mask = Table->Size - 1;
+        std::size_t Index = ::LvglWindowsGdiFontGetTableSlot(
+            CodePoint,
+            Table->Shift);
+        for (;;)
+        {
+            std::uint64_t Slot = Table->Slots[Index].load(
+                std::memory_order_acquire);
+            if (static_cast<std::uint32_t>(Slot >> 32) == CodePoint)
+            {
+                return static_cast<std::uint32_t>(Slot);
+            }
+            if (Slot == LvglWindowsGdiFontEmptyTableSlot)
+            {
+                break;
+            }
+
+            Index = (Index + 1) & Mask;
+        }
+    }
+
+    return LvglWindowsGdiFontInvalidIndex;
+}
+
+static void LvglWindowsGdiFontInitializeCache(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache)
+{
+    for (std::atomic<std::uint32_t>& Slot : Cache->DirectGlyphTable)
+    {
+        Slot.store(LvglWindowsGdiFontInvalidIndex, std::memory_order_relaxed);
+    }
+
+    Cache->GlyphTable.store(nullptr, std::memory_order_relaxed);
+    Cache->GlyphTableCount = 0;
+    Cache->GlyphCapacity = 0;
+    Cache->ClockHand = 0;
+    Cache->FreeGlyph = LvglWindowsGdiFontInvalidIndex;
+    Cache->GlyphCount = 0;
+    Cache->ResidentSize = 0;
+}
+
+static void LvglWindowsGdiFontReleaseCache(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache)
+{
+    for (std::atomic<PLVGL_WINDOWS_GDI_FONT_GLYPH>& Chunk : Cache->GlyphChunks)
+    {
+        delete[] Chunk.load(std::memory_order_relaxed);
+        Chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_TABLE Table = Cache->GlyphTable.load(
+        std::memory_order_relaxed);
+    if (Table)
+    {
+        ::LvglWindowsGdiFontReleaseGlyphTable(Table);
+    }
+    for (PLVGL_WINDOWS_GDI_FONT_TABLE RetiredTable : Cache->RetiredTables)
+    {
+        ::LvglWindowsGdiFontReleaseGlyphTable(RetiredTable);
+    }
+    Cache->RetiredTables.clear();
+
+    ::LvglWindowsGdiFontArenaRelease(&Cache->GlyphBitmapArena);
+    ::LvglWindowsGdiFontInitializeCache(Cache);
+}
+
+static std::size_t LvglWindowsGdiFontGetGlyphResidentSize(
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph)
+{
+    const std::size_t AlignmentMask = LvglWindowsGdiFontArenaAlignment - 1;
+    std::size_t ResidentSize = sizeof(LVGL_WINDOWS_GDI_FONT_GLYPH)
+        + sizeof(std::uint64_t);
+    if (!Glyph->IsMapped)
+    {
+        ResidentSize += (Glyph->BitmapSize + AlignmentMask) & ~AlignmentMask;
+    }
+    return ResidentSize;
+}
+
+static void LvglWindowsGdiFontEvictGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t GlyphIndex)
+{
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+        Cache,
+        GlyphIndex);
+
+    std::size_t ResidentSize = ::LvglWindowsGdiFontGetGlyphResidentSize(Glyph);
+    Cache->ResidentSize -= ResidentSize;
+    Context->ResidentSize -= ResidentSize;
+
+    ::LvglWindowsGdiFontRemoveGlyphIndex(Cache, Glyph->CodePoint);
+
+    if (Glyph->Bitmap && !Glyph->IsMapped)
+    {
+        ::LvglWindowsGdiFontArenaFree(
+            &Cache->GlyphBitmapArena,
+            Glyph->Bitmap,
+            Glyph->BitmapSize);
+    }
+    Glyph->Bitmap = nullptr;
+    Glyph->BitmapSize = 0;
+    Glyph->IsMapped = false;
+
+    Glyph->CodePoint = LvglWindowsGdiFontInvalidIndex;
+    Glyph->NextFree = Cache->FreeGlyph;
+    Cache->FreeGlyph = GlyphIndex;
+    --Cache->GlyphCount;
+
+    ++Context->Evictions;
+
+    // The entry may be reused by the next glyph.
+    if (Context->LastGlyph == Glyph)
+    {
+        Context->LastCodePoint = LvglWindowsGdiFontInvalidIndex;
+        Context->LastGlyph = nullptr;
+    }
+}
+
+/**
+ * @brief Evicts glyphs until the context fits in its budget. It must only be
+ *        called from the LVGL thread with the lock of the context held, the
+ *        glyphs returned to LVGL are only valid until the next eviction.
+*/
+static void LvglWindowsGdiFontEnforceBudget(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t ProtectedGlyph)
+{
+    if (!Context->GlyphCacheBudget)
+    {
+        return;
+    }
+
+    while (Context->ResidentSize > Context->GlyphCacheBudget)
+    {
+        // The caches for other DPI values are not used by the current frames,
+        // release them as a whole before evicting any current glyph.
+        auto Iterator = Context->CacheSet.begin();
+        while (Iterator != Context->CacheSet.end()
+            && &Iterator->second == Context->Cache)
+        {
+            ++Iterator;
+        }
+        if (Iterator != Context->CacheSet.end())
+        {
+            Context->ResidentSize -= Iterator->second.ResidentSize;
+            Context->Evictions += Iterator->second.GlyphCount;
+            ::LvglWindowsGdiFontReleaseCache(&Iterator->second);
+            Context->CacheSet.erase(Iterator);
+            continue;
+        }
+
+        // CLOCK replacement, the lookups only set the referenced flag instead
+        // of relinking a list, and the sweep gives those glyphs a second
+        // chance.
+        PLVGL_WINDOWS_GDI_FONT_CACHE Cache = Context->Cache;
+        std::uint32_t Victim = LvglWindowsGdiFontInvalidIndex;
+        for (std::uint32_t i = 0; i < 2 * Cache->GlyphCapacity; ++i)
+        {
+            std::uint32_t GlyphIndex = Cache->ClockHand;
+            Cache->ClockHand = (GlyphIndex + 1) % Cache->GlyphCapacity;
+
+            PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+                Cache,
+                GlyphIndex);
+            if (Glyph->CodePoint == LvglWindowsGdiFontInvalidIndex
+                || GlyphIndex == ProtectedGlyph)
+            {
+                continue;
+            }
+            if (Glyph->IsReferenced)
+            {
+                Glyph->IsReferenced = false;
+                continue;
+            }
+
+            Victim = GlyphIndex;
+            break;
+        }
+        if (Victim == LvglWindowsGdiFontInvalidIndex)
+        {
+            break;
+        }
+
+        ::LvglWindowsGdiFontEvictGlyph(Context, Cache, Victim);
+    }
+}
+
+/**
+ * @brief Checks the negative cache. The Basic Multilingual Plane may be
+ *        checked without the lock of the context, the other planes need it.
+*/
+static bool LvglWindowsGdiFontIsGlyphMissing(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t CodePoint)
+{
+    if (CodePoint <= 0xFFFF)
+    {
+        return (Context->MissingBmpGlyphs[CodePoint >> 6].load(
+            std::memory_order_relaxed)
+            & (UINT64_C(1) << (CodePoint & 0x3F))) != 0;
+    }
+
+    return std::binary_search(
+        Context->MissingGlyphs.begin(),
+        Context->MissingGlyphs.end(),
+        CodePoint);
+}
+
+static void LvglWindowsGdiFontMarkGlyphMissing(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t CodePoint)
+{
+    if (::LvglWindowsGdiFontIsGlyphMissing(Context, CodePoint))
+    {
+        return;
+    }
+
+    if (CodePoint <= 0xFFFF)
+    {
+        Context->MissingBmpGlyphs[CodePoint >> 6].fetch_or(
+            UINT64_C(1) << (CodePoint & 0x3F),
+            std::memory_order_relaxed);
+    }
+    else
+    {
+        Context->MissingGlyphs.insert(
+            std::lower_bound(
+                Context->MissingGlyphs.begin(),
+                Context->MissingGlyphs.end(),
+                CodePoint),
+            CodePoint);
+    }
+
+    ++Context->MissingGlyphCount;
+}
+
+static std::uint16_t LvglWindowsGdiFontReadUInt16(
+    const std::uint8_t* Buffer)
+{
+    return static_cast<std::uint16_t>((Buffer[0] << 8) | Buffer[1]);
+}
+
+static std::uint32_t LvglWindowsGdiFontReadUInt32(
+    const std::uint8_t* Buffer)
+{
+    return (static_cast<std::uint32_t>(Buffer[0]) << 24)
+        | (static_cast<std::uint32_t>(Buffer[1]) << 16)
+        | (static_cast<std::uint32_t>(Buffer[2]) << 8)
+        | static_cast<std::uint32_t>(Buffer[3]);
+}
+
+static FIXED LvglWindowsGdiFontGdiConvertFixed(
+    std::int32_t Value)
+{
+    // Both are 16.16 fixed point.
+    FIXED Result;
+    Result.fract = static_cast<WORD>(Value & 0xFFFF);
+    Result.value = static_cast<short>(Value >> 16);
+    return Result;
+}
+
+static void LvglWindowsGdiFontGdiConvertScale(
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    MAT2* TransformationMatrix)
+{
+    FIXED Zero = ::LvglWindowsGdiFontGdiConvertFixed(0);
+    TransformationMatrix->eM11 = ::LvglWindowsGdiFontGdiConvertFixed(
+        Scale->X);
+    TransformationMatrix->eM12 = Zero;
+    TransformationMatrix->eM21 = Zero;
+    TransformationMatrix->eM22 = ::LvglWindowsGdiFontGdiConvertFixed(
+        Scale->Y);
+}
+
+static bool LvglWindowsGdiFontGdiCreateFace(
+    int FontSize,
+    const LVGL_WINDOWS_GDI_FONT_SOURCE* Source,
+    PLVGL_WINDOWS_GDI_FONT_FACE Face)
+{
+    // GDI matches the font name, the font data of the built-in symbol font is
+    // registered by LvglWindowsGdiFontInitialize.
+    Face->FontHandle = ::CreateFontW(
+        -FontSize,                  // nHeight
+        0,                         // nWidth
+        0,                         // nEscapement
+        0,                         // nOrientation
+        FW_NORMAL,                 // nWeight
+        FALSE,                     // bItalic
+        FALSE,                     // bUnderline
+        0,                         // cStrikeOut
+        DEFAULT_CHARSET,           // nCharSet
+        OUT_DEFAULT_PRECIS,        // nOutPrecision
+        CLIP_DEFAULT_PRECIS,       // nClipPrecision
+        CLEARTYPE_NATURAL_QUALITY, // nQuality
+        FF_DONTCARE,  // nPitchAndFamily
+        Source->FontName);
+    if (!Face->FontHandle)
+    {
+        return false;
+    }
+
+    Face->DCHandle = ::CreateCompatibleDC(nullptr);
+    if (!Face->DCHandle)
+    {
+        ::DeleteObject(Face->FontHandle);
+        Face->FontHandle = nullptr;
+        return false;
+    }
+    ::SelectObject(Face->DCHandle, Face->FontHandle);
+
+    Face->CharacterMap = nullptr;
+
+    return true;
+}
+
+static void LvglWindowsGdiFontGdiReleaseFace(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face)
+{
+    if (Face->DCHandle)
+    {
+        ::DeleteDC(Face->DCHandle);
+        Face->DCHandle = nullptr;
+    }
+
+    if (Face->FontHandle)
+    {
+        ::DeleteObject(Face->FontHandle);
+        Face->FontHandle = nullptr;
+    }
+}
+
+static bool LvglWindowsGdiFontGdiGetFontTable(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint32_t Tag,
+    std::vector<std::uint8_t>& Table)
+{
+    // GetFontData expects the tag in the reversed byte order.
+    DWORD TableTag = (Tag >> 24)
+        | ((Tag >> 8) & 0xFF00)
+        | ((Tag & 0xFF00) << 8)
+        | (Tag << 24);
+
+    DWORD TableSize = ::GetFontData(
+        Face->DCHandle,
+        TableTag,
+        0,
+        nullptr,
+        0);
+    if (TableSize == GDI_ERROR || !TableSize)
+    {
+        return false;
+    }
+
+    Table.resize(TableSize);
+    return ::GetFontData(
+        Face->DCHandle,
+        TableTag,
+        0,
+        &Table[0],
+        TableSize) == TableSize;
+}
+
+static bool LvglWindowsGdiFontGdiGetGlyphIndices(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    const wchar_t* CodeUnits,
+    std::size_t Count,
+    std::uint16_t* GlyphIndices)
+{
+    static_assert(
+        sizeof(WORD) == sizeof(std::uint16_t),
+        "The glyph indices are passed to GDI as they are.");
+    return ::GetGlyphIndicesW(
+        Face->DCHandle,
+        CodeUnits,
+        static_cast<int>(Count),
+        reinterpret_cast<LPWORD>(GlyphIndices),
+        GGI_MARK_NONEXISTING_GLYPHS) != GDI_ERROR;
+}
+
+static DWORD LvglWindowsGdiFontGdiGetGlyphOutline(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    UINT Format,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics,
+    DWORD BufferSize,
+    LPVOID Buffer)
+{
+    MAT2 TransformationMatrix;
+    ::LvglWindowsGdiFontGdiConvertScale(Scale, &TransformationMatrix);
+
+    GLYPHMETRICS GlyphMetrics;
+    DWORD Length = ::GetGlyphOutlineW(
+        Face->DCHandle,
+        GlyphIndex,
+        Format | GGO_GLYPH_INDEX,
+        &GlyphMetrics,
+        BufferSize,
+        Buffer,
+        &TransformationMatrix);
+    if (Length != GDI_ERROR)
+    {
+        Metrics->BoxWidth = GlyphMetrics.gmBlackBoxX;
+        Metrics->BoxHeight = GlyphMetrics.gmBlackBoxY;
+        Metrics->OriginX = GlyphMetrics.gmptGlyphOrigin.x;
+        Metrics->OriginY = GlyphMetrics.gmptGlyphOrigin.y;
+        Metrics->AdvanceWidth = GlyphMetrics.gmCellIncX;
+        Metrics->IsBlank = false;
+    }
+
+    return Length;
+}
+
+static bool LvglWindowsGdiFontGdiGetGlyphMetrics(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics)
+{
+    // GGO_METRICS does not render the outline.
+    return ::LvglWindowsGdiFontGdiGetGlyphOutline(
+        Face,
+        GlyphIndex,
+        GGO_METRICS,
+        Scale,
+        Metrics,
+        0,
+        nullptr) != GDI_ERROR;
+}
+
+static bool LvglWindowsGdiFontGdiRasterizeGlyph(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics,
+    std::vector<std::uint8_t>& Pixels)
+{
+    DWORD Length = ::LvglWindowsGdiFontGdiGetGlyphOutline(
+        Face,
+        GlyphIndex,
+        GGO_GRAY8_BITMAP,
+        Scale,
+        Metrics,
+        0,
+        nullptr);
+    if (Length == GDI_ERROR)
+    {
+        return false;
+    }
+
+    // Glyphs without a bitmap, like the space, report a 1x1 black box.
+    if (!Length || !Metrics->BoxWidth || !Metrics->BoxHeight)
+    {
+        Metrics->IsBlank = true;
+        return true;
+    }
+
+    if (Pixels.size() < Length)
+    {
+        Pixels.resize(Length);
+    }
+
+    if (::LvglWindowsGdiFontGdiGetGlyphOutline(
+        Face,
+        GlyphIndex,
+        GGO_GRAY8_BITMAP,
+        Scale,
+        Metrics,
+        Length,
+        &Pixels[0]) == GDI_ERROR)
+    {
+        return false;
+    }
+
+    // GDI pads the rows to DWORD boundaries, compact them in place so LVGL
+    // does not blend the transparent padding columns. The destination never
+    // overtakes the source.
+    std::uint32_t BoxWidth = Metrics->BoxWidth;
+    std::uint32_t BoxHeight = Metrics->BoxHeight;
+    std::size_t Stride = (BoxWidth + 3) & ~3;
+    if (Stride * BoxHeight > Length)
+    {
+        return false;
+    }
+
+    for (std::uint32_t y = 1; y < BoxHeight; ++y)
+    {
+        std::memmove(
+            &Pixels[y * BoxWidth],
+            &Pixels[y * Stride],
+            BoxWidth);
+    }
+
+    ::LvglWindowsGdiFontConvertCoverage(&Pixels[0], BoxWidth * BoxHeight);
+
+    return true;
+}
+
+static bool LvglWindowsGdiFontGdiGetKerningPairs(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_PAIR>& Pairs)
+{
+    DWORD PairCount = ::GetKerningPairsW(Face->DCHandle, 0, nullptr);
+    if (!PairCount)
+    {
+        return false;
+    }
+
+    std::vector<KERNINGPAIR> KerningPairs(PairCount);
+    PairCount = ::GetKerningPairsW(
+        Face->DCHandle,
+        PairCount,
+        &KerningPairs[0]);
+
+    Pairs.resize(PairCount);
+    for (DWORD i = 0; i < PairCount; ++i)
+    {
+        Pairs[i].First = KerningPairs[i].wFirst;
+        Pairs[i].Second = KerningPairs[i].wSecond;
+        Pairs[i].Amount = KerningPairs[i].iKernAmount;
+    }
+
+    return PairCount != 0;
+}
+
+static void LvglWindowsGdiFontGdiGetFaceName(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    wchar_t* FaceName)
+{
+    ::GetTextFaceW(Face->DCHandle, LF_FACESIZE, FaceName);
+}
+
+static bool LvglWindowsGdiFontGdiGetFontMetrics(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    PLVGL_WINDOWS_GDI_FONT_METRICS Metrics)
+{
+    OUTLINETEXTMETRICW OutlineTextMetrics;
+    if (!::GetOutlineTextMetricsW(
+        Face->DCHandle,
+        sizeof(OUTLINETEXTMETRICW),
+        &OutlineTextMetrics))
+    {
+        return false;
+    }
+
+    Metrics->LineHeight = OutlineTextMetrics.otmLineGap
+        - OutlineTextMetrics.otmDescent
+        + OutlineTextMetrics.otmAscent;
+    Metrics->BaseLine = 0 - OutlineTextMetrics.otmDescent;
+    Metrics->UnderlinePosition = OutlineTextMetrics.otmsUnderscorePosition;
+    Metrics->UnderlineThickness = OutlineTextMetrics.otmsUnderscoreSize;
+
+    return true;
+}
+
+static const LVGL_WINDOWS_GDI_FONT_BACKEND g_LvglWindowsGdiFontGdiBackend =
+{
+    ::LvglWindowsGdiFontGdiCreateFace,
+    ::LvglWindowsGdiFontGdiReleaseFace,
+    ::LvglWindowsGdiFontGdiGetFontTable,
+    ::LvglWindowsGdiFontGdiGetGlyphIndices,
+    ::LvglWindowsGdiFontGdiGetGlyphMetrics,
+    ::LvglWindowsGdiFontGdiRasterizeGlyph,
+    ::LvglWindowsGdiFontGdiGetKerningPairs,
+    ::LvglWindowsGdiFontGdiGetFaceName,
+    ::LvglWindowsGdiFontGdiGetFontMetrics,
+};
+
+#if LV_USE_FREETYPE
+
+/**
+ * @brief The FreeType library of the FreeType backend, created with the first
+ *        face and kept until the process exits. The lock serializes the
+ *        creation and the destruction of the faces as FreeType requires, each
+ *        face is only used under the lock of its context.
+*/
+static std::mutex g_LvglWindowsGdiFontFreeTypeLock;
+static FT_Library g_LvglWindowsGdiFontFreeTypeLibrary = nullptr;
+
+static std::int32_t LvglWindowsGdiFontFreeTypeRound(
+    FT_Pos Value)
+{
+    // From 26.6 fixed point to pixels.
+    return static_cast<std::int32_t>((Value + 32) >> 6);
+}
+
+
+static void LvglWindowsGdiFontFreeTypeCopyFamilyName(
+    FT_Face FreeTypeFace,
+    wchar_t* FaceName)
+{
+    const char* FamilyName = FreeTypeFace->family_name
+        ? FreeTypeFace->family_name
+        : "";
+
+    std::size_t i = 0;
+    for (; i < LF_FACESIZE - 1 && FamilyName[i]; ++i)
+    {
+        FaceName[i] = static_cast<unsigned char>(FamilyName[i]);
+    }
+    FaceName[i] = L'\0';
+}
+
+static void LvglWindowsGdiFontFreeTypeReleaseFace(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face)
+{
+    if (Face->FreeTypeFace)
+    {
+        std::lock_guard<std::mutex> Guard(g_LvglWindowsGdiFontFreeTypeLock);
+        ::FT_Done_Face(Face->FreeTypeFace);
+        Face->FreeTypeFace = nullptr;
+    }
+
+    delete[] Face->FreeTypeData;
+    Face->FreeTypeData = nullptr;
+
+    ::LvglWindowsGdiFontGdiReleaseFace(Face);
+}
+
+static bool LvglWindowsGdiFontFreeTypeOpenFace(
+    int FontSize,
+    const std::uint8_t* FontData,
+    std::size_t FontDataSize,
+    const wchar_t* FaceName,
+    PLVGL_WINDOWS_GDI_FONT_FACE Face)
+{
+    // The fonts of a collection refer to their tables by the offsets in the
+    // collection file, so the whole collection is given to FreeType.
+    bool IsCollection = FontDataSize >= 4
+        && std::memcmp(FontData, "ttcf", 4) == 0;
+
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsGdiFontFreeTypeLock);
+
+    if (!g_LvglWindowsGdiFontFreeTypeLibrary
+        && ::FT_Init_FreeType(&g_LvglWindowsGdiFontFreeTypeLibrary))
+    {
+        g_LvglWindowsGdiFontFreeTypeLibrary = nullptr;
+        return false;
+    }
+
+    // Use the font of the collection with the given name, or the first one.
+    FT_Long FaceCount = 1;
+    for (FT_Long i = 0; i < FaceCount; ++i)
+    {
+        FT_Face Candidate = nullptr;
+        if (::FT_New_Memory_Face(
+            g_LvglWindowsGdiFontFreeTypeLibrary,
+            FontData,
+            static_cast<FT_Long>(FontDataSize),
+            i,
+            &Candidate))
+        {
+            break;
+        }
+
+        if (IsCollection)
+        {
+            FaceCount = Candidate->num_faces;
+        }
+
+        wchar_t FamilyName[LF_FACESIZE];
+        ::LvglWindowsGdiFontFreeTypeCopyFamilyName(Candidate, FamilyName);
+        bool IsMatched = FaceName && std::wcscmp(FamilyName, FaceName) == 0;
+
+        if (!Face->FreeTypeFace || IsMatched)
+        {
+            if (Face->FreeTypeFace)
+            {
+                ::FT_Done_Face(Face->FreeTypeFace);
+            }
+            Face->FreeTypeFace = Candidate;
+        }
+        else
+        {
+            ::FT_Done_Face(Candidate);
+        }
+
+        if (IsMatched)
+        {
+            break;
+        }
+    }
+
+    return Face->FreeTypeFace && !::FT_Set_Pixel_Sizes(
+        Face->FreeTypeFace,
+        0,
+        static_cast<FT_UInt>(FontSize));
+}
+
+static bool LvglWindowsGdiFontFreeTypeCreateFace(
+    int FontSize,
+    const LVGL_WINDOWS_GDI_FONT_SOURCE* Source,
+    PLVGL_WINDOWS_GDI_FONT_FACE Face)
+{
+    Face->FontHandle = nullptr;
+    Face->DCHandle = nullptr;
+    Face->CharacterMap = nullptr;
+    Face->FreeTypeFace = nullptr;
+    Face->FreeTypeData = nullptr;
+
+    // The font data is read as it is, GDI is not used at all.
+    if (Source->FontData)
+    {
+        if (::LvglWindowsGdiFontFreeTypeOpenFace(
+            FontSize,
+            Source->FontData,
+            Source->FontDataSize,
+            Source->FontName,
+            Face))
+        {
+            return true;
+        }
+
+        ::LvglWindowsGdiFontFreeTypeReleaseFace(Face);
+        return false;
+    }
+
+    // Otherwise GDI matches the font name, FreeType reads a copy of the font
+    // data of the matched font.
+    if (!::LvglWindowsGdiFontGdiCreateFace(FontSize, Source, Face))
+    {
+        return false;
+    }
+
+    do
+    {
+        const DWORD CollectionTag = 0x66637474;
+
+        DWORD DataTag = CollectionTag;
+        DWORD DataSize = ::GetFontData(
+            Face->DCHandle,
+            DataTag,
+            0,
+            nullptr,
+            0);
+        if (DataSize == GDI_ERROR || !DataSize)
+        {
+            DataTag = 0;
+            DataSize = ::GetFontData(
+                Face->DCHandle,
+                DataTag,
+                0,
+                nullptr,
+                0);
+        }
+        if (DataSize == GDI_ERROR || !DataSize)
+        {
+            break;
+        }
+
+        Face->FreeTypeData = new std::uint8_t[DataSize];
+        if (::GetFontData(
+            Face->DCHandle,
+            DataTag,
+            0,
+            Face->FreeTypeData,
+            DataSize) != DataSize)
+        {
+            break;
+        }
+
+        wchar_t FaceName[LF_FACESIZE] = { 0 };
+        ::GetTextFaceW(Face->DCHandle, LF_FACESIZE, FaceName);
+
+        if (!::LvglWindowsGdiFontFreeTypeOpenFace(
+            FontSize,
+            Face->FreeTypeData,
+            DataSize,
+            FaceName,
+            Face))
+        {
+            break;
+        }
+
+        return true;
+
+    } while (false);
+
+    ::LvglWindowsGdiFontFreeTypeReleaseFace(Face);
+
+    return false;
+}
+
+static bool LvglWindowsGdiFontFreeTypeGetFontTable(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint32_t Tag,
+    std::vector<std::uint8_t>& Table)
+{
+    FT_ULong TableSize = 0;
+    if (::FT_Load_Sfnt_Table(
+        Face->FreeTypeFace,
+        Tag,
+        0,
+        nullptr,
+        &TableSize) || !TableSize)
+    {
+        return false;
+    }
+
+    Table.resize(TableSize);
+    return !::FT_Load_Sfnt_Table(
+        Face->FreeTypeFace,
+        Tag,
+        0,
+        &Table[0],
+        &TableSize);
+}
+
+static bool LvglWindowsGdiFontFreeTypeGetGlyphIndices(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    const wchar_t* CodeUnits,
+    std::size_t Count,
+    std::uint16_t* GlyphIndices)
+{
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        FT_UInt GlyphIndex = ::FT_Get_Char_Index(
+            Face->FreeTypeFace,
+            static_cast<FT_ULong>(CodeUnits[i]));
+        GlyphIndices[i] = (GlyphIndex && GlyphIndex < 0xffff)
+            ? static_cast<std::uint16_t>(GlyphIndex)
+            : 0xffff;
+    }
+
+    return true;
+}
+
+static bool LvglWindowsGdiFontFreeTypeLoadGlyph(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics)
+{
+    // Both are 16.16 fixed point, the advance is transformed by FreeType.
+    FT_Matrix Matrix;
+    Matrix.xx = static_cast<FT_Fixed>(Scale->X);
+    Matrix.xy = 0;
+    Matrix.yx = 0;
+    Matrix.yy = static_cast<FT_Fixed>(Scale->Y);
+    ::FT_Set_Transform(Face->FreeTypeFace, &Matrix, nullptr);
+
+    if (::FT_Load_Glyph(Face->FreeTypeFace, GlyphIndex, FT_LOAD_NO_BITMAP))
+    {
+        return false;
+    }
+
+    FT_GlyphSlot Slot = Face->FreeTypeFace->glyph;
+
+    FT_BBox Box;
+    ::FT_Outline_Get_CBox(&Slot->outline, &Box);
+    FT_Pos Left = Box.xMin & ~63;
+    FT_Pos Top = (Box.yMax + 63) & ~63;
+
+    Metrics->BoxWidth = static_cast<std::uint32_t>(
+        (((Box.xMax + 63) & ~63) - Left) >> 6);
+    Metrics->BoxHeight = static_cast<std::uint32_t>(
+        (Top - (Box.yMin & ~63)) >> 6);
+    Metrics->OriginX = static_cast<std::int32_t>(Left >> 6);
+    Metrics->OriginY = static_cast<std::int32_t>(Top >> 6);
+    Metrics->AdvanceWidth = ::LvglWindowsGdiFontFreeTypeRound(
+        Slot->advance.x);
+    Metrics->IsBlank = !Metrics->BoxWidth || !Metrics->BoxHeight;
+
+    return true;
+}
+
+static bool LvglWindowsGdiFontFreeTypeGetGlyphMetrics(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics)
+{
+    return ::LvglWindowsGdiFontFreeTypeLoadGlyph(
+        Face,
+        GlyphIndex,
+        Scale,
+        Metrics);
+}
+
+static bool LvglWindowsGdiFontFreeTypeRasterizeGlyph(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint16_t GlyphIndex,
+    const LVGL_WINDOWS_GDI_FONT_SCALE* Scale,
+    PLVGL_WINDOWS_GDI_FONT_GLYPH_METRICS Metrics,
+    std::vector<std::uint8_t>& Pixels)
+{
+    if (!::LvglWindowsGdiFontFreeTypeLoadGlyph(
+        Face,
+        GlyphIndex,
+        Scale,
+        Metrics))
+    {
+        return false;
+    }
+
+    FT_GlyphSlot Slot = Face->FreeTypeFace->glyph;
+    if (::FT_Render_Glyph(Slot, FT_RENDER_MODE_NORMAL))
+    {
+        return false;
+    }
+
+    const FT_Bitmap& Bitmap = Slot->bitmap;
+    Metrics->BoxWidth = Bitmap.width;
+    Metrics->BoxHeight = Bitmap.rows;
+    Metrics->OriginX = Slot->bitmap_left;
+    Metrics->OriginY = Slot->bitmap_top;
+    Metrics->IsBlank = !Bitmap.width || !Bitmap.rows;
+    if (Metrics->IsBlank)
+    {
+        return true;
+    }
+
+    if (Bitmap.pixel_mode != FT_PIXEL_MODE_GRAY || Bitmap.num_grays != 256)
+    {
+        return false;
+    }
+
+    std::size_t PixelCount = Bitmap.width * Bitmap.rows;
+    if (Pixels.size() < PixelCount)
+    {
+        Pixels.resize(PixelCount);
+    }
+
+    for (unsigned int y = 0; y < Bitmap.rows; ++y)
+    {
+        std::memcpy(
+            &Pixels[y * Bitmap.width],
+            Bitmap.buffer + y * Bitmap.pitch,
+            Bitmap.width);
+    }
+
+    return true;
+}
+
+static bool LvglWindowsGdiFontFreeTypeGetKerningPairs(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_PAIR>& Pairs)
+{
+    // FreeType only looks up the kerning of a given glyph pair, it has no way
+    // to enumerate the pairs.
+    UNREFERENCED_PARAMETER(Face);
+    UNREFERENCED_PARAMETER(Pairs);
+    return false;
+}
+
+static void LvglWindowsGdiFontFreeTypeGetFaceName(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    wchar_t* FaceName)
+{
+    ::LvglWindowsGdiFontFreeTypeCopyFamilyName(Face->FreeTypeFace, FaceName);
+}
+
+static bool LvglWindowsGdiFontFreeTypeGetFontMetrics(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    PLVGL_WINDOWS_GDI_FONT_METRICS Metrics)
+{
+    FT_Face FreeTypeFace = Face->FreeTypeFace;
+    const FT_Size_Metrics& SizeMetrics = FreeTypeFace->size->metrics;
+
+    Metrics->LineHeight = ::LvglWindowsGdiFontFreeTypeRound(
+        SizeMetrics.height);
+    Metrics->BaseLine = 0 - ::LvglWindowsGdiFontFreeTypeRound(
+        SizeMetrics.descender);
+    Metrics->UnderlinePosition = ::LvglWindowsGdiFontFreeTypeRound(
+        ::FT_MulFix(FreeTypeFace->underline_position, SizeMetrics.y_scale));
+    Metrics->UnderlineThickness = ::LvglWindowsGdiFontFreeTypeRound(
+        ::FT_MulFix(FreeTypeFace->underline_thickness, SizeMetrics.y_scale));
+
+    return true;
+}
+
+static const LVGL_WINDOWS_GDI_FONT_BACKEND g_LvglWindowsGdiFontFreeTypeBackend =
+{
+    ::LvglWindowsGdiFontFreeTypeCreateFace,
+    ::LvglWindowsGdiFontFreeTypeReleaseFace,
+    ::LvglWindowsGdiFontFreeTypeGetFontTable,
+    ::LvglWindowsGdiFontFreeTypeGetGlyphIndices,
+    ::LvglWindowsGdiFontFreeTypeGetGlyphMetrics,
+    ::LvglWindowsGdiFontFreeTypeRasterizeGlyph,
+    ::LvglWindowsGdiFontFreeTypeGetKerningPairs,
+    ::LvglWindowsGdiFontFreeTypeGetFaceName,
+    ::LvglWindowsGdiFontFreeTypeGetFontMetrics,
+};
+
+#endif // LV_USE_FREETYPE
+
+static void LvglWindowsGdiFontLoadCharacterMap(
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend,
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    PLVGL_WINDOWS_GDI_FONT_CHARACTER_MAP CharacterMap)
+{
+    const std::uint32_t CharacterMapTag = 0x636D6170;
+
+    std::vector<std::uint8_t> Table;
+    if (!Backend->GetFontTable(Face, CharacterMapTag, Table)
+        || Table.size() < 4)
+    {
+        return;
+    }
+    std::size_t TableSize = Table.size();
+
+    const std::uint8_t* Base = &Table[0];
+    std::size_t SubtableCount = ::LvglWindowsGdiFontReadUInt16(Base + 2);
+    if (4 + SubtableCount * 8 > TableSize)
+    {
+        return;
+    }
+
+    std::size_t BestOffset = 0;
+    std::size_t BestLength = 0;
+    std::uint16_t BestFormat = 0;
+    int BestPriority = 0;
+
+    for (std::size_t i = 0; i < SubtableCount; ++i)
+    {
+        const std::uint8_t* Record = Base + 4 + i * 8;
+        std::uint16_t PlatformId = ::LvglWindowsGdiFontReadUInt16(Record);
+        std::uint16_t EncodingId = ::LvglWindowsGdiFontReadUInt16(Record + 2);
+        std::size_t Offset = ::LvglWindowsGdiFontReadUInt32(Record + 4);
+        if (Offset + 16 > TableSize)
+        {
+            continue;
+        }
+
+        std::uint16_t Format = ::LvglWindowsGdiFontReadUInt16(Base + Offset);
+
+        int Priority = 0;
+        std::size_t Length = 0;
+        if (Format == 12
+            && ((PlatformId == 3 && EncodingId == 10) || PlatformId == 0))
+        {
+            Priority = 3;
+            Length = ::LvglWindowsGdiFontReadUInt32(Base + Offset + 4);
+            if (Offset + Length > TableSize
+                || 16 + static_cast<std::uint64_t>(
+                    ::LvglWindowsGdiFontReadUInt32(Base + Offset + 12)) * 12
+                > Length)
+            {
+                continue;
+            }
+        }
+        else if (Format == 4
+            && ((PlatformId == 3 && EncodingId == 1) || PlatformId == 0))
+        {
+            Priority = 2;
+        }
+        else if (Format == 4 && PlatformId == 3 && EncodingId == 0)
+        {
+            // The symbol fonts map their private use area code points.
+            Priority = 1;
+        }
+
+        if (Format == 4 && Priority)
+        {
+            Length = ::LvglWindowsGdiFontReadUInt16(Base + Offset + 2);
+            std::size_t SegmentCountX2 =
+                ::LvglWindowsGdiFontReadUInt16(Base + Offset + 6);
+            if (Offset + Length > TableSize
+                || !SegmentCountX2
+                || (SegmentCountX2 & 1)
+                || 16 + SegmentCountX2 * 4 > Length)
+            {
+                continue;
+            }
+        }
+
+        if (Priority > BestPriority)
+        {
+            BestOffset = Offset;
+            BestLength = Length;
+            BestFormat = Format;
+            BestPriority = Priority;
+        }
+    }
+
+    if (BestPriority)
+    {
+        CharacterMap->Table.assign(
+            Base + BestOffset,
+            Base + BestOffset + BestLength);
+        CharacterMap->Format = BestFormat;
+    }
+}
+
+static std::uint16_t LvglWindowsGdiFontLookupCharacterMap(
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint32_t CodePoint)
+{
+    const std::uint8_t* Base = &Face->CharacterMap->Table[0];
+    std::size_t Length = Face->CharacterMap->Table.size();
+
+    if (Face->CharacterMap->Format == 12)
+    {
+        std::size_t GroupCount = ::LvglWindowsGdiFontReadUInt32(Base + 12);
+        std::size_t Low = 0;
+        std::size_t High = GroupCount;
+        while (Low < High)
+        {
+            std::size_t Middle = (Low + High) / 2;
+            const std::uint8_t* Group = Base + 16 + Middle * 12;
+            std::uint32_t StartCode = ::LvglWindowsGdiFontReadUInt32(Group);
+            std::uint32_t EndCode = ::LvglWindowsGdiFontReadUInt32(Group + 4);
+            if (CodePoint < StartCode)
+            {
+                High = Middle;
+            }
+            else if (CodePoint > EndCode)
+            {
+                Low = Middle + 1;
+            }
+            else
+            {
+                std::uint32_t GlyphIndex =
+                    ::LvglWindowsGdiFontReadUInt32(Group + 8)
+                    + (CodePoint - StartCode);
+                // GDI only accepts 16-bit glyph indices.
+                return GlyphIndex < 0xFFFF
+                    ? static_cast<std::uint16_t>(GlyphIndex)
+                    : 0;
+            }
+        }
+
+        return 0;
+    }
+
+    if (CodePoint > 0xFFFF)
+    {
+        return 0;
+    }
+
+    std::size_t SegmentCountX2 = ::LvglWindowsGdiFontReadUInt16(Base + 6);
+    std::size_t EndCodeOffset = 14;
+    std::size_t StartCodeOffset = EndCodeOffset + SegmentCountX2 + 2;
+    std::size_t IdDeltaOffset = StartCodeOffset + SegmentCountX2;
+    std::size_t IdRangeOffsetOffset = IdDeltaOffset + SegmentCountX2;
+
+    // Find the first segment whose end code is not below the code point.
+    std::size_t Low = 0;
+    std::size_t High = SegmentCountX2 / 2;
+    while (Low < High)
+    {
+        std::size_t Middle = (Low + High) / 2;
+        if (::LvglWindowsGdiFontReadUInt16(
+            Base + EndCodeOffset + Middle * 2) < CodePoint)
+        {
+            Low = Middle + 1;
+        }
+        else
+        {
+            High = Middle;
+        }
+    }
+    if (Low == SegmentCountX2 / 2)
+    {
+        return 0;
+    }
+
+    std::uint16_t StartCode = ::LvglWindowsGdiFontReadUInt16(
+        Base + StartCodeOffset + Low * 2);
+    if (CodePoint < StartCode)
+    {
+        return 0;
+    }
+
+    std::uint16_t IdDelta = ::LvglWindowsGdiFontReadUInt16(
+        Base + IdDeltaOffset + Low * 2);
+    std::size_t IdRangeOffsetAddress = IdRangeOffsetOffset + Low * 2;
+    std::uint16_t IdRangeOffset = ::LvglWindowsGdiFontReadUInt16(
+        Base + IdRangeOffsetAddress);
+    if (!IdRangeOffset)
+    {
+        return static_cast<std::uint16_t>(CodePoint + IdDelta);
+    }
+
+    std::size_t GlyphAddress = IdRangeOffsetAddress
+        + IdRangeOffset
+        + (CodePoint - StartCode) * 2;
+    if (GlyphAddress + 2 > Length)
+    {
+        return 0;
+    }
+
+    std::uint16_t GlyphIndex = ::LvglWindowsGdiFontReadUInt16(
+        Base + GlyphAddress);
+    return GlyphIndex
+        ? static_cast<std::uint16_t>(GlyphIndex + IdDelta)
+        : 0;
+}
+
+static bool LvglWindowsGdiFontGetGlyphIndex(
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend,
+    PLVGL_WINDOWS_GDI_FONT_FACE Face,
+    std::uint32_t CodePoint,
+    std::uint16_t* GlyphIndex)
+{
+    if (Face->CharacterMap->Format)
+    {
+        std::uint16_t Result = ::LvglWindowsGdiFontLookupCharacterMap(
+            Face,
+            CodePoint);
+        *GlyphIndex = Result ? Result : 0xffff;
+        return true;
+    }
+
+    // Without a cmap table only the code points which are a single UTF-16
+    // code unit can be mapped.
+    if (CodePoint > 0xFFFF || (CodePoint >= 0xD800 && CodePoint <= 0xDFFF))
+    {
+        *GlyphIndex = 0xffff;
+        return true;
+    }
+
+    wchar_t CodeUnit = static_cast<wchar_t>(CodePoint);
+    return Backend->GetGlyphIndices(Face, &CodeUnit, 1, GlyphIndex);
+}
+
+static void LvglWindowsGdiFontAddFaceRange(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t CodePoint,
+    std::uint32_t FaceIndex)
+{
+    std::lock_guard<std::mutex> Guard(Context->Family->FaceRangeLock);
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE_RANGE>& Ranges =
+        Context->Family->FaceRanges;
+
+    auto Next = std::upper_bound(
+        Ranges.begin(),
+        Ranges.end(),
+        CodePoint,
+        [](
+            std::uint32_t Value,
+            const LVGL_WINDOWS_GDI_FONT_FACE_RANGE& Range)
+        {
+            return Value < Range.FirstCodePoint;
+        });
+
+    bool JoinPrevious = Next != Ranges.begin()
+        && (Next - 1)->FaceIndex == FaceIndex
+        && (Next - 1)->LastCodePoint + 1 == CodePoint;
+    bool JoinNext = Next != Ranges.end()
+        && Next->FaceIndex == FaceIndex
+        && Next->FirstCodePoint == CodePoint + 1;
+
+    if (JoinPrevious && JoinNext)
+    {
+        (Next - 1)->LastCodePoint = Next->LastCodePoint;
+        Ranges.erase(Next);
+    }
+    else if (JoinPrevious)
+    {
+        (Next - 1)->LastCodePoint = CodePoint;
+    }
+    else if (JoinNext)
+    {
+        Next->FirstCodePoint = CodePoint;
+    }
+    else
+    {
+        LVGL_WINDOWS_GDI_FONT_FACE_RANGE Range;
+        Range.FirstCodePoint = CodePoint;
+        Range.LastCodePoint = CodePoint;
+        Range.FaceIndex = FaceIndex;
+        Ranges.insert(Next, Range);
+    }
+}
+
+static std::uint32_t LvglWindowsGdiFontFindFace(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t CodePoint)
+{
+    std::lock_guard<std::mutex> Guard(Context->Family->FaceRangeLock);
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE_RANGE>& Ranges =
+        Context->Family->FaceRanges;
+
+    auto Next = std::upper_bound(
+        Ranges.begin(),
+        Ranges.end(),
+        CodePoint,
+        [](
+            std::uint32_t Value,
+            const LVGL_WINDOWS_GDI_FONT_FACE_RANGE& Range)
+        {
+            return Value < Range.FirstCodePoint;
+        });
+    if (Next != Ranges.begin() && (Next - 1)->LastCodePoint >= CodePoint)
+    {
+        return (Next - 1)->FaceIndex;
+    }
+
+    return LvglWindowsGdiFontInvalidIndex;
+}
+
+static void LvglWindowsGdiFontResolveFaces(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    const std::uint32_t* CodePoints,
+    std::size_t Count)
+{
+    std::vector<std::uint32_t> Pending;
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        if (::LvglWindowsGdiFontFindFace(
+            Context,
+            CodePoints[i]) == LvglWindowsGdiFontInvalidIndex
+            && !::LvglWindowsGdiFontIsGlyphMissing(Context, CodePoints[i]))
+        {
+            Pending.push_back(CodePoints[i]);
+        }
+    }
+
+    bool IsFailed = false;
+
+    std::vector<std::uint32_t> Remaining;
+    std::vector<wchar_t> InBuffer;
+    std::vector<std::uint16_t> OutBuffer;
+
+    for (std::size_t i = 0; i < Context->FaceSet.size() && !Pending.empty(); ++i)
+    {
+        PLVGL_WINDOWS_GDI_FONT_FACE Face = &Context->FaceSet[i];
+        std::uint32_t FaceIndex = static_cast<std::uint32_t>(i);
+
+        Remaining.clear();
+
+        if (Face->CharacterMap->Format)
+        {
+            for (std::uint32_t CodePoint : Pending)
+            {
+                if (::LvglWindowsGdiFontLookupCharacterMap(Face, CodePoint))
+                {
+                    ::LvglWindowsGdiFontAddFaceRange(
+                        Context,
+                        CodePoint,
+                        FaceIndex);
+                }
+                else
+                {
+                    Remaining.push_back(CodePoint);
+                }
+            }
+        }
+        else
+        {
+            // Query every code unit of the batch with one call.
+            InBuffer.clear();
+            for (std::uint32_t CodePoint : Pending)
+            {
+                if (CodePoint <= 0xFFFF
+                    && !(CodePoint >= 0xD800 && CodePoint <= 0xDFFF))
+                {
+                    InBuffer.push_back(static_cast<wchar_t>(CodePoint));
+                }
+            }
+
+            OutBuffer.assign(InBuffer.size(), 0xffff);
+            if (!InBuffer.empty() && !Context->Backend->GetGlyphIndices(
+                Face,
+                &InBuffer[0],
+                InBuffer.size(),
+                &OutBuffer[0]))
+            {
+                IsFailed = true;
+                continue;
+            }
+
+            std::size_t Index = 0;
+            for (std::uint32_t CodePoint : Pending)
+            {
+                if (CodePoint <= 0xFFFF
+                    && !(CodePoint >= 0xD800 && CodePoint <= 0xDFFF)
+                    && OutBuffer[Index++] != 0xffff)
+                {
+                    ::LvglWindowsGdiFontAddFaceRange(
+                        Context,
+                        CodePoint,
+                        FaceIndex);
+                }
+                else
+                {
+                    Remaining.push_back(CodePoint);
+                }
+            }
+        }
+
+        Pending.swap(Remaining);
+    }
+
+    if (!IsFailed)
+    {
+        for (std::uint32_t CodePoint : Pending)
+        {
+            ::LvglWindowsGdiFontMarkGlyphMissing(Context, CodePoint);
+        }
+    }
+}
+
+static std::uint32_t LvglWindowsGdiFontResolveFace(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t CodePoint,
+    std::uint16_t* GlyphIndex)
+{
+    std::uint32_t FaceIndex = ::LvglWindowsGdiFontFindFace(
+        Context,
+        CodePoint);
+    if (FaceIndex != LvglWindowsGdiFontInvalidIndex)
+    {
+        if (!::LvglWindowsGdiFontGetGlyphIndex(
+            Context->Backend,
+            &Context->FaceSet[FaceIndex],
+            CodePoint,
+            GlyphIndex))
+        {
+            return LvglWindowsGdiFontInvalidIndex;
+        }
+        return FaceIndex;
+    }
+
+    bool IsMissing = true;
+
+    for (std::size_t i = 0; i < Context->FaceSet.size(); ++i)
+    {
+        if (!::LvglWindowsGdiFontGetGlyphIndex(
+            Context->Backend,
+            &Context->FaceSet[i],
+            CodePoint,
+            GlyphIndex))
+        {
+            // Only remember the code point as missing when every face has
+            // answered.
+            IsMissing = false;
+            continue;
+        }
+
+        if (*GlyphIndex != 0xffff)
+        {
+            FaceIndex = static_cast<std::uint32_t>(i);
+            ::LvglWindowsGdiFontAddFaceRange(Context, CodePoint, FaceIndex);
+            return FaceIndex;
+        }
+    }
+
+    if (IsMissing)
+    {
+        ::LvglWindowsGdiFontMarkGlyphMissing(Context, CodePoint);
+    }
+
+    return LvglWindowsGdiFontInvalidIndex;
+}
+
+static void LvglWindowsGdiFontLoadKerningPairs(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_PAIR> Pairs;
+    if (!Context->Backend->GetKerningPairs(&Context->FaceSet[0], Pairs))
+    {
+        return;
+    }
+    std::size_t PairCount = Pairs.size();
+
+    std::size_t TableSize = 1;
+    std::uint32_t TableShift = 32;
+    while (TableSize < PairCount * 2)
+    {
+        TableSize <<= 1;
+        --TableShift;
+    }
+
+    LVGL_WINDOWS_GDI_FONT_KERNING_SLOT EmptySlot;
+    EmptySlot.LetterPair = LvglWindowsGdiFontInvalidIndex;
+    EmptySlot.Amount = 0;
+
+    std::vector<LVGL_WINDOWS_GDI_FONT_KERNING_SLOT> Table(TableSize, EmptySlot);
+    std::size_t Mask = TableSize - 1;
+
+    for (std::size_t i = 0; i < PairCount; ++i)
+    {
+        if (!Pairs[i].Amount)
+        {
+            continue;
+        }
+
+        // The pairs only apply when both letters are drawn with the main
+        // face. It is the first face tried, so it draws every letter it has a
+        // glyph for, and the other letters must not use its pairs.
+        std::uint16_t FirstGlyphIndex = 0xffff;
+        std::uint16_t SecondGlyphIndex = 0xffff;
+        if (!::LvglWindowsGdiFontGetGlyphIndex(
+            Context->Backend,
+            &Context->FaceSet[0],
+            Pairs[i].First,
+            &FirstGlyphIndex)
+            || FirstGlyphIndex == 0xffff
+            || !::LvglWindowsGdiFontGetGlyphIndex(
+                Context->Backend,
+                &Context->FaceSet[0],
+                Pairs[i].Second,
+                &SecondGlyphIndex)
+            || SecondGlyphIndex == 0xffff)
+        {
+            continue;
+        }
+
+        std::uint32_t LetterPair =
+            (static_cast<std::uint32_t>(Pairs[i].First) << 16)
+            | Pairs[i].Second;
+
+        std::size_t Index = ::LvglWindowsGdiFontGetTableSlot(
+            LetterPair,
+            TableShift);
+        while (Table[Index].LetterPair != LvglWindowsGdiFontInvalidIndex
+            && Table[Index].LetterPair != LetterPair)
+        {
+            Index = (Index + 1) & Mask;
+        }
+
+        Table[Index].LetterPair = LetterPair;
+        Table[Index].Amount = Pairs[i].Amount;
+    }
+
+    Context->KerningTable.swap(Table);
+    Context->KerningTableShift = TableShift;
+}
+
+static std::int32_t LvglWindowsGdiFontGetKerning(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t UnicodeLetter,
+    std::uint32_t UnicodeLetterNext)
+{
+    if (Context->KerningTable.empty()
+        || UnicodeLetter > 0xFFFF
+        || UnicodeLetterNext > 0xFFFF)
+    {
+        return 0;
+    }
+
+    std::uint32_t LetterPair = (UnicodeLetter << 16) | UnicodeLetterNext;
+
+    std::size_t Mask = Context->KerningTable.size() - 1;
+    std::size_t Index = ::LvglWindowsGdiFontGetTableSlot(
+        LetterPair,
+        Context->KerningTableShift);
+    for (;;)
+    {
+        LVGL_WINDOWS_GDI_FONT_KERNING_SLOT& Slot = Context->KerningTable[Index];
+        if (Slot.LetterPair == LetterPair)
+        {
+            return Slot.Amount;
+        }
+        if (Slot.LetterPair == LvglWindowsGdiFontInvalidIndex)
+        {
+            return 0;
+        }
+
+        Index = (Index + 1) & Mask;
+    }
+}
+
+static std::uint32_t LvglWindowsGdiFontAllocateGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache)
+{
+    std::uint32_t GlyphIndex = Cache->FreeGlyph;
+    if (GlyphIndex != LvglWindowsGdiFontInvalidIndex)
+    {
+        Cache->FreeGlyph = ::LvglWindowsGdiFontGetGlyph(
+            Cache,
+            GlyphIndex)->NextFree;
+        return GlyphIndex;
+    }
+
+    GlyphIndex = Cache->GlyphCapacity;
+    if (GlyphIndex % LvglWindowsGdiFontGlyphChunkSize == 0)
+    {
+        std::size_t ChunkIndex = GlyphIndex / LvglWindowsGdiFontGlyphChunkSize;
+        if (ChunkIndex >= LvglWindowsGdiFontMaximumGlyphChunks)
+        {
+            return LvglWindowsGdiFontInvalidIndex;
+        }
+
+        Cache->GlyphChunks[ChunkIndex].store(
+            new LVGL_WINDOWS_GDI_FONT_GLYPH[LvglWindowsGdiFontGlyphChunkSize](),
+            std::memory_order_release);
+    }
+    ++Cache->GlyphCapacity;
+
+    return GlyphIndex;
+}
+
+static void LvglWindowsGdiFontCommitGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t GlyphIndex)
+{
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+        Cache,
+        GlyphIndex);
+
+    Glyph->IsReferenced = true;
+    ::LvglWindowsGdiFontInsertGlyphIndex(
+        Cache,
+        Glyph->CodePoint,
+        GlyphIndex);
+    ++Cache->GlyphCount;
+
+    std::size_t ResidentSize =
+        ::LvglWindowsGdiFontGetGlyphResidentSize(Glyph);
+    Cache->ResidentSize += ResidentSize;
+    Context->ResidentSize += ResidentSize;
+}
+
+/**
+ * @brief Rasterizes a glyph and adds it to a glyph cache, the caller must hold
+ *        the lock of the context. Only the LVGL thread may evict glyphs to fit
+ *        the budget, it is the only user of the returned glyphs.
+*/
+static PLVGL_WINDOWS_GDI_FONT_GLYPH LvglWindowsGdiFontAddGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t UnicodeLetter,
+    bool CanEvict)
+{
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Result = nullptr;
+
+    do
+    {
+        std::uint16_t OutBuffer[2];
+        OutBuffer[0] = 0;
+        OutBuffer[1] = 0;
+
+        std::uint32_t FaceIndex = ::LvglWindowsGdiFontResolveFace(
+            Context,
+            UnicodeLetter,
+            &OutBuffer[0]);
+        if (FaceIndex == LvglWindowsGdiFontInvalidIndex)
+        {
+            break;
+        }
+
+        LVGL_WINDOWS_GDI_FONT_GLYPH_METRICS GlyphMetrics;
+        std::uint8_t* GlyphBitmap = nullptr;
+        if (Context->Backend->RasterizeGlyph(
+            &Context->FaceSet[FaceIndex],
+            OutBuffer[0],
+            &Cache->Scale,
+            &GlyphMetrics,
+            Context->RasterBuffer))
+        {
+            // An empty box lets LVGL skip the glyphs without pixels without
+            // asking for a bitmap.
+            std::uint32_t BoxWidth = 0;
+            std::uint32_t BoxHeight = 0;
+            std::uint32_t BitmapSize = 0;
+
+            // The subpixel glyphs are rasterized 3 times wider, their advance
+            // width and offset are converted back to pixels.
+            std::int32_t AdvanceWidth = GlyphMetrics.AdvanceWidth;
+            std::int32_t OffsetX = GlyphMetrics.OriginX;
+            if (Context->IsSubpixel)
+            {
+                AdvanceWidth = (AdvanceWidth + 1) / 3;
+            }
+
+            if (!GlyphMetrics.IsBlank)
+            {
+                BoxWidth = GlyphMetrics.BoxWidth;
+                BoxHeight = GlyphMetrics.BoxHeight;
+
+                std::uint8_t* Pixels = &Context->RasterBuffer[0];
+                if (Context->IsSubpixel)
+                {
+                    ::LvglWindowsGdiFontFilterSubpixels(
+                        Context->SubpixelBuffer,
+                        Pixels,
+                        BoxWidth,
+                        BoxHeight,
+                        OffsetX,
+                        &BoxWidth,
+                        &OffsetX);
+                    Pixels = &Context->SubpixelBuffer[0];
+                }
+
+                std::size_t PixelCount = BoxWidth * BoxHeight;
+                BitmapSize = static_cast<std::uint32_t>(
+                    (PixelCount * Context->GlyphBpp + 7) / 8);
+                GlyphBitmap = ::LvglWindowsGdiFontArenaAllocate(
+                    &Cache->GlyphBitmapArena,
+                    BitmapSize);
+                if (!GlyphBitmap)
+                {
+                    break;
+                }
+
+                if (Context->GlyphBpp == 8)
+                {
+                    std::memcpy(GlyphBitmap, Pixels, PixelCount);
+                }
+                else
+                {
+                    ::LvglWindowsGdiFontPackCoverage(
+                        GlyphBitmap,
+                        Pixels,
+                        PixelCount,
+                        Context->GlyphBpp);
+                }
+            }
+
+            std::uint32_t GlyphIndex = ::LvglWindowsGdiFontAllocateGlyph(Cache);
+            if (GlyphIndex == LvglWindowsGdiFontInvalidIndex)
+            {
+                if (GlyphBitmap)
+                {
+                    ::LvglWindowsGdiFontArenaFree(
+                        &Cache->GlyphBitmapArena,
+                        GlyphBitmap,
+                        BitmapSize);
+                }
+                break;
+            }
+            PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+                Cache,
+                GlyphIndex);
+
+            Glyph->Description.adv_w = static_cast<std::uint16_t>(AdvanceWidth);
+            Glyph->Description.box_w = static_cast<std::uint16_t>(BoxWidth);
+            Glyph->Description.box_h = static_cast<std::uint16_t>(BoxHeight);
+            Glyph->Description.ofs_x = static_cast<std::int16_t>(OffsetX);
+            Glyph->Description.ofs_y = static_cast<std::int16_t>(
+                GlyphMetrics.OriginY
+                - static_cast<std::int32_t>(GlyphMetrics.BoxHeight));
+            Glyph->Description.bpp = Context->GlyphBpp;
+            Glyph->Bitmap = GlyphBitmap;
+            Glyph->BitmapSize = BitmapSize;
+            Glyph->IsMapped = false;
+            Glyph->IsPlaceholder = false;
+            Glyph->CodePoint = UnicodeLetter;
+
+            ::LvglWindowsGdiFontCommitGlyph(Context, Cache, GlyphIndex);
+            if (CanEvict)
+            {
+                ::LvglWindowsGdiFontEnforceBudget(Context, GlyphIndex);
+            }
+
+            Result = Glyph;
+        }
+
+    } while (false);
+
+    return Result;
+}
+
+/**
+ * @brief Gets the glyph cache for a DPI value and creates it if needed, the
+ *        caller must hold the lock of the context.
+*/
+static PLVGL_WINDOWS_GDI_FONT_CACHE LvglWindowsGdiFontGetCache(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t DpiValue)
+{
+    auto Iterator = Context->CacheSet.find(DpiValue);
+    if (Iterator == Context->CacheSet.end())
+    {
+        // The caches hold atomics and cannot be moved, construct it in place.
+        PLVGL_WINDOWS_GDI_FONT_CACHE Cache = &Context->CacheSet[DpiValue];
+
+        Cache->DpiValue = DpiValue;
+
+        Cache->Scale.Y = static_cast<std::int32_t>(
+            static_cast<std::uint64_t>(DpiValue) * 65536
+            / USER_DEFAULT_SCREEN_DPI);
+        Cache->Scale.X = Context->IsSubpixel
+            ? static_cast<std::int32_t>(
+                static_cast<std::uint64_t>(DpiValue) * 3 * 65536
+                / USER_DEFAULT_SCREEN_DPI)
+            : Cache->Scale.Y;
+
+        ::LvglWindowsGdiFontInitializeCache(Cache);
+
+        return Cache;
+    }
+
+    return &Iterator->second;
+}
+
+/**
+ * @brief Switches the current glyph cache, it must only be called from the
+ *        LVGL thread with the lock of the context held.
+*/
+static void LvglWindowsGdiFontSelectCache(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t DpiValue)
+{
+    Context->Cache = ::LvglWindowsGdiFontGetCache(Context, DpiValue);
+
+    // The queued metrics are for the previous DPI value, the worker thread
+    // only fills the current cache.
+    Context->PendingGlyphs.clear();
+    Context->PlaceholderGlyphs.clear();
+
+    Context->LastCodePoint = LvglWindowsGdiFontInvalidIndex;
+    Context->LastGlyph = nullptr;
+}
+
+/**
+ * @brief Queues a glyph for the worker thread and returns a placeholder with
+ *        its metrics and an empty box. The caller must hold the lock of the
+ *        context and run on the LVGL thread.
+*/
+static PLVGL_WINDOWS_GDI_FONT_GLYPH LvglWindowsGdiFontQueueGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::uint32_t UnicodeLetter)
+{
+    std::uint16_t GlyphIndex = 0;
+    std::uint32_t FaceIndex = ::LvglWindowsGdiFontResolveFace(
+        Context,
+        UnicodeLetter,
+        &GlyphIndex);
+    if (FaceIndex == LvglWindowsGdiFontInvalidIndex)
+    {
+        return nullptr;
+    }
+
+    // Only the metrics, the outline is not rendered.
+    LVGL_WINDOWS_GDI_FONT_GLYPH_METRICS GlyphMetrics;
+    if (!Context->Backend->GetGlyphMetrics(
+        &Context->FaceSet[FaceIndex],
+        GlyphIndex,
+        &Cache->Scale,
+        &GlyphMetrics))
+    {
+        return nullptr;
+    }
+
+    std::int32_t AdvanceWidth = GlyphMetrics.AdvanceWidth;
+    if (Context->IsSubpixel)
+    {
+        AdvanceWidth = (AdvanceWidth + 1) / 3;
+    }
+
+    LVGL_WINDOWS_GDI_FONT_GLYPH& Glyph =
+        Context->PlaceholderGlyphs[UnicodeLetter];
+    std::memset(&Glyph.Description, 0, sizeof(Glyph.Description));
+    Glyph.Description.adv_w = static_cast<std::uint16_t>(AdvanceWidth);
+    Glyph.Description.bpp = Context->GlyphBpp;
+    Glyph.Bitmap = nullptr;
+    Glyph.BitmapSize = 0;
+    Glyph.IsMapped = false;
+    Glyph.IsReferenced = false;
+    Glyph.IsPlaceholder = true;
+    Glyph.CodePoint = UnicodeLetter;
+    Glyph.NextFree = LvglWindowsGdiFontInvalidIndex;
+
+    Context->PendingGlyphs.insert(UnicodeLetter);
+    Context->WorkerCondition.notify_one();
+
+    return &Glyph;
+}
+
+/**
+ * @brief Drops the placeholders of the glyphs the worker thread is done with.
+ *        The caller must hold the lock of the context and run on the LVGL
+ *        thread.
+*/
+static void LvglWindowsGdiFontPrunePlaceholders(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    for (auto Iterator = Context->PlaceholderGlyphs.begin();
+        Iterator != Context->PlaceholderGlyphs.end();)
+    {
+        if (Context->PendingGlyphs.count(Iterator->first))
+        {
+            ++Iterator;
+        }
+        else
+        {
+            Iterator = Context->PlaceholderGlyphs.erase(Iterator);
+        }
+    }
+}
+
+static PLVGL_WINDOWS_GDI_FONT_GLYPH LvglWindowsGdiFontResolveGlyph(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    std::uint32_t UnicodeLetter)
+{
+    // Only a relaxed load on the hot path, the caches are switched here on
+    // the LVGL thread after LvglWindowsGdiFontNotifyDpiChanged is called.
+    std::uint32_t DpiValue = g_LvglWindowsGdiFontDpiValue.load(
+        std::memory_order_relaxed);
+    if (DpiValue != Context->Cache->DpiValue)
+    {
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+        ::LvglWindowsGdiFontSelectCache(Context, DpiValue);
+    }
+
+    if (Context->LastGlyph && Context->LastCodePoint == UnicodeLetter)
+    {
+        ::LvglWindowsGdiFontIncrementCounter(Context->LastGlyphHits);
+        return Context->LastGlyph;
+    }
+
+    ::LvglWindowsGdiFontIncrementCounter(Context->LastGlyphMisses);
+
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache = Context->Cache;
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = nullptr;
+
+    // The hits do not take the lock, other threads only add glyphs and the
+    // glyphs are only evicted from this thread.
+    std::uint32_t GlyphIndex = ::LvglWindowsGdiFontFindGlyph(
+        Cache,
+        UnicodeLetter);
+    if (GlyphIndex != LvglWindowsGdiFontInvalidIndex)
+    {
+        ::LvglWindowsGdiFontIncrementCounter(Context->CacheHits);
+
+        Glyph = ::LvglWindowsGdiFontGetGlyph(Cache, GlyphIndex);
+        Glyph->IsReferenced = true;
+    }
+    else
+    {
+        if (UnicodeLetter <= 0xFFFF
+            && ::LvglWindowsGdiFontIsGlyphMissing(Context, UnicodeLetter))
+        {
+            ::LvglWindowsGdiFontIncrementCounter(Context->MissingGlyphHits);
+            return nullptr;
+        }
+
+        // The letters waiting for the worker thread do not need the lock,
+        // the placeholders are only used on this thread.
+        if (Context->IsAsynchronous)
+        {
+            auto Iterator = Context->PlaceholderGlyphs.find(UnicodeLetter);
+            if (Iterator != Context->PlaceholderGlyphs.end())
+            {
+                return &Iterator->second;
+            }
+        }
+
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+
+        // Another thread may have added the glyph meanwhile.
+        GlyphIndex = ::LvglWindowsGdiFontFindGlyph(Cache, UnicodeLetter);
+        if (GlyphIndex != LvglWindowsGdiFontInvalidIndex)
+        {
+            ::LvglWindowsGdiFontIncrementCounter(Context->CacheHits);
+
+            Glyph = ::LvglWindowsGdiFontGetGlyph(Cache, GlyphIndex);
+        }
+        else
+        {
+            if (::LvglWindowsGdiFontIsGlyphMissing(Context, UnicodeLetter))
+            {
+                ::LvglWindowsGdiFontIncrementCounter(
+                    Context->MissingGlyphHits);
+                return nullptr;
+            }
+
+            if (Context->IsAsynchronous)
+            {
+                // Not remembered as the last glyph, it is replaced by the
+                // real one as soon as the worker thread is done.
+                return ::LvglWindowsGdiFontQueueGlyph(
+                    Context,
+                    Cache,
+                    UnicodeLetter);
+            }
+
+            ++Context->CacheMisses;
+
+            Glyph = ::LvglWindowsGdiFontAddGlyph(
+                Context,
+                Cache,
+                UnicodeLetter,
+                true);
+            if (!Glyph)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    Context->LastCodePoint = UnicodeLetter;
+    Context->LastGlyph = Glyph;
+
+    return Glyph;
+}
+
+static std::size_t LvglWindowsGdiFontPrewarmGlyphs(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    const std::uint32_t* CodePoints,
+    std::size_t Count)
+{
+    // The current cache belongs to the LVGL thread, fill the cache for the
+    // DPI value it will switch to.
+    std::uint32_t DpiValue = g_LvglWindowsGdiFontDpiValue.load(
+        std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+
+        // Resolve the owning faces of the whole batch first, so each face is
+        // queried once for all the new letters.
+        ::LvglWindowsGdiFontResolveFaces(Context, CodePoints, Count);
+    }
+
+    std::size_t Rasterized = 0;
+
+    for (std::size_t i = 0; i < Count; ++i)
+    {
+        // Lock each glyph separately, so a miss on the LVGL thread waits for
+        // one rasterization at most.
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+
+        PLVGL_WINDOWS_GDI_FONT_CACHE Cache = ::LvglWindowsGdiFontGetCache(
+            Context,
+            DpiValue);
+
+        if (::LvglWindowsGdiFontFindGlyph(
+            Cache,
+            CodePoints[i]) != LvglWindowsGdiFontInvalidIndex)
+        {
+            continue;
+        }
+
+        if (::LvglWindowsGdiFontIsGlyphMissing(Context, CodePoints[i]))
+        {
+            continue;
+        }
+
+        ++Context->CacheMisses;
+
+        // The LVGL thread may be drawing any cached glyph, the budget is
+        // enforced on its next miss instead.
+        if (::LvglWindowsGdiFontAddGlyph(
+            Context,
+            Cache,
+            CodePoints[i],
+            false))
+        {
+            ++Rasterized;
+        }
+    }
+
+    return Rasterized;
+}
+
+static void LvglWindowsGdiFontWorkerLoop(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    for (;;)
+    {
+        std::unique_lock<std::mutex> Guard(Context->Lock);
+        Context->WorkerCondition.wait(Guard, [Context]()
+        {
+            return Context->IsWorkerStopping
+                || !Context->PendingGlyphs.empty();
+        });
+        if (Context->IsWorkerStopping)
+        {
+            break;
+        }
+
+        // The lock is released after each glyph, so a miss on the LVGL thread
+        // waits for one rasterization at most.
+        std::uint32_t CodePoint = *Context->PendingGlyphs.begin();
+
+        PLVGL_WINDOWS_GDI_FONT_CACHE Cache = Context->Cache;
+        if (::LvglWindowsGdiFontFindGlyph(
+            Cache,
+            CodePoint) == LvglWindowsGdiFontInvalidIndex
+            && !::LvglWindowsGdiFontIsGlyphMissing(Context, CodePoint))
+        {
+            ++Context->CacheMisses;
+
+            // The LVGL thread may be drawing any cached glyph, the budget is
+            // enforced by the redraw timer instead.
+            ::LvglWindowsGdiFontAddGlyph(Context, Cache, CodePoint, false);
+        }
+
+        Context->PendingGlyphs.erase(CodePoint);
+        Context->IsRedrawPending.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Keeps the area LVGL draws a placeholder glyph into, for the redraw
+ *        timer. The measurements of the layout already get the real advance
+ *        width and need no redraw. Only called on the LVGL thread.
+*/
+static void LvglWindowsGdiFontTrackPlaceholder(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    // LVGL 8.3 points the clip area of the draw context to the visible area
+    // of the object being drawn while the rendering is in progress, and
+    // leaves it dangling afterwards.
+    lv_disp_t* Display = ::_lv_refr_get_disp_refreshing();
+    if (!Display
+        || !Display->rendering_in_progress
+        || !Display->driver->draw_ctx
+        || !Display->driver->draw_ctx->clip_area)
+    {
+        return;
+    }
+    const lv_area_t* Area = Display->driver->draw_ctx->clip_area;
+
+    // The letters of a label share its area. Past the size of the invalid
+    // area buffer of LVGL, which would redraw the whole screen, the areas are
+    // joined instead.
+    PLVGL_WINDOWS_GDI_FONT_DIRTY_AREA Joined = nullptr;
+    for (LVGL_WINDOWS_GDI_FONT_DIRTY_AREA& Tracked : Context->PlaceholderAreas)
+    {
+        if (Tracked.Display != Display)
+        {
+            continue;
+        }
+        if (Area->x1 >= Tracked.Area.x1
+            && Area->y1 >= Tracked.Area.y1
+            && Area->x2 <= Tracked.Area.x2
+            && Area->y2 <= Tracked.Area.y2)
+        {
+            return;
+        }
+        Joined = &Tracked;
+    }
+
+    if (Joined && Context->PlaceholderAreas.size() >= LV_INV_BUF_SIZE)
+    {
+        ::_lv_area_join(&Joined->Area, &Joined->Area, Area);
+        return;
+    }
+
+    LVGL_WINDOWS_GDI_FONT_DIRTY_AREA Tracked;
+    Tracked.Display = Display;
+    Tracked.Area = *Area;
+    Context->PlaceholderAreas.push_back(Tracked);
+}
+
+static void LvglWindowsGdiFontRedrawTimerCallback(
+    lv_timer_t* timer)
+{
+    const lv_font_t* FontObject =
+        reinterpret_cast<const lv_font_t*>(timer->user_data);
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
+
+    if (!Context->IsRedrawPending.exchange(false, std::memory_order_acquire))
+    {
+        return;
+    }
+
+    {
+        // The timers run between the frames, no glyph is being drawn.
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+        ::LvglWindowsGdiFontPrunePlaceholders(Context);
+        ::LvglWindowsGdiFontEnforceBudget(
+            Context,
+            LvglWindowsGdiFontInvalidIndex);
+    }
+
+    // The letters still queued track their areas again when redrawn. The
+    // areas of the displays removed since are dropped.
+    std::vector<LVGL_WINDOWS_GDI_FONT_DIRTY_AREA> PlaceholderAreas;
+    PlaceholderAreas.swap(Context->PlaceholderAreas);
+    for (lv_disp_t* Display = ::lv_disp_get_next(nullptr);
+        Display;
+        Display = ::lv_disp_get_next(Display))
+    {
+        for (const LVGL_WINDOWS_GDI_FONT_DIRTY_AREA& Tracked : PlaceholderAreas)
+        {
+            if (Tracked.Display == Display)
+            {
+                ::_lv_inv_area(Display, &Tracked.Area);
+            }
+        }
+    }
+}
+
+static bool LvglWindowsGdiFontGetGlyphCallback(
+    const lv_font_t* font,
+    lv_font_glyph_dsc_t* dsc_out,
+    uint32_t unicode_letter,
+    uint32_t unicode_letter_next)
+{
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(font->dsc));
+
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontResolveGlyph(
+        Context,
+        unicode_letter);
+    if (!Glyph)
+    {
+        return false;
+    }
+
+    std::memcpy(
+        dsc_out,
+        &Glyph->Description,
+        sizeof(lv_font_glyph_dsc_t));
+
+    // Only counted and tracked here, LVGL asks for no bitmap of an empty box.
+    if (Glyph->IsPlaceholder)
+    {
+        ::LvglWindowsGdiFontIncrementCounter(Context->PlaceholderHits);
+        ::LvglWindowsGdiFontTrackPlaceholder(Context);
+    }
+
+    if (unicode_letter_next)
+    {
+        std::int32_t Amount = ::LvglWindowsGdiFontGetKerning(
+            Context,
+            unicode_letter,
+            unicode_letter_next);
+        if (Amount)
+        {
+            // The pairs are measured at 96 DPI like the font size, scale them
+            // like the glyphs and round half away from zero.
+            std::int32_t DpiValue =
+                static_cast<std::int32_t>(Context->Cache->DpiValue);
+            std::int32_t Scaled = Amount * DpiValue;
+            Scaled = (Scaled >= 0)
+                ? (Scaled + USER_DEFAULT_SCREEN_DPI / 2)
+                / USER_DEFAULT_SCREEN_DPI
+                : -((USER_DEFAULT_SCREEN_DPI / 2 - Scaled)
+                    / USER_DEFAULT_SCREEN_DPI);
+            std::int32_t AdvanceWidth = dsc_out->adv_w + Scaled;
+            dsc_out->adv_w = static_cast<std::uint16_t>(
+                AdvanceWidth > 0 ? AdvanceWidth : 0);
+        }
+    }
+
+    return true;
+}
+
+static const uint8_t* LvglWindowsGdiFontGetGlyphBitmapCallback(
+    const lv_font_t* font,
+    uint32_t unicode_letter)
+{
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(font->dsc));
+
+    PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontResolveGlyph(
+        Context,
+        unicode_letter);
+    if (!Glyph)
+    {
+        return nullptr;
+    }
+
+    return Glyph->Bitmap;
+}
+
+/**
+ * @brief Finds the family of a fallback chain or creates it from the faces of
+ *        the first LVGL font object which uses it.
+*/
+static PLVGL_WINDOWS_GDI_FONT_FAMILY LvglWindowsGdiFontAcquireFamily(
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend,
+    const std::vector<LVGL_WINDOWS_GDI_FONT_SOURCE>& Sources,
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE>& FaceSet)
+{
+    std::vector<std::wstring> Key;
+    for (const LVGL_WINDOWS_GDI_FONT_SOURCE& Source : Sources)
+    {
+        Key.push_back(Source.FontName ? Source.FontName : L"");
+    }
+    const std::uint8_t* FontData = Sources[0].FontData;
+
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsGdiFontFamilyLock);
+
+    for (PLVGL_WINDOWS_GDI_FONT_FAMILY Family : g_LvglWindowsGdiFontFamilies)
+    {
+        if (Family->Backend == Backend
+            && Family->FontNames == Key
+            && Family->FontData == FontData)
+        {
+            ++Family->ReferenceCount;
+            return Family;
+        }
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_FAMILY Family = new LVGL_WINDOWS_GDI_FONT_FAMILY();
+    Family->FontNames.swap(Key);
+    Family->FontData = FontData;
+    Family->Backend = Backend;
+    Family->ReferenceCount = 1;
+
+    Family->CharacterMaps.resize(FaceSet.size());
+    for (std::size_t i = 0; i < FaceSet.size(); ++i)
+    {
+        Family->CharacterMaps[i].Format = 0;
+        ::LvglWindowsGdiFontLoadCharacterMap(
+            Backend,
+            &FaceSet[i],
+            &Family->CharacterMaps[i]);
+    }
+
+    Backend->GetFaceName(&FaceSet[0], Family->FaceName);
+
+    // The glyph cache files are only valid for the same fallback chain.
+    std::uint32_t FaceSetHash = UINT32_C(2166136261);
+    for (LVGL_WINDOWS_GDI_FONT_FACE& Face : FaceSet)
+    {
+        wchar_t FaceName[LF_FACESIZE] = { 0 };
+        Backend->GetFaceName(&Face, FaceName);
+        // FNV-1a, including the terminator to separate the names.
+        for (std::size_t i = 0; i < LF_FACESIZE; ++i)
+        {
+            FaceSetHash ^= static_cast<std::uint16_t>(FaceName[i]);
+            FaceSetHash *= UINT32_C(16777619);
+            if (!FaceName[i])
+            {
+                break;
+            }
+        }
+    }
+    Family->FaceSetHash = FaceSetHash;
+
+    g_LvglWindowsGdiFontFamilies.push_back(Family);
+
+    return Family;
+}
+
+static void LvglWindowsGdiFontReleaseFamily(
+    PLVGL_WINDOWS_GDI_FONT_FAMILY Family)
+{
+    std::lock_guard<std::mutex> Guard(g_LvglWindowsGdiFontFamilyLock);
+
+    if (--Family->ReferenceCount)
+    {
+        return;
+    }
+
+    g_LvglWindowsGdiFontFamilies.erase(std::find(
+        g_LvglWindowsGdiFontFamilies.begin(),
+        g_LvglWindowsGdiFontFamilies.end(),
+        Family));
+    delete Family;
+}
+
+/**
+ * @brief Releases a context, the worker thread and the redraw timer must have
+ *        been stopped before.
+*/
+static void LvglWindowsGdiFontReleaseContext(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    for (auto& Item : Context->CacheSet)
+    {
+        ::LvglWindowsGdiFontReleaseCache(&Item.second);
+    }
+
+    for (LVGL_WINDOWS_GDI_FONT_FACE& Face : Context->FaceSet)
+    {
+        Context->Backend->ReleaseFace(&Face);
+    }
+
+    if (Context->CacheFileView)
+    {
+        ::UnmapViewOfFile(Context->CacheFileView);
+    }
+
+    if (Context->CacheFileMappingHandle)
+    {
+        ::CloseHandle(Context->CacheFileMappingHandle);
+    }
+
+    if (Context->Family)
+    {
+        ::LvglWindowsGdiFontReleaseFamily(Context->Family);
+    }
+
+    delete Context;
+}
+
+/**
+ * @brief The flags of the glyph cache files which depend on the rasterization.
+*/
+static std::uint32_t LvglWindowsGdiFontGetCacheFileFlags(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+{
+    std::uint32_t Flags = Context->IsSubpixel ? 1 : 0;
+#if LV_USE_FREETYPE
+    if (Context->Backend == &g_LvglWindowsGdiFontFreeTypeBackend)
+    {
+        Flags |= 2;
+    }
+#endif
+    return Flags;
+}
+
+/**
+ * @brief Serializes a glyph cache to the glyph cache file format, the caller
+ *        must hold the lock of the context and run on the LVGL thread, which
+ *        is the only one to update the referenced flags.
+*/
+static bool LvglWindowsGdiFontSerializeCache(
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache,
+    std::vector<std::uint8_t>& Content)
+{
+    const std::size_t AlignmentMask = LvglWindowsGdiFontArenaAlignment - 1;
+
+    // Write the glyphs most recently used first, the loading stops at the
+    // budget of the font. The CLOCK replacement keeps no order, so take the
+    // reverse of the order it would evict the glyphs in: the referenced ones,
+    // then the others, each from the last one the hand passed backwards.
+    std::vector<PLVGL_WINDOWS_GDI_FONT_GLYPH> Glyphs;
+    for (int Referenced = 1; Referenced >= 0; --Referenced)
+    {
+        for (std::uint32_t i = 1; i <= Cache->GlyphCapacity; ++i)
+        {
+            PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+                Cache,
+                (Cache->ClockHand + Cache->GlyphCapacity - i)
+                % Cache->GlyphCapacity);
+            if (Glyph->CodePoint != LvglWindowsGdiFontInvalidIndex
+                && Glyph->IsReferenced == (Referenced != 0))
+            {
+                Glyphs.push_back(Glyph);
+            }
+        }
+    }
+
+    std::vector<LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH> Records;
+    std::size_t BitmapSize = 0;
+    for (PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph : Glyphs)
+    {
+
+        LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH Record = { 0 };
+        Record.CodePoint = Glyph->CodePoint;
+        Record.BitmapOffset = static_cast<std::uint32_t>(BitmapSize);
+        Record.BitmapSize = Glyph->Bitmap ? Glyph->BitmapSize : 0;
+        Record.AdvanceWidth = Glyph->Description.adv_w;
+        Record.BoxWidth = Glyph->Description.box_w;
+        Record.BoxHeight = Glyph->Description.box_h;
+        Record.OffsetX = Glyph->Description.ofs_x;
+        Record.OffsetY = Glyph->Description.ofs_y;
+        Record.Bpp = Glyph->Description.bpp;
+        Records.push_back(Record);
+
+        BitmapSize += (Record.BitmapSize + AlignmentMask) & ~AlignmentMask;
+    }
+
+    std::size_t BitmapOffset = sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER)
+        + Records.size() * sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH);
+    BitmapOffset = (BitmapOffset + AlignmentMask) & ~AlignmentMask;
+
+    if (BitmapOffset + BitmapSize > UINT32_MAX)
+    {
+        return false;
+    }
+
+    Content.assign(BitmapOffset + BitmapSize, 0);
+
+    LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER Header = { 0 };
+    Header.Magic = LvglWindowsGdiFontCacheFileMagic;
+    Header.EngineVersion = LvglWindowsGdiFontCacheEngineVersion;
+    Header.HeaderSize = sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER);
+    Header.DpiValue = Cache->DpiValue;
+    Header.FontSize = Context->FontSize;
+    Header.FaceSetHash = Context->Family->FaceSetHash;
+    Header.Flags = ::LvglWindowsGdiFontGetCacheFileFlags(Context);
+    Header.GlyphCount = static_cast<std::uint32_t>(Records.size());
+    Header.BitmapOffset = static_cast<std::uint32_t>(BitmapOffset);
+    Header.BitmapSize = static_cast<std::uint32_t>(BitmapSize);
+    for (std::size_t i = 0; i < LF_FACESIZE; ++i)
+    {
+        Header.FaceName[i] = static_cast<std::uint16_t>(
+            Context->Family->FaceName[i]);
+    }
+    std::memcpy(&Content[0], &Header, sizeof(Header));
+
+    if (!Records.empty())
+    {
+        std::memcpy(
+            &Content[sizeof(Header)],
+            &Records[0],
+            Records.size() * sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH));
+    }
+
+    for (std::size_t i = 0; i < Records.size(); ++i)
+    {
+        LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH& Record = Records[i];
+        if (Record.BitmapSize)
+        {
+            std::memcpy(
+                &Content[BitmapOffset + Record.BitmapOffset],
+                Glyphs[i]->Bitmap,
+                Record.BitmapSize);
+        }
+    }
+
+    return true;
+}
+
+EXTERN_C void WINAPI LvglWindowsGdiFontInitialize(
+    _In_opt_ LPCWSTR FontName)
 {
-    std::uint32_t result = static_cast<std::uint32_t>(value * (1 << 16));
-    return *reinterpret_cast<FIXED*>(&result);
+    DWORD NumFonts = 0;
+    ::AddFontMemResourceEx(
+        const_cast<uint8_t*>(LvglFontAwesome5FreeLvglFontResource),
+        static_cast<DWORD>(LvglFontAwesome5FreeLvglFontResourceSize),
+        nullptr,
+        &NumFonts);
+
+    ::LvglWindowsGdiFontCreateFont(
+        &LvglDefaultFont,
+        16,
+        FontName);
 }
 
-lv_font_t LvglDefaultFont;
+EXTERN_C void WINAPI LvglWindowsGdiFontNotifyDpiChanged(
+    _In_ UINT DpiValue)
+{
+    g_LvglWindowsGdiFontDpiValue.store(
+        static_cast<std::uint32_t>(DpiValue),
+        std::memory_order_relaxed);
+}
 
-typedef struct _LVGL_WINDOWS_GDI_FONT_CONTEXT
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontCreateFont(
+    _Out_ lv_font_t* FontObject,
+    _In_ int FontSize,
+    _In_opt_ LPCWSTR FontName)
 {
-    HFONT FontHandle;
-    HFONT SymbolFontHandle;
-    using GlyphValueType = std::pair<lv_font_glyph_dsc_t, std::size_t>;
-    std::map<std::uint32_t, GlyphValueType> GlyphSet;
-    std::uint32_t DpiValue;
-    std::vector<std::uint8_t> GlyphBitmapPool;
-} LVGL_WINDOWS_GDI_FONT_CONTEXT, *PLVGL_WINDOWS_GDI_FONT_CONTEXT;
+    LVGL_WINDOWS_GDI_FONT_PARAMETERS Parameters = { 0 };
+    Parameters.FontSize = FontSize;
+    Parameters.FontName = FontName;
+    return ::LvglWindowsGdiFontCreateFontIndirect(FontObject, &Parameters);
+}
 
-static void LvglWindowsGdiFontAddGlyph(
-    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context,
-    std::uint32_t UnicodeLetter)
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontCreateFontIndirect(
+    _Out_ lv_font_t* FontObject,
+    _In_ const LVGL_WINDOWS_GDI_FONT_PARAMETERS* Parameters)
 {
-    MAT2 TransformationMatrix;
-    TransformationMatrix.eM11 = ::ConvertDoubleToFixed(
-        static_cast<double>(Context->DpiValue) / USER_DEFAULT_SCREEN_DPI);
-    TransformationMatrix.eM12= ::ConvertDoubleToFixed(
-        0.0);
-    TransformationMatrix.eM21= ::ConvertDoubleToFixed(
-        0.0);
-    TransformationMatrix.eM22 = ::ConvertDoubleToFixed(
-        static_cast<double>(Context->DpiValue) / USER_DEFAULT_SCREEN_DPI);
+    if (!FontObject || !Parameters)
+    {
+        return FALSE;
+    }
+
+    int FontSize = Parameters->FontSize;
+
+    UINT GlyphBpp = Parameters->GlyphBpp ? Parameters->GlyphBpp : 8;
+    if (GlyphBpp != 8 && GlyphBpp != 4 && GlyphBpp != 2)
+    {
+        return FALSE;
+    }
+
+#if !LV_USE_FONT_SUBPX
+    if (Parameters->Subpixel)
+    {
+        return FALSE;
+    }
+#endif
+
+    const LVGL_WINDOWS_GDI_FONT_BACKEND* Backend = nullptr;
+    if (Parameters->Backend == LvglWindowsGdiFontBackendGdi)
+    {
+        Backend = &g_LvglWindowsGdiFontGdiBackend;
+    }
+#if LV_USE_FREETYPE
+    else if (Parameters->Backend == LvglWindowsGdiFontBackendFreeType)
+    {
+        Backend = &g_LvglWindowsGdiFontFreeTypeBackend;
+    }
+#endif
+    else
+    {
+        return FALSE;
+    }
 
-    HDC ContextDCHandle = nullptr;
+    // Only the backends which rasterize the font data themselves can read it.
+    if (Parameters->FontData
+        && Backend == &g_LvglWindowsGdiFontGdiBackend)
+    {
+        return FALSE;
+    }
+
+    std::vector<LVGL_WINDOWS_GDI_FONT_SOURCE> Sources;
+    LVGL_WINDOWS_GDI_FONT_SOURCE Source;
+    Source.FontName = Parameters->FontName;
+    Source.FontData = reinterpret_cast<const std::uint8_t*>(
+        Parameters->FontData);
+    Source.FontDataSize = Parameters->FontData ? Parameters->FontDataSize : 0;
+    Sources.push_back(Source);
+    for (std::size_t i = 0; i < Parameters->FallbackFontCount; ++i)
+    {
+        Source.FontName = Parameters->FallbackFontNames[i];
+        Source.FontData = nullptr;
+        Source.FontDataSize = 0;
+        Sources.push_back(Source);
+    }
+    Source.FontName = LvglFontAwesome5FreeLvglFontName;
+    Source.FontData = LvglFontAwesome5FreeLvglFontResource;
+    Source.FontDataSize = LvglFontAwesome5FreeLvglFontResourceSize;
+    Sources.push_back(Source);
+
+    std::vector<LVGL_WINDOWS_GDI_FONT_FACE> FaceSet;
+
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context = nullptr;
 
     do
     {
-        ContextDCHandle = ::GetDC(nullptr);
-        if (!ContextDCHandle)
+        bool IsSucceed = true;
+        for (const LVGL_WINDOWS_GDI_FONT_SOURCE& FaceSource : Sources)
+        {
+            LVGL_WINDOWS_GDI_FONT_FACE Face;
+            if (!Backend->CreateFace(FontSize, &FaceSource, &Face))
+            {
+                IsSucceed = false;
+                break;
+            }
+            FaceSet.push_back(Face);
+        }
+        if (!IsSucceed)
+        {
+            break;
+        }
+
+        Context = new LVGL_WINDOWS_GDI_FONT_CONTEXT();
+        if (!Context)
         {
             break;
         }
 
-        wchar_t InBuffer[2];
-        InBuffer[0] = static_cast<wchar_t>(UnicodeLetter);
-        InBuffer[1] = L'\0';
+        FontObject->dsc = Context;
 
-        WORD OutBuffer[2];
-        OutBuffer[0] = 0;
-        OutBuffer[1] = 0;
+        Context->Backend = Backend;
+        Context->FontSize = FontSize;
+        Context->GlyphBpp = static_cast<std::uint8_t>(GlyphBpp);
+        Context->IsSubpixel = Parameters->Subpixel != FALSE;
+        Context->IsAsynchronous = Parameters->Asynchronous != FALSE;
+        Context->GlyphCacheBudget = Parameters->GlyphCacheBudget;
+
+        // The other sizes of the same fallback chain share the cmap tables.
+        Context->Family = ::LvglWindowsGdiFontAcquireFamily(
+            Backend,
+            Sources,
+            FaceSet);
+        for (std::size_t i = 0; i < FaceSet.size(); ++i)
+        {
+            FaceSet[i].CharacterMap = &Context->Family->CharacterMaps[i];
+        }
+
+        Context->FaceSet.swap(FaceSet);
+
+        ::LvglWindowsGdiFontLoadKerningPairs(Context);
+
+        ::LvglWindowsGdiFontSelectCache(
+            Context,
+            g_LvglWindowsGdiFontDpiValue.load(std::memory_order_relaxed));
+
+        LVGL_WINDOWS_GDI_FONT_METRICS FontMetrics;
+        if (!Backend->GetFontMetrics(&Context->FaceSet[0], &FontMetrics))
+        {
+            break;
+        }
 
-        ::SelectObject(ContextDCHandle, Context->FontHandle);
-        if (::GetGlyphIndicesW(
-            ContextDCHandle,
-            InBuffer,
-            1,
-            OutBuffer,
-            GGI_MARK_NONEXISTING_GLYPHS) == GDI_ERROR
-            || OutBuffer[0] == 0xffff)
-        {
-            ::SelectObject(ContextDCHandle, Context->SymbolFontHandle);
-            if (::GetGlyphIndicesW(
-                ContextDCHandle,
-                InBuffer,
-                1,
-                OutBuffer,
-                GGI_MARK_NONEXISTING_GLYPHS) == GDI_ERROR
-                || OutBuffer[0] == 0xffff)
+        FontObject->get_glyph_dsc =
+            ::LvglWindowsGdiFontGetGlyphCallback;
+        FontObject->get_glyph_bitmap =
+            ::LvglWindowsGdiFontGetGlyphBitmapCallback;
+        FontObject->line_height = static_cast<lv_coord_t>(
+            FontMetrics.LineHeight);
+        FontObject->base_line = static_cast<lv_coord_t>(
+            FontMetrics.BaseLine);
+        FontObject->subpx = Context->IsSubpixel
+            ? LV_FONT_SUBPX_HOR
+            : LV_FONT_SUBPX_NONE;
+        FontObject->underline_position = static_cast<std::int8_t>(
+            FontMetrics.UnderlinePosition);
+        FontObject->underline_thickness = static_cast<std::int8_t>(
+            FontMetrics.UnderlineThickness);
+
+        if (Context->IsAsynchronous)
+        {
+            Context->RedrawTimer = ::lv_timer_create(
+                ::LvglWindowsGdiFontRedrawTimerCallback,
+                LvglWindowsGdiFontRedrawPeriod,
+                FontObject);
+            if (!Context->RedrawTimer)
             {
                 break;
             }
+
+            Context->Worker = std::thread(
+                ::LvglWindowsGdiFontWorkerLoop,
+                Context);
         }
 
-        GLYPHMETRICS GlyphMetrics;
-        std::size_t GlyphBitmapOffset = static_cast<std::size_t>(-1);
-        DWORD Length = ::GetGlyphOutlineW(
-            ContextDCHandle,
-            OutBuffer[0],
-            GGO_GRAY8_BITMAP | GGO_GLYPH_INDEX,
-            &GlyphMetrics,
-            0,
-            nullptr,
-            &TransformationMatrix);
-        if (Length != GDI_ERROR)
-        {
-            if (Length > 0)
-            {
-                GlyphBitmapOffset = Context->GlyphBitmapPool.size();
-                Context->GlyphBitmapPool.resize(GlyphBitmapOffset + Length);
-                uint8_t* GlyphBitmap = &Context->GlyphBitmapPool[GlyphBitmapOffset];
-
-                if (::GetGlyphOutlineW(
-                    ContextDCHandle,
-                    OutBuffer[0],
-                    GGO_GRAY8_BITMAP | GGO_GLYPH_INDEX,
-                    &GlyphMetrics,
-                    Length,
-                    GlyphBitmap,
-                    &TransformationMatrix) != GDI_ERROR)
-                {
-                    for (size_t i = 0; i < Length; ++i)
-                    {
-                        GlyphBitmap[i] =
-                            GlyphBitmap[i] == 0x40
-                            ? 0xFF
-                            : GlyphBitmap[i] << 2;
-                    }
-                }
-            }
+        return TRUE;
 
-            lv_font_glyph_dsc_t GlyphDescription;
-            GlyphDescription.adv_w = GlyphMetrics.gmCellIncX;
-            GlyphDescription.box_w = static_cast<std::uint16_t>(
-                (GlyphMetrics.gmBlackBoxX + 0x0003) & 0xFFFC);
-            GlyphDescription.box_h = static_cast<std::uint16_t>(
-                GlyphMetrics.gmBlackBoxY);
-            GlyphDescription.ofs_x = static_cast<std::int16_t>(
-                GlyphMetrics.gmptGlyphOrigin.x);
-            GlyphDescription.ofs_y = static_cast<std::int16_t>(
-                GlyphMetrics.gmptGlyphOrigin.y - GlyphMetrics.gmBlackBoxY);
-            GlyphDescription.bpp = 8;
+    } while (false);
 
-            Context->GlyphSet.emplace(std::make_pair(
-                UnicodeLetter,
-                std::make_pair(GlyphDescription, GlyphBitmapOffset)));
-        }
+    if (Context)
+    {
+        ::LvglWindowsGdiFontReleaseContext(Context);
+        FontObject->dsc = nullptr;
+    }
 
-    } while (false);
+    for (LVGL_WINDOWS_GDI_FONT_FACE& Face : FaceSet)
+    {
+        Backend->ReleaseFace(&Face);
+    }
+
+    return FALSE;
+}
+
+EXTERN_C void WINAPI LvglWindowsGdiFontDestroyFont(
+    _Inout_ lv_font_t* FontObject)
+{
+    if (!FontObject || !FontObject->dsc)
+    {
+        return;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
 
-    if (ContextDCHandle)
+    if (Context->Worker.joinable())
     {
-        ::ReleaseDC(nullptr, ContextDCHandle);
+        {
+            std::lock_guard<std::mutex> Guard(Context->Lock);
+            Context->IsWorkerStopping = true;
+        }
+        Context->WorkerCondition.notify_all();
+        Context->Worker.join();
+    }
+
+    if (Context->RedrawTimer)
+    {
+        ::lv_timer_del(Context->RedrawTimer);
     }
+
+    ::LvglWindowsGdiFontReleaseContext(Context);
+
+    FontObject->dsc = nullptr;
 }
 
-static void LvglWindowsGdiFontCheckDpiValue(
-    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context)
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontGetStatistics(
+    _In_ const lv_font_t* FontObject,
+    _Out_ PLVGL_WINDOWS_GDI_FONT_STATISTICS Statistics)
 {
-    std::uint32_t DpiValue = LV_DPI_DEF;
-    lv_disp_t* CurrentDisplay = ::lv_disp_get_default();
-    if (CurrentDisplay)
+    if (!FontObject || !FontObject->dsc || !Statistics)
+    {
+        return FALSE;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
+
+    std::lock_guard<std::mutex> Guard(Context->Lock);
+
+    Statistics->LastGlyphHits = Context->LastGlyphHits.load(
+        std::memory_order_relaxed);
+    Statistics->LastGlyphMisses = Context->LastGlyphMisses.load(
+        std::memory_order_relaxed);
+    Statistics->CacheHits = Context->CacheHits.load(
+        std::memory_order_relaxed);
+    Statistics->CacheMisses = Context->CacheMisses;
+    Statistics->Evictions = Context->Evictions;
+    Statistics->ResidentBytes = Context->ResidentSize;
+    Statistics->GlyphCount = 0;
+    Statistics->MissingGlyphCount = Context->MissingGlyphCount;
+    Statistics->MissingGlyphHits = Context->MissingGlyphHits.load(
+        std::memory_order_relaxed);
+    Statistics->PlaceholderHits = Context->PlaceholderHits.load(
+        std::memory_order_relaxed);
+
+    Statistics->GdiObjectCount = 0;
+    for (LVGL_WINDOWS_GDI_FONT_FACE& Face : Context->FaceSet)
     {
-        DpiValue = CurrentDisplay->driver->dpi;
+        Statistics->GdiObjectCount += (Face.FontHandle ? 1 : 0)
+            + (Face.DCHandle ? 1 : 0);
     }
 
-    if (DpiValue != Context->DpiValue)
     {
-        Context->GlyphSet.clear();
-        Context->GlyphBitmapPool.clear();
-        Context->DpiValue = DpiValue;
+        std::lock_guard<std::mutex> FamilyGuard(g_LvglWindowsGdiFontFamilyLock);
+        Statistics->FamilyReferenceCount = Context->Family->ReferenceCount;
     }
+    {
+        std::lock_guard<std::mutex> FamilyGuard(
+            Context->Family->FaceRangeLock);
+        Statistics->FaceRangeCount = Context->Family->FaceRanges.size();
+    }
+
+    Statistics->BitmapSlabCount = 0;
+    Statistics->BitmapReservedBytes = 0;
+    Statistics->BitmapUsedBytes = 0;
+    Statistics->BitmapFragmentedBytes = 0;
+    for (auto& Item : Context->CacheSet)
+    {
+        Statistics->GlyphCount += Item.second.GlyphCount;
+
+        PLVGL_WINDOWS_GDI_FONT_ARENA Arena = &Item.second.GlyphBitmapArena;
+        Statistics->BitmapSlabCount += Arena->Slabs.size();
+        Statistics->BitmapReservedBytes += Arena->ReservedSize;
+        Statistics->BitmapUsedBytes += Arena->UsedSize;
+        Statistics->BitmapFragmentedBytes +=
+            Arena->FragmentedSize + Arena->FreeSize;
+    }
+
+    return TRUE;
 }
 
-static bool LvglWindowsGdiFontGetGlyphCallback(
-    const lv_font_t* font,
-    lv_font_glyph_dsc_t* dsc_out,
-    uint32_t unicode_letter,
-    uint32_t unicode_letter_next)
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontSetGlyphCacheBudget(
+    _In_ const lv_font_t* FontObject,
+    _In_ SIZE_T GlyphCacheBudget)
 {
-    unicode_letter_next;
+    if (!FontObject || !FontObject->dsc)
+    {
+        return FALSE;
+    }
 
     PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
         reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
-            const_cast<void*>(font->dsc));
+            const_cast<void*>(FontObject->dsc));
+
+    // The new budget is enforced on the next cache miss, the glyph which is
+    // being drawn by LVGL must not be evicted from here.
+    std::lock_guard<std::mutex> Guard(Context->Lock);
+    Context->GlyphCacheBudget = GlyphCacheBudget;
 
-    ::LvglWindowsGdiFontCheckDpiValue(Context);
+    return TRUE;
+}
 
-    auto iterator = Context->GlyphSet.find(unicode_letter);
-    if (iterator == Context->GlyphSet.end())
+EXTERN_C SIZE_T WINAPI LvglWindowsGdiFontPrewarm(
+    _In_ const lv_font_t* FontObject,
+    _In_ const char* Text)
+{
+    if (!FontObject || !FontObject->dsc || !Text)
     {
-        ::LvglWindowsGdiFontAddGlyph(
-            Context,
-            unicode_letter);
+        return 0;
+    }
 
-        iterator = Context->GlyphSet.find(unicode_letter);
-        if (iterator == Context->GlyphSet.end())
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
+
+    std::vector<std::uint32_t> CodePoints;
+    std::uint32_t Offset = 0;
+    for (;;)
+    {
+        std::uint32_t CodePoint = ::_lv_txt_encoded_next(Text, &Offset);
+        if (!CodePoint)
         {
-            return false;
+            break;
         }
+        CodePoints.push_back(CodePoint);
     }
 
-    std::memcpy(
-        dsc_out,
-        &iterator->second.first,
-        sizeof(lv_font_glyph_dsc_t));
+    // Rasterize each letter once, in the order of the code points.
+    std::sort(CodePoints.begin(), CodePoints.end());
+    CodePoints.erase(
+        std::unique(CodePoints.begin(), CodePoints.end()),
+        CodePoints.end());
 
-    return true;
+    return ::LvglWindowsGdiFontPrewarmGlyphs(
+        Context,
+        CodePoints.data(),
+        CodePoints.size());
 }
 
-static const uint8_t* LvglWindowsGdiFontGetGlyphBitmapCallback(
-    const lv_font_t* font,
-    uint32_t unicode_letter)
+EXTERN_C SIZE_T WINAPI LvglWindowsGdiFontPrewarmRange(
+    _In_ const lv_font_t* FontObject,
+    _In_ UINT32 FirstCodePoint,
+    _In_ UINT32 LastCodePoint)
 {
+    if (!FontObject ||
+        !FontObject->dsc ||
+        FirstCodePoint > LastCodePoint ||
+        FirstCodePoint > LvglWindowsGdiFontMaximumCodePoint)
+    {
+        return 0;
+    }
+
     PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
         reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
-            const_cast<void*>(font->dsc));
+            const_cast<void*>(FontObject->dsc));
 
-    ::LvglWindowsGdiFontCheckDpiValue(Context);
+    LastCodePoint = std::min(LastCodePoint, LvglWindowsGdiFontMaximumCodePoint);
 
-    auto iterator = Context->GlyphSet.find(unicode_letter);
-    if (iterator == Context->GlyphSet.end())
-    {
-        ::LvglWindowsGdiFontAddGlyph(
-            Context,
-            unicode_letter);
+    // Prewarm the range in chunks, so a large range does not need a code
+    // point array of its size.
+    std::vector<std::uint32_t> CodePoints;
+    CodePoints.reserve(std::min<std::size_t>(
+        LastCodePoint - FirstCodePoint + 1,
+        LvglWindowsGdiFontPrewarmChunkSize));
 
-        iterator = Context->GlyphSet.find(unicode_letter);
-        if (iterator == Context->GlyphSet.end())
+    std::size_t Rasterized = 0;
+    std::uint32_t CodePoint = FirstCodePoint;
+    while (CodePoint <= LastCodePoint)
+    {
+        CodePoints.clear();
+        while (CodePoint <= LastCodePoint &&
+            CodePoints.size() < LvglWindowsGdiFontPrewarmChunkSize)
         {
-            return nullptr;
+            CodePoints.push_back(CodePoint++);
         }
+
+        Rasterized += ::LvglWindowsGdiFontPrewarmGlyphs(
+            Context,
+            CodePoints.data(),
+            CodePoints.size());
     }
 
-    std::size_t& GlyphBitmapOffset = iterator->second.second;
-    return
-        (GlyphBitmapOffset != static_cast<std::size_t>(-1))
-        ? &Context->GlyphBitmapPool[GlyphBitmapOffset]
-        : nullptr;
+    return Rasterized;
 }
 
-EXTERN_C void WINAPI LvglWindowsGdiFontInitialize(
-    _In_opt_ LPCWSTR FontName)
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontSaveCache(
+    _In_ const lv_font_t* FontObject,
+    _In_ LPCWSTR FileName)
 {
-    DWORD NumFonts = 0;
-    ::AddFontMemResourceEx(
-        const_cast<uint8_t*>(LvglFontAwesome5FreeLvglFontResource),
-        static_cast<DWORD>(LvglFontAwesome5FreeLvglFontResourceSize),
+    if (!FontObject || !FontObject->dsc || !FileName)
+    {
+        return FALSE;
+    }
+
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
+    std::vector<std::uint8_t> Content;
+
+    {
+        // The bitmaps are copied with the lock held, the LVGL thread cannot
+        // evict them meanwhile.
+        std::lock_guard<std::mutex> Guard(Context->Lock);
+        if (!::LvglWindowsGdiFontSerializeCache(
+            Context,
+            Context->Cache,
+            Content))
+        {
+            return FALSE;
+        }
+    }
+
+    BOOL Result = FALSE;
+
+    HANDLE FileHandle = ::CreateFileW(
+        FileName,
+        GENERIC_WRITE,
+        0,
         nullptr,
-        &NumFonts);
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (FileHandle != INVALID_HANDLE_VALUE)
+    {
+        DWORD WrittenSize = 0;
+        if (::WriteFile(
+            FileHandle,
+            &Content[0],
+            static_cast<DWORD>(Content.size()),
+            &WrittenSize,
+            nullptr)
+            && WrittenSize == Content.size())
+        {
+            Result = TRUE;
+        }
 
-    ::LvglWindowsGdiFontCreateFont(
-        &LvglDefaultFont,
-        16,
-        FontName);
+        ::CloseHandle(FileHandle);
+    }
+
+    return Result;
 }
 
-EXTERN_C BOOL WINAPI LvglWindowsGdiFontCreateFont(
-    _Out_ lv_font_t* FontObject,
-    _In_ int FontSize,
-    _In_opt_ LPCWSTR FontName)
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontLoadCache(
+    _In_ const lv_font_t* FontObject,
+    _In_ LPCWSTR FileName)
 {
-    HFONT FontHandle = nullptr;
-    HFONT SymbolFontHandle = nullptr;
+    if (!FontObject || !FontObject->dsc || !FileName)
+    {
+        return FALSE;
+    }
 
-    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context = nullptr;
+    PLVGL_WINDOWS_GDI_FONT_CONTEXT Context =
+        reinterpret_cast<PLVGL_WINDOWS_GDI_FONT_CONTEXT>(
+            const_cast<void*>(FontObject->dsc));
+
+    std::lock_guard<std::mutex> Guard(Context->Lock);
+
+    if (Context->CacheFileView)
+    {
+        return FALSE;
+    }
+
+    // Fill the cache for the DPI value the LVGL thread will switch to.
+    std::uint32_t DpiValue = g_LvglWindowsGdiFontDpiValue.load(
+        std::memory_order_relaxed);
+    PLVGL_WINDOWS_GDI_FONT_CACHE Cache = ::LvglWindowsGdiFontGetCache(
+        Context,
+        DpiValue);
+
+    HANDLE FileHandle = INVALID_HANDLE_VALUE;
+    HANDLE FileMappingHandle = nullptr;
+    const std::uint8_t* FileView = nullptr;
 
     do
     {
-        FontHandle = ::CreateFontW(
-            -FontSize,                  // nHeight
-            0,                         // nWidth
-            0,                         // nEscapement
-            0,                         // nOrientation
-            FW_NORMAL,                 // nWeight
-            FALSE,                     // bItalic
-            FALSE,                     // bUnderline
-            0,                         // cStrikeOut
-            DEFAULT_CHARSET,           // nCharSet
-            OUT_DEFAULT_PRECIS,        // nOutPrecision
-            CLIP_DEFAULT_PRECIS,       // nClipPrecision
-            CLEARTYPE_NATURAL_QUALITY, // nQuality
-            FF_DONTCARE,  // nPitchAndFamily
-            FontName);
-        if (!FontHandle)
+        FileHandle = ::CreateFileW(
+            FileName,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+        if (FileHandle == INVALID_HANDLE_VALUE)
         {
             break;
         }
 
-        SymbolFontHandle = ::CreateFontW(
-            -FontSize,                  // nHeight
-            0,                         // nWidth
-            0,                         // nEscapement
-            0,                         // nOrientation
-            FW_NORMAL,                 // nWeight
-            FALSE,                     // bItalic
-            FALSE,                     // bUnderline
-            0,                         // cStrikeOut
-            DEFAULT_CHARSET,           // nCharSet
-            OUT_DEFAULT_PRECIS,        // nOutPrecision
-            CLIP_DEFAULT_PRECIS,       // nClipPrecision
-            CLEARTYPE_NATURAL_QUALITY, // nQuality
-            FF_DONTCARE,  // nPitchAndFamily
-            LvglFontAwesome5FreeLvglFontName);
-        if (!FontHandle)
+        LARGE_INTEGER FileSize;
+        if (!::GetFileSizeEx(FileHandle, &FileSize)
+            || FileSize.QuadPart
+            < static_cast<LONGLONG>(
+                sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER))
+            || FileSize.QuadPart > UINT32_MAX)
         {
             break;
         }
 
-        std::uint32_t DpiValue = LV_DPI_DEF;
-        lv_disp_t* CurrentDisplay = ::lv_disp_get_default();
-        if (CurrentDisplay)
+        FileMappingHandle = ::CreateFileMappingW(
+            FileHandle,
+            nullptr,
+            PAGE_READONLY,
+            0,
+            0,
+            nullptr);
+        if (!FileMappingHandle)
         {
-            DpiValue = CurrentDisplay->driver->dpi;
+            break;
         }
 
-        Context = new LVGL_WINDOWS_GDI_FONT_CONTEXT();
-        if (!Context)
+        FileView = reinterpret_cast<const std::uint8_t*>(::MapViewOfFile(
+            FileMappingHandle,
+            FILE_MAP_READ,
+            0,
+            0,
+            0));
+        if (!FileView)
         {
             break;
         }
 
-        FontObject->dsc = Context;
+        // The file is only trusted after every offset has been checked.
+        std::uint64_t Size = static_cast<std::uint64_t>(FileSize.QuadPart);
 
-        Context->FontHandle = FontHandle;
-        Context->SymbolFontHandle = SymbolFontHandle;
+        LVGL_WINDOWS_GDI_FONT_CACHE_FILE_HEADER Header;
+        std::memcpy(&Header, FileView, sizeof(Header));
+        if (Header.Magic != LvglWindowsGdiFontCacheFileMagic
+            || Header.EngineVersion != LvglWindowsGdiFontCacheEngineVersion
+            || Header.HeaderSize != sizeof(Header)
+            || Header.DpiValue != DpiValue
+            || Header.FontSize != Context->FontSize
+            || Header.FaceSetHash != Context->Family->FaceSetHash
+            || Header.Flags != ::LvglWindowsGdiFontGetCacheFileFlags(Context)
+            || Header.BitmapOffset
+            % LvglWindowsGdiFontArenaAlignment != 0
+            || sizeof(Header) + static_cast<std::uint64_t>(Header.GlyphCount)
+            * sizeof(LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH)
+            > Header.BitmapOffset
+            || static_cast<std::uint64_t>(Header.BitmapOffset)
+            + Header.BitmapSize > Size)
+        {
+            break;
+        }
+
+        bool IsSameFace = true;
+        for (std::size_t i = 0; i < LF_FACESIZE; ++i)
+        {
+            if (Header.FaceName[i]
+                != static_cast<std::uint16_t>(Context->Family->FaceName[i]))
+            {
+                IsSameFace = false;
+                break;
+            }
+            if (!Header.FaceName[i])
+            {
+                break;
+            }
+        }
+        if (!IsSameFace)
+        {
+            break;
+        }
 
-        Context->DpiValue = DpiValue;
+        const std::uint8_t* Bitmaps = FileView + Header.BitmapOffset;
 
-        bool IsSucceed = false;
-        HDC ContextDCHandle = ::GetDC(nullptr);
-        if (ContextDCHandle)
+        for (std::uint32_t i = 0; i < Header.GlyphCount; ++i)
         {
-            ::SelectObject(ContextDCHandle, Context->FontHandle);
+            LVGL_WINDOWS_GDI_FONT_CACHE_FILE_GLYPH Record;
+            std::memcpy(
+                &Record,
+                FileView + sizeof(Header) + i * sizeof(Record),
+                sizeof(Record));
+
+            // The code points above the Unicode range include the one which
+            // marks the free glyph records, and LVGL reads the box of a glyph
+            // without a bitmap as pixels.
+            std::uint64_t PixelBits = static_cast<std::uint64_t>(
+                Record.BoxWidth) * Record.BoxHeight * Record.Bpp;
+            if (Record.CodePoint > LvglWindowsGdiFontMaximumCodePoint
+                || static_cast<std::uint64_t>(Record.BitmapOffset)
+                + Record.BitmapSize > Header.BitmapSize
+                || (Record.BitmapSize
+                    && (PixelBits + 7) / 8 > Record.BitmapSize)
+                || (!Record.BitmapSize && (Record.BoxWidth || Record.BoxHeight))
+                || Record.Bpp != Context->GlyphBpp)
+            {
+                continue;
+            }
 
-            OUTLINETEXTMETRICW OutlineTextMetrics;
-            if (::GetOutlineTextMetricsW(
-                ContextDCHandle,
-                sizeof(OUTLINETEXTMETRICW),
-                &OutlineTextMetrics))
+            if (::LvglWindowsGdiFontFindGlyph(
+                Cache,
+                Record.CodePoint) != LvglWindowsGdiFontInvalidIndex)
             {
-                FontObject->get_glyph_dsc =
-                    ::LvglWindowsGdiFontGetGlyphCallback;
-                FontObject->get_glyph_bitmap =
-                    ::LvglWindowsGdiFontGetGlyphBitmapCallback;
-                FontObject->line_height = static_cast<lv_coord_t>(
-                    OutlineTextMetrics.otmLineGap
-                    - OutlineTextMetrics.otmDescent
-                    + OutlineTextMetrics.otmAscent);
-                FontObject->base_line = static_cast<lv_coord_t>(
-                    0 - OutlineTextMetrics.otmDescent);
-                FontObject->subpx = LV_FONT_SUBPX_NONE;
-                FontObject->underline_position = static_cast<std::int8_t>(
-                    OutlineTextMetrics.otmsUnderscorePosition);
-                FontObject->underline_thickness = static_cast<std::int8_t>(
-                    OutlineTextMetrics.otmsUnderscoreSize);
+                continue;
+            }
 
-                IsSucceed = true;
+            // Do not evict anything for the glyphs from the file.
+            if (Context->GlyphCacheBudget
+                && Context->ResidentSize
+                + sizeof(LVGL_WINDOWS_GDI_FONT_GLYPH)
+                + sizeof(std::uint64_t)
+                > Context->GlyphCacheBudget)
+            {
+                break;
             }
 
-            ::ReleaseDC(nullptr, ContextDCHandle);
-        }
+            std::uint32_t GlyphIndex = ::LvglWindowsGdiFontAllocateGlyph(Cache);
+            if (GlyphIndex == LvglWindowsGdiFontInvalidIndex)
+            {
+                break;
+            }
+            PLVGL_WINDOWS_GDI_FONT_GLYPH Glyph = ::LvglWindowsGdiFontGetGlyph(
+                Cache,
+                GlyphIndex);
 
-        if (!IsSucceed)
-        {
-            break;
+            Glyph->Description.adv_w = Record.AdvanceWidth;
+            Glyph->Description.box_w = Record.BoxWidth;
+            Glyph->Description.box_h = Record.BoxHeight;
+            Glyph->Description.ofs_x = Record.OffsetX;
+            Glyph->Description.ofs_y = Record.OffsetY;
+            Glyph->Description.bpp = Record.Bpp;
+            Glyph->Bitmap = Record.BitmapSize
+                ? const_cast<std::uint8_t*>(Bitmaps + Record.BitmapOffset)
+                : nullptr;
+            Glyph->BitmapSize = Record.BitmapSize;
+            Glyph->IsMapped = true;
+            Glyph->IsPlaceholder = false;
+            Glyph->CodePoint = Record.CodePoint;
+
+            ::LvglWindowsGdiFontCommitGlyph(Context, Cache, GlyphIndex);
         }
 
+        ::CloseHandle(FileHandle);
+
+        Context->CacheFileMappingHandle = FileMappingHandle;
+        Context->CacheFileView = FileView;
+
         return TRUE;
 
     } while (false);
 
-    if (Context)
+    if (FileView)
     {
-        delete Context;
+        ::UnmapViewOfFile(FileView);
     }
 
-    if (SymbolFontHandle)
+    if (FileMappingHandle)
     {
-        ::DeleteObject(SymbolFontHandle);
+        ::CloseHandle(FileMappingHandle);
     }
 
-    if (FontHandle)
+    if (FileHandle != INVALID_HANDLE_VALUE)
     {
-        ::DeleteObject(FontHandle);
+        ::CloseHandle(FileHandle);
     }
 
     return FALSE;
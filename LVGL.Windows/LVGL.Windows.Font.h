@@ -50,6 +50,15 @@ extern lv_font_t LvglDefaultFont;
 EXTERN_C void WINAPI LvglWindowsGdiFontInitialize(
     _In_opt_ LPCWSTR FontName);
 
+/**
+ * @brief Notifies the Windows GDI font engine that the DPI value of the display
+ *        has been changed. Glyphs are cached per DPI value, so switching back
+ *        to a DPI value which has been used will not rasterize them again.
+ * @param DpiValue The new DPI value.
+*/
+EXTERN_C void WINAPI LvglWindowsGdiFontNotifyDpiChanged(
+    _In_ UINT DpiValue);
+
 /**
  * @brief Creates a LVGL font object.
  * @param FontObject The LVGL font object.
@@ -62,4 +71,305 @@ EXTERN_C BOOL WINAPI LvglWindowsGdiFontCreateFont(
     _In_ int FontSize,
     _In_opt_ LPCWSTR FontName);
 
+/**
+ * @brief The rasterizers of the glyphs of a LVGL font object.
+*/
+typedef enum _LVGL_WINDOWS_GDI_FONT_BACKEND_TYPE
+{
+    /**
+     * @brief Rasterizes the glyphs with GetGlyphOutlineW.
+    */
+    LvglWindowsGdiFontBackendGdi = 0,
+
+#if LV_USE_FREETYPE
+    /**
+     * @brief Rasterizes the outlines of the fonts with FreeType. The font data
+     *        given with the font and the built-in symbol font are read
+     *        directly, GDI is only used to find the font data of the fonts
+     *        given by name. The kerning pairs are not applied.
+    */
+    LvglWindowsGdiFontBackendFreeType = 1,
+#endif
+} LVGL_WINDOWS_GDI_FONT_BACKEND_TYPE, *PLVGL_WINDOWS_GDI_FONT_BACKEND_TYPE;
+
+/**
+ * @brief The parameters for creating a LVGL font object.
+*/
+typedef struct _LVGL_WINDOWS_GDI_FONT_PARAMETERS
+{
+    /**
+     * @brief The font size.
+    */
+    int FontSize;
+
+    /**
+     * @brief The font name.
+    */
+    LPCWSTR FontName;
+
+    /**
+     * @brief The names of the fonts which are tried in order for the letters
+     *        missing from the main font, before the built-in symbol font.
+     *        It can be nullptr if FallbackFontCount is zero.
+    */
+    const LPCWSTR* FallbackFontNames;
+
+    /**
+     * @brief The count of the fallback font names.
+    */
+    SIZE_T FallbackFontCount;
+
+    /**
+     * @brief The memory budget, in bytes, of the glyph cache. The glyphs
+     *        which are not used recently are evicted when the budget is
+     *        exceeded.
+     *        Zero means no limit.
+    */
+    SIZE_T GlyphCacheBudget;
+
+    /**
+     * @brief The bits per pixel of the cached glyph bitmaps, 8, 4 or 2. The
+     *        lower values trade anti-aliasing levels for the memory of the
+     *        glyph cache and the bandwidth of the blending. Zero means 8.
+    */
+    UINT GlyphBpp;
+
+    /**
+     * @brief Rasterizes the glyphs for the horizontal subpixel rendering of
+     *        LVGL. The glyph bitmaps are 3 times wider and are charged to the
+     *        glyph cache budget at their real size.
+    */
+    BOOL Subpixel;
+
+    /**
+     * @brief Rasterizes the glyphs which are not cached on a worker thread.
+     *        Until a glyph is ready LVGL gets its advance width with an empty
+     *        box, the objects which use the font are invalidated when it is
+     *        ready. LVGL must be initialized before creating the font.
+    */
+    BOOL Asynchronous;
+
+    /**
+     * @brief The rasterizer of the glyphs. Zero means the GDI rasterizer.
+    */
+    LVGL_WINDOWS_GDI_FONT_BACKEND_TYPE Backend;
+
+    /**
+     * @brief The font data of the main font, a TrueType or OpenType font or
+     *        collection, which is read instead of looking FontName up. It is
+     *        not copied and must outlive the font. Only the FreeType backend
+     *        supports it, FontName selects the font of a collection.
+     *        It can be nullptr.
+    */
+    const void* FontData;
+
+    /**
+     * @brief The size, in bytes, of the font data.
+    */
+    SIZE_T FontDataSize;
+} LVGL_WINDOWS_GDI_FONT_PARAMETERS, *PLVGL_WINDOWS_GDI_FONT_PARAMETERS;
+
+/**
+ * @brief Creates a LVGL font object.
+ * @param FontObject The LVGL font object.
+ * @param Parameters The parameters for creating the LVGL font object.
+ * @return If succeed, return TRUE, otherwise return FALSE.
+*/
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontCreateFontIndirect(
+    _Out_ lv_font_t* FontObject,
+    _In_ const LVGL_WINDOWS_GDI_FONT_PARAMETERS* Parameters);
+
+/**
+ * @brief Destroys a LVGL font object and releases its GDI objects and glyph
+ *        memory. The font family shared with the other sizes is released with
+ *        its last LVGL font object. It must be called from the thread which
+ *        runs LVGL, after no LVGL object uses the font anymore.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+*/
+EXTERN_C void WINAPI LvglWindowsGdiFontDestroyFont(
+    _Inout_ lv_font_t* FontObject);
+
+/**
+ * @brief The statistics of a LVGL font object created by the Windows GDI font
+ *        engine.
+*/
+typedef struct _LVGL_WINDOWS_GDI_FONT_STATISTICS
+{
+    /**
+     * @brief The count of glyph lookups served by the last resolved glyph.
+    */
+    SIZE_T LastGlyphHits;
+
+    /**
+     * @brief The count of glyph lookups which needed to search the cache.
+    */
+    SIZE_T LastGlyphMisses;
+
+    /**
+     * @brief The count of glyph lookups found in the cache.
+    */
+    SIZE_T CacheHits;
+
+    /**
+     * @brief The count of glyph lookups which needed to rasterize the glyph.
+    */
+    SIZE_T CacheMisses;
+
+    /**
+     * @brief The count of glyphs evicted to stay in the glyph cache budget.
+    */
+    SIZE_T Evictions;
+
+    /**
+     * @brief The size, in bytes, charged to the glyph cache budget.
+    */
+    SIZE_T ResidentBytes;
+
+    /**
+     * @brief The count of cached glyphs.
+    */
+    SIZE_T GlyphCount;
+
+    /**
+     * @brief The count of code points which are known to be in none of the
+     *        fonts.
+    */
+    SIZE_T MissingGlyphCount;
+
+    /**
+     * @brief The count of glyph lookups answered by the known missing code
+     *        points.
+    */
+    SIZE_T MissingGlyphHits;
+
+    /**
+     * @brief The count of glyph lookups answered with an empty placeholder
+     *        while the glyph is rasterized asynchronously.
+    */
+    SIZE_T PlaceholderHits;
+
+    /**
+     * @brief The count of GDI objects, fonts and memory DCs, owned by the LVGL
+     *        font object.
+    */
+    SIZE_T GdiObjectCount;
+
+    /**
+     * @brief The count of LVGL font objects which share the font family, the
+     *        cmap tables of the fallback chain, with this one.
+    */
+    SIZE_T FamilyReferenceCount;
+
+    /**
+     * @brief The count of code point ranges with a resolved owning font,
+     *        shared by the fonts created with the same font names.
+    */
+    SIZE_T FaceRangeCount;
+
+    /**
+     * @brief The count of slabs allocated for the glyph bitmaps.
+    */
+    SIZE_T BitmapSlabCount;
+
+    /**
+     * @brief The size, in bytes, of the slabs allocated for the glyph bitmaps.
+    */
+    SIZE_T BitmapReservedBytes;
+
+    /**
+     * @brief The size, in bytes, of the glyph bitmaps.
+    */
+    SIZE_T BitmapUsedBytes;
+
+    /**
+     * @brief The size, in bytes, of the slab memory lost to alignment padding,
+     *        to the unused tails of full slabs and to evicted bitmaps which
+     *        are not reused yet.
+    */
+    SIZE_T BitmapFragmentedBytes;
+} LVGL_WINDOWS_GDI_FONT_STATISTICS, *PLVGL_WINDOWS_GDI_FONT_STATISTICS;
+
+/**
+ * @brief Retrieves the statistics of a LVGL font object.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param Statistics The statistics of the LVGL font object.
+ * @return If succeed, return TRUE, otherwise return FALSE.
+*/
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontGetStatistics(
+    _In_ const lv_font_t* FontObject,
+    _Out_ PLVGL_WINDOWS_GDI_FONT_STATISTICS Statistics);
+
+/**
+ * @brief Changes the memory budget of the glyph cache of a LVGL font object.
+ *        The new budget is enforced on the next glyph which is not cached.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param GlyphCacheBudget The memory budget, in bytes, of the glyph cache.
+ *                         Zero means no limit.
+ * @return If succeed, return TRUE, otherwise return FALSE.
+*/
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontSetGlyphCacheBudget(
+    _In_ const lv_font_t* FontObject,
+    _In_ SIZE_T GlyphCacheBudget);
+
+/**
+ * @brief Rasterizes the glyphs of a text up front, so the first frame which
+ *        shows the text does not need to rasterize them. It may be called
+ *        from any thread, the glyphs added from it are never evicted before
+ *        the next glyph which is not cached on the thread which runs LVGL.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param Text The UTF-8 text.
+ * @return The count of glyphs which have been rasterized.
+*/
+EXTERN_C SIZE_T WINAPI LvglWindowsGdiFontPrewarm(
+    _In_ const lv_font_t* FontObject,
+    _In_ const char* Text);
+
+/**
+ * @brief Rasterizes the glyphs of a code point range up front. It may be
+ *        called from any thread like LvglWindowsGdiFontPrewarm. The range is
+ *        clamped to the Unicode code points, up to U+10FFFF.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param FirstCodePoint The first code point of the range.
+ * @param LastCodePoint The last code point of the range, inclusive.
+ * @return The count of glyphs which have been rasterized.
+*/
+EXTERN_C SIZE_T WINAPI LvglWindowsGdiFontPrewarmRange(
+    _In_ const lv_font_t* FontObject,
+    _In_ UINT32 FirstCodePoint,
+    _In_ UINT32 LastCodePoint);
+
+/**
+ * @brief Saves the cached glyphs of a LVGL font object for the current DPI
+ *        value to a glyph cache file, the most recently used ones first. It
+ *        must be called from the thread which runs LVGL.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param FileName The path of the glyph cache file.
+ * @return If succeed, return TRUE, otherwise return FALSE.
+*/
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontSaveCache(
+    _In_ const lv_font_t* FontObject,
+    _In_ LPCWSTR FileName);
+
+/**
+ * @brief Maps a glyph cache file saved by LvglWindowsGdiFontSaveCache and
+ *        serves its glyphs without copying them. The file is ignored if its
+ *        font name, font size, DPI value, rasterizer or engine version does
+ *        not match, and the glyph records which are not valid are skipped.
+ *        It may be called from any thread, but only once for each LVGL font
+ *        object.
+ * @param FontObject The LVGL font object created by
+ *                   LvglWindowsGdiFontCreateFont.
+ * @param FileName The path of the glyph cache file.
+ * @return If succeed, return TRUE, otherwise return FALSE.
+*/
+EXTERN_C BOOL WINAPI LvglWindowsGdiFontLoadCache(
+    _In_ const lv_font_t* FontObject,
+    _In_ LPCWSTR FileName);
+
 #endif // !LVGL_WINDOWS_SYMBOL_FONT